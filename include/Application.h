@@ -11,13 +11,29 @@ public:
 
 	~Application();
 
+	//Before Run; a hidden window still has a GL context
+	void SetVisible(bool visible) { m_IsVisible = visible; }
+
 	void Run();
+	//Instead of Run: no window and no context, every GL call goes to the GLRecorder null backend
+	void RunNull();
 	GLFWwindow* GetWindow();
+	//Framebuffer size in pixels
 	int GetWidth();
 	int GetHeight();
+	//Window size in screen coordinates, the space cursor positions are in
+	int GetWindowWidth() const { return m_WindowWidth; }
+	int GetWindowHeight() const { return m_WindowHeight; }
 
 	const glm::mat4& GetProjectionMatrix() const;
 	void OnResize(int width, int height);
+	void OnWindowResize(int width, int height);
+
+	//Swap interval 1 waits for the display refresh, 0 swaps immediately
+	void SetVSync(bool enabled);
+	bool IsVSync() const { return m_IsVSync; }
+	//Seconds between refreshes of the primary monitor, 60 Hz when unknown
+	double GetRefreshInterval() const;
 
 private:
 
@@ -30,7 +46,11 @@ private:
 	GLFWwindow* m_Window;
 	int m_Width;
 	int m_Height;
+	int m_WindowWidth;
+	int m_WindowHeight;
 	const char* m_Title;
+	bool m_IsVSync;
+	bool m_IsVisible;
 
 	glm::mat4 m_ProjectionMatrix;
 };
@@ -0,0 +1,66 @@
+#pragma once
+#include "TangramPiece.h"
+#include <type_traits>
+#include <glm/glm.hpp>
+
+// Game-side state of the tangram pieces, stored as parallel arrays indexed like m_Pieces.
+// Poses use the PiecePosition convention: the piece center, the rotation and flip applied
+// around it. The struct is trivially copyable, so snapshots for reset, undo or a solver
+// search are a plain assignment.
+struct BoardState {
+    static const int MAX_PIECES = 7;
+
+    int count = 0;
+
+    float positionX[MAX_PIECES];
+    float positionY[MAX_PIECES];
+    float rotation[MAX_PIECES];
+    bool isFlipped[MAX_PIECES];
+    bool isLocked[MAX_PIECES];
+    PieceType type[MAX_PIECES];
+    float colorR[MAX_PIECES];
+    float colorG[MAX_PIECES];
+    float colorB[MAX_PIECES];
+
+    // Append a piece at the given center, unrotated, unflipped and unlocked
+    int AddPiece(PieceType pieceType, const glm::vec2& center, const glm::vec3& color) {
+        int index = count++;
+        positionX[index] = center.x;
+        positionY[index] = center.y;
+        rotation[index] = 0.0f;
+        isFlipped[index] = false;
+        isLocked[index] = false;
+        type[index] = pieceType;
+        SetColor(index, color);
+        return index;
+    }
+
+    glm::vec2 GetPosition(int index) const { return glm::vec2(positionX[index], positionY[index]); }
+    glm::vec3 GetColor(int index) const { return glm::vec3(colorR[index], colorG[index], colorB[index]); }
+
+    void SetPosition(int index, const glm::vec2& position) {
+        positionX[index] = position.x;
+        positionY[index] = position.y;
+    }
+
+    void SetColor(int index, const glm::vec3& color) {
+        colorR[index] = color.x;
+        colorG[index] = color.y;
+        colorB[index] = color.z;
+    }
+
+    void Translate(int index, const glm::vec2& delta) {
+        positionX[index] += delta.x;
+        positionY[index] += delta.y;
+    }
+
+    int CountLocked() const {
+        int locked = 0;
+        for (int i = 0; i < count; ++i) {
+            locked += isLocked[i] ? 1 : 0;
+        }
+        return locked;
+    }
+};
+
+static_assert(std::is_trivially_copyable<BoardState>::value, "BoardState must stay trivially copyable");
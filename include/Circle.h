@@ -4,6 +4,7 @@
 #include "IndexBuffer.h"
 #include "VertexArray.h"
 #include "Shape.h"
+#include "VertexArena.h"
 
 
 class Circle : public Shape{
@@ -22,6 +23,7 @@ public:
 	void FinalizeShape();
 
 	void SetColor(float r, float g, float b);
+	glm::vec3 GetColor() const;
     bool IsInside(float ndcX, float ndcY) const;
 
     const glm::mat4& GetModelMatrix() const;
@@ -30,11 +32,12 @@ public:
 	void Scale(float sx, float sy);
 	float GetArea() const;
 	float GetPerimeter() const;
+	void GetOutline(std::vector<glm::vec2>& outVertices) const;
 
 private:
 
-    std::vector<float> m_Vertices;
-    std::vector<unsigned int> m_Indices;
+    ArenaVector<float> m_Vertices;
+    ArenaVector<unsigned int> m_Indices;
 
     BufferLayout m_BufferLayout;
 
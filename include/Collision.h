@@ -0,0 +1,31 @@
+#pragma once
+#include "TangramPiece.h"
+#include <vector>
+#include <glm/glm.hpp>
+
+// World-space convex outline of a piece, cached so collision tests never touch the model matrix.
+// Rebuild it with Update() after a rotate/flip; a drag only needs Translate().
+class CollisionShape {
+public:
+    CollisionShape();
+
+    void Update(const TangramPiece& piece);
+    void Translate(const glm::vec2& delta);
+
+    // Cheap broadphase test on the axis-aligned bounds
+    bool BoundsOverlap(const CollisionShape& other) const;
+
+    // Separating axis test. On overlap, outPush is the shortest translation that moves
+    // this shape out of the other one
+    bool Overlaps(const CollisionShape& other, glm::vec2& outPush) const;
+
+    const std::vector<glm::vec2>& GetVertices() const { return m_Vertices; }
+
+private:
+    void Project(const glm::vec2& axis, float& outMin, float& outMax) const;
+
+    std::vector<glm::vec2> m_Vertices;
+    std::vector<glm::vec2> m_Axes;      // Unit edge normals, unchanged by translation
+    glm::vec2 m_Min;
+    glm::vec2 m_Max;
+};
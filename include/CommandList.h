@@ -0,0 +1,77 @@
+#pragma once
+#include "VertexArray.h"
+#include "IndexBuffer.h"
+#include "Shader.h"
+#include "Renderer.h"
+#include <functional>
+#include <vector>
+#include <glm/glm.hpp>
+
+// One mesh drawn with the current camera's shader. The mesh is identified by its GL objects,
+// which the owning layer keeps alive until every list drawing them has been executed
+struct DrawPacket {
+    const VertexArray* mesh;
+    const IndexBuffer* indices;
+    GLenum mode;
+    glm::mat4 model;
+    glm::vec4 color;          // Replaces the vertex colors when useUniformColor is set
+    bool useUniformColor;
+};
+
+// The draw work of one frame.
+//
+// Layers record it on the main thread without touching GL: cameras, draw packets, and tasks for
+// the GL work that is not a plain draw (buffer uploads, offscreen passes), all kept in order.
+// Execute replays it wherever the GL context is current. Everything a command needs is copied
+// in or owned by the render side, so the list can be replayed while the next one is recorded.
+class CommandList {
+public:
+    CommandList();
+
+    // Starts a new frame for a framebuffer of the given size
+    void Reset(int width, int height);
+
+    // Following draws use this shader with these matrices
+    void SetCamera(Shader* shader, const glm::mat4& projection, const glm::mat4& view);
+    void Draw(const DrawPacket& packet);
+    void AddTask(std::function<void()> task);
+
+    // Clears the framebuffer and runs the commands; needs the GL context
+    void Execute(Renderer& renderer);
+
+    size_t GetDrawCount() const { return m_Packets.size(); }
+
+    // Times of the input events this frame handled, and when it was presented, for latency stats
+    std::vector<double>& GetInputTimes() { return m_InputTimes; }
+    double GetPresentTime() const { return m_PresentTime; }
+    void SetPresentTime(double time) { m_PresentTime = time; }
+
+private:
+    enum class CommandType {
+        CAMERA,
+        DRAW,
+        TASK
+    };
+
+    struct Command {
+        CommandType type;
+        size_t index;             // Into the array of its type
+    };
+
+    struct Camera {
+        Shader* shader;
+        glm::mat4 projection;
+        glm::mat4 view;
+    };
+
+    std::vector<Command> m_Commands;
+    std::vector<Camera> m_Cameras;
+    std::vector<DrawPacket> m_Packets;
+    std::vector<std::function<void()>> m_Tasks;
+
+    int m_Width;
+    int m_Height;
+
+    std::vector<double> m_InputTimes;
+    double m_PresentTime;
+};
@@ -0,0 +1,154 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+// Bounded undo/redo history.
+//
+// Every entry is one small reversible delta (a move by an offset, a turn by an angle, ...),
+// never a copy of what it changed, so an entry costs the same whatever it edits. The entries
+// live in a ring allocated once: when it is full, recording drops the oldest group. Edits
+// recorded between BeginGroup and EndGroup undo and redo as one step. Undo and redo only move
+// a cursor over the ring and hand the entries to the caller, which applies them.
+//
+// Dropped entries, the oldest ones and the undone ones a new edit overwrites, go to the
+// discard handler, so it can free what an entry still keeps alive (a deleted shape).
+template <typename Edit>
+class EditLog {
+public:
+    // isUndone: the edit had been undone when it was dropped, rather than in effect
+    using DiscardHandler = std::function<void(const Edit& edit, bool isUndone)>;
+
+    explicit EditLog(size_t capacity, DiscardHandler discard = DiscardHandler())
+        : m_Entries(capacity > 0 ? capacity : 1)
+        , m_Discard(discard)
+        , m_First(0)
+        , m_Count(0)
+        , m_Cursor(0)
+        , m_IsGrouping(false)
+        , m_IsGroupEmpty(false) {
+    }
+
+    // Records an edit that has already been applied
+    void Record(const Edit& edit) {
+        // A new edit forks the history: the undone ones cannot be redone any more
+        while (m_Count > m_Cursor) {
+            --m_Count;
+            DiscardEntry(At(m_Count), true);
+        }
+        if (m_Count == m_Entries.size()) {
+            DropOldestGroup();
+        }
+
+        Entry& entry = At(m_Count);
+        entry.edit = edit;
+        entry.isGroupStart = !m_IsGrouping || m_IsGroupEmpty;
+        m_IsGroupEmpty = false;
+        ++m_Count;
+        ++m_Cursor;
+    }
+
+    void BeginGroup() {
+        m_IsGrouping = true;
+        m_IsGroupEmpty = true;
+    }
+
+    void EndGroup() {
+        m_IsGrouping = false;
+    }
+
+    // Hands the edits of the last group to revert, newest first; false when there is nothing to undo
+    template <typename Revert>
+    bool Undo(Revert revert) {
+        if (m_Cursor == 0) {
+            return false;
+        }
+        for (;;) {
+            --m_Cursor;
+            const Entry& entry = At(m_Cursor);
+            revert(entry.edit);
+            if (entry.isGroupStart || m_Cursor == 0) {
+                return true;
+            }
+        }
+    }
+
+    // Hands the edits of the next undone group to apply, oldest first; false when there is none
+    template <typename Apply>
+    bool Redo(Apply apply) {
+        if (m_Cursor == m_Count) {
+            return false;
+        }
+        do {
+            apply(At(m_Cursor).edit);
+            ++m_Cursor;
+        } while (m_Cursor < m_Count && !At(m_Cursor).isGroupStart);
+        return true;
+    }
+
+    // Drops every entry, through the discard handler
+    void Clear() {
+        while (m_Count > m_Cursor) {
+            --m_Count;
+            DiscardEntry(At(m_Count), true);
+        }
+        while (m_Count > 0) {
+            DropOldest();
+        }
+    }
+
+    size_t GetUndoCount() const { return m_Cursor; }
+    size_t GetRedoCount() const { return m_Count - m_Cursor; }
+    size_t GetCapacity() const { return m_Entries.size(); }
+
+private:
+    struct Entry {
+        Edit edit;
+        bool isGroupStart;
+    };
+
+    Entry& At(size_t position) { return m_Entries[(m_First + position) % m_Entries.size()]; }
+    const Entry& At(size_t position) const { return m_Entries[(m_First + position) % m_Entries.size()]; }
+
+    void DiscardEntry(const Entry& entry, bool isUndone) {
+        if (m_Discard) {
+            m_Discard(entry.edit, isUndone);
+        }
+    }
+
+    // Only called with no undone entries left, so the oldest one is in effect
+    void DropOldest() {
+        DiscardEntry(At(0), false);
+        m_First = (m_First + 1) % m_Entries.size();
+        --m_Count;
+        --m_Cursor;
+    }
+
+    // Half a group could not be undone consistently, so the rest of it goes too; a group larger
+    // than the whole ring loses its oldest edits instead
+    void DropOldestGroup() {
+        size_t groupEnd = 1;
+        while (groupEnd < m_Count && !At(groupEnd).isGroupStart) {
+            ++groupEnd;
+        }
+        if (groupEnd == m_Count) {
+            groupEnd = 1;
+        }
+        for (size_t i = 0; i < groupEnd; ++i) {
+            DropOldest();
+        }
+        if (m_Count > 0) {
+            At(0).isGroupStart = true;
+        }
+    }
+
+    std::vector<Entry> m_Entries;
+    DiscardHandler m_Discard;
+
+    size_t m_First;           // Ring slot of the oldest entry
+    size_t m_Count;           // Entries recorded, undone ones included
+    size_t m_Cursor;          // Entries in effect; the ones after it can be redone
+
+    bool m_IsGrouping;
+    bool m_IsGroupEmpty;
+};
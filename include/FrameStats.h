@@ -0,0 +1,61 @@
+#pragma once
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+// The most recent samples of a measurement, in a fixed ring buffer: adding one is O(1) and never
+// allocates, and percentiles are only computed when asked for, on a copy of the window
+class SampleWindow {
+public:
+    explicit SampleWindow(size_t size);
+
+    void Add(double value);
+    // Value at the given percentile (0 to 100), nearest rank
+    double GetPercentile(double percentile) const;
+    double GetAverage() const;
+    size_t GetCount() const { return m_Count; }
+
+private:
+    std::vector<double> m_Samples;     // Oldest overwritten first
+    size_t m_Next;
+    size_t m_Count;
+};
+
+// Frame-time and input-latency statistics over the most recent frames.
+//
+// A frame is late when it took more than 1.5 target intervals, i.e. it missed at least one
+// refresh or cap slot. Input latency runs from the moment GLFW delivered an event to the buffer
+// swap of the first frame that handled it; the display adds its own scan-out time on top.
+class FrameStats {
+public:
+    explicit FrameStats(size_t windowSize);
+
+    // Expected time between frames (the frame cap or the display refresh); 0 counts no late frames
+    void SetTargetInterval(double seconds) { m_TargetInterval = seconds; }
+    double GetTargetInterval() const { return m_TargetInterval; }
+
+    void AddFrame(double seconds);
+    // Simulation steps dropped because a frame fell too far behind
+    void AddSkippedSteps(uint64_t count) { m_SkippedStepCount += count; }
+    void AddInputLatency(double seconds) { m_InputLatencies.Add(seconds); }
+
+    // Frame time at the given percentile (0 to 100) of the window, in seconds
+    double GetPercentile(double percentile) const { return m_FrameTimes.GetPercentile(percentile); }
+    double GetAverageFrameTime() const { return m_FrameTimes.GetAverage(); }
+    double GetInputLatencyPercentile(double percentile) const { return m_InputLatencies.GetPercentile(percentile); }
+
+    uint64_t GetFrameCount() const { return m_FrameCount; }
+    uint64_t GetLateFrameCount() const { return m_LateFrameCount; }
+    uint64_t GetSkippedStepCount() const { return m_SkippedStepCount; }
+
+    void Print(std::ostream& out) const;
+
+private:
+    SampleWindow m_FrameTimes;
+    SampleWindow m_InputLatencies;
+    double m_TargetInterval;
+
+    uint64_t m_FrameCount;
+    uint64_t m_LateFrameCount;
+    uint64_t m_SkippedStepCount;
+};
@@ -0,0 +1,65 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+enum class GLCallType {
+    DRAW,       // glDrawElements, glDrawElementsInstanced, glDrawArrays
+    BIND,       // Vertex arrays, buffers, textures, framebuffers and renderbuffers
+    UPLOAD,     // Buffer and texture data
+    UNIFORM,
+    PROGRAM,    // glUseProgram
+    OTHER       // State, object creation and queries
+};
+
+struct GLCallRecord {
+    GLCallType type;
+    const char* name;
+    uint64_t bytes;             // Data handed to GL; 0 unless the call uploads
+};
+
+struct GLCallCounts {
+    uint64_t draws = 0;
+    uint64_t binds = 0;
+    uint64_t uploads = 0;
+    uint64_t uploadedBytes = 0;
+    uint64_t uniforms = 0;
+    uint64_t programSwitches = 0;
+    uint64_t otherCalls = 0;
+
+    void Add(GLCallType type, uint64_t bytes);
+    uint64_t GetCallCount() const { return draws + binds + uploads + uniforms + programSwitches + otherCalls; }
+};
+
+// Records the GL traffic of the program by swapping the glad function table for wrappers.
+//
+// Install() wraps the driver functions loaded by gladLoadGLLoader: every call the code makes is
+// counted, then passed on. InstallNull() instead points the table at wrappers that do no GL
+// work at all: object names are handed out from a counter, shaders always compile and queries
+// return neutral values. The shapes, the layers and the command lists then run without a window
+// or context, e.g. to check a budget such as "an idle frame draws twice and uploads nothing":
+//
+//   GLRecorder::BeginFrame();
+//   renderThread.Submit();
+//   assert(GLRecorder::GetFrameCounts().draws <= 2 && GLRecorder::GetFrameCounts().uploadedBytes == 0);
+//
+// Only the functions this program calls are wrapped. The counters are not synchronized; read them
+// on the thread that makes the GL calls, or after it has stopped.
+class GLRecorder {
+public:
+    static void Install();
+    static void InstallNull();
+    // Puts the table back as it was before the install
+    static void Uninstall();
+    static bool IsInstalled();
+    static bool IsNull();
+
+    // Restarts the frame counts and the frame log
+    static void BeginFrame();
+    static const GLCallCounts& GetFrameCounts();
+    // Since the install
+    static const GLCallCounts& GetTotalCounts();
+
+    // The frame's calls in order, kept only while logging is on
+    static void SetLogging(bool enabled);
+    static const std::vector<GLCallRecord>& GetFrameLog();
+};
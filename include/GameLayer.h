@@ -4,12 +4,39 @@
 #include "Renderer.h"
 #include "TangramPiece.h"
 #include "Level.h"
+#include "BoardState.h"
+#include "SnapIndex.h"
+#include "Collision.h"
+#include "MagnetGrid.h"
+#include "HintEngine.h"
+#include "InputQueue.h"
+#include "CommandList.h"
+#include "EditLog.h"
 #include <GLFW/glfw3.h>
 #include <vector>
 #include <glm/glm.hpp>
 
 class Application;
 
+enum class PieceEditType {
+    TRANSLATE,
+    ROTATE,
+    FLIP,
+    LOCK,
+    COLOR
+};
+
+// One change to a piece, kept as a delta against m_Board
+struct PieceEdit {
+    PieceEditType type;
+    int piece;
+    glm::vec2 offset;         // TRANSLATE
+    float angle;              // ROTATE
+    int slot;                 // LOCK: snap slot the piece fills
+    glm::vec3 fromColor;      // COLOR
+    glm::vec3 toColor;
+};
+
 enum class GameState {
     PLAYING,
     COMPLETED
@@ -20,29 +47,92 @@ public:
     GameLayer(const char* vertPath, const char* fragPath, Application* windowContext, Level* level);
     ~GameLayer();
     
-    void OnRender();
-    void OnUpdate(GLFWwindow* window);
-    void OnMouseButtonEvent(int button, int action, int mods, double mouseX, double mouseY);
-    void OnKeyEvent(int key, int scancode, int action, int mods);
+    // Records the frame; alpha is how far it lies between the previous and the last simulation step
+    void OnRender(CommandList& commands, float alpha);
+    // One fixed simulation step
+    void OnUpdate(GLFWwindow* window, float deltaTime);
+    // The input since the last frame, oldest first
+    void OnInputEvents(const InputEvent* events, size_t count);
+    // Where the cursor is before the first input event arrives
+    void SetCursorPosition(double x, double y) { m_CursorX = x; m_CursorY = y; }
     
     void ConvertScreenToNDC(double mouseX, double mouseY, float& outX, float& outY);
     void ConvertScreenToWorld(double mouseX, double mouseY, float& outX, float& outY);
     void UpdateViewMatrix();
     
     GameState GetGameState() const { return m_GameState; }
+    // Center of a piece in world space
+    glm::vec2 GetPiecePosition(int index) const { return m_Board.GetPosition(index); }
     void ResetLevel();
+    // Hash of the board and game state; replays of one recording end on the same value
+    uint64_t GetStateHash() const;
     
 private:
+    void OnMouseButtonEvent(int button, int action, int mods, double mouseX, double mouseY);
+    void OnKeyEvent(int key, int scancode, int action, int mods);
+    
     void InitializePieces();
-    void RenderSilhouette();
-    void RenderDynamicSilhouette();
+    void RenderSilhouette(CommandList& commands);
+    void RenderDynamicSilhouette(CommandList& commands);
     bool CheckSolution();
+    void ReportHint();
+    void ReportSolution();
+    
+    // Prints positions in the C++ format used by LevelManager
+    void PrintPositions(const char* title, const std::vector<PiecePosition>& positions);
+    
+    // Rebuild a piece's transform, lock flag and color from m_Board
+    void SyncPiece(int pieceIndex);
+    
+    // Overlap prevention while dragging
+    void RefreshCollisionShape(int pieceIndex);
+    void BeginDragCollision();
+    glm::vec2 ResolveDragCollision(const glm::vec2& delta);
+    
+    // Magnetic alignment with neighbouring pieces while dragging
+    glm::vec2 ApplyMagnet(const glm::vec2& delta);
+    
+    // Undo history; a drag and the snap ending it are one step
+    void RecordEdit(const PieceEdit& edit) { m_EditLog.Record(edit); }
+    void ApplyEdit(const PieceEdit& edit, bool isUndo);
+    void Undo();
+    void Redo();
     
     Shader m_Shader;
-    Renderer m_Renderer;
     
     std::vector<TangramPiece*> m_Pieces;
     TangramPiece* m_SelectedPiece;
+    int m_SelectedPieceIndex;
+    
+    // Authoritative piece state; m_Pieces only hold the render data and follow it
+    BoardState m_Board;
+    BoardState m_InitialBoard;
+    // Board before the last simulation step, for interpolated rendering
+    BoardState m_PreviousBoard;
+    
+    // Solution targets grouped by piece type, built when the level is loaded
+    SnapIndex m_SnapIndex;
+    
+    // Cached world-space outlines, same order as m_Pieces
+    std::vector<CollisionShape> m_CollisionShapes;
+    // Pieces already overlapping the dragged one when the drag started; they may be pulled apart
+    std::vector<bool> m_IgnoreCollision;
+    
+    // Vertices and edges of the resting pieces; the dragged piece is re-inserted on release
+    MagnetGrid m_MagnetGrid;
+    std::vector<glm::vec2> m_MagnetOutline;
+    // Pull currently applied on top of the mouse movement, so the piece can break free again
+    glm::vec2 m_MagnetOffset;
+    bool m_IsMagnetEnabled;
+    
+    // Next-move suggestion, searched a slice per frame
+    HintEngine m_HintEngine;
+    // Solve of the whole silhouette from scratch ('V' key), also a slice per frame
+    IncrementalSolver m_Solver;
+    
+    EditLog<PieceEdit> m_EditLog;
+    // Where the dragged piece was when the drag started
+    glm::vec2 m_DragStartPosition;
     
     Level* m_CurrentLevel;
     Application* m_WindowContext;
@@ -54,6 +144,10 @@ private:
     bool m_IsTranslating;
     bool m_IsPanning;
     
+    // Last cursor position the input reported, in window pixels
+    double m_CursorX;
+    double m_CursorY;
+    
     double m_LastMouseX;
     double m_LastMouseY;
     double m_LastPanMouseX;
@@ -0,0 +1,61 @@
+#pragma once
+#include "BoardState.h"
+#include "Level.h"
+#include "SnapIndex.h"
+#include "TangramSolver.h"
+#include <chrono>
+#include <vector>
+
+// Suggested next move: which piece to take and the slot to put it in
+struct Hint {
+    int pieceIndex;
+    int slotIndex;
+    PiecePosition target;     // Slot pose, with the rotation closest to the piece's current one
+};
+
+// Works out the next move from the board as the player left it.
+//
+// The locked pieces stay where they are and the rest of the silhouette is solved exactly by
+// an IncrementalSolver, a slice of at most the given budget per Update, so a hard board never
+// holds up a frame. The free slots are preferred placements, which keeps the search on the
+// level's own solution whenever the locked pieces allow it. The hint is the first piece the
+// search placed, i.e. the one filling the tightest corner, given to the unlocked piece of that
+// type nearest to it; interchangeable pieces may fill either slot of their type. Levels the
+// solver cannot handle (off the lattice, with holes, or a stored solution that does not tile
+// the silhouette) get the free slot nearest to an unlocked piece instead.
+class HintEngine {
+public:
+    HintEngine();
+
+    // Starts a search for the current board; cheap, the work happens in Update
+    void Request(const Level& level, const BoardState& board, const SnapIndex& snapIndex);
+    void Cancel();
+
+    // Runs the pending search for at most budget. Returns true once, when the hint is ready
+    bool Update(std::chrono::steady_clock::duration budget);
+
+    bool IsSearching() const { return m_IsSearching; }
+    bool HasHint() const { return m_HasHint; }
+    const Hint& GetHint() const { return m_Hint; }
+    uint64_t GetNodesVisited() const { return m_Solver.GetNodesVisited(); }
+
+private:
+    // Picks the unlocked piece for a free slot; false when the slot's type has none left
+    bool MakeHint(int slotIndex);
+    // Without a search: the unlocked piece closest to a free slot of its type
+    bool MakeNearestHint();
+    // Free slot covering the placement exactly, -1 if none does
+    int FindSlot(const LatticePlacement& placement) const;
+
+    IncrementalSolver m_Solver;
+
+    // Snapshot of the board the search started from
+    BoardState m_Board;
+    const SnapIndex* m_SnapIndex;
+    std::vector<LatticePlacement> m_FreeSlotPlacements;
+    std::vector<int> m_FreeSlots;           // Slot index of each entry above
+
+    bool m_IsSearching;
+    bool m_HasHint;
+    Hint m_Hint;
+};
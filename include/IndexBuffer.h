@@ -1,4 +1,5 @@
 #pragma once
+
 class IndexBuffer{
 
 public:
@@ -8,11 +9,15 @@ public:
 	void Bind() const;
 	void Unbind() const;
 	unsigned int GetCount() const;
+	unsigned int GetIndexType() const;
 	void SetData(const unsigned int* data, unsigned int count);
 
 
 private:
+	void Upload(const unsigned int* data, unsigned int count);
+
 	unsigned int m_EBOId;
 	unsigned int m_Count;
+	unsigned int m_IndexType; //GL_UNSIGNED_BYTE, GL_UNSIGNED_SHORT or GL_UNSIGNED_INT, the narrowest that fits
 	
 };
@@ -0,0 +1,70 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+enum class InputEventType {
+    KEY,
+    MOUSE_BUTTON,
+    CURSOR_MOVE,
+    SCROLL
+};
+
+// One window input event as GLFW delivered it
+struct InputEvent {
+    InputEventType type;
+    int code;           // Key or mouse button
+    int scancode;
+    int action;
+    int mods;
+    double x;           // Cursor position in window pixels; wheel offsets for SCROLL
+    double y;
+    double time;        // glfwGetTime() when the callback ran, for latency measurement
+};
+
+// Input events between two frames, in a fixed ring buffer.
+//
+// The GLFW callbacks only append here, and the frame drains the whole queue once and hands the
+// batch to the active layer, so the layers never run inside a callback. Consecutive cursor moves
+// collapse into the newest one and consecutive wheel events add up, so a fast mouse costs one
+// event per frame; anything in between (a click, a key) keeps its place in the order. Mouse
+// buttons carry the last cursor position, so nothing needs to ask GLFW for it. Callbacks and
+// the drain both run on the main thread, so there is no locking.
+class InputQueue {
+public:
+    static const size_t CAPACITY = 256;
+
+    InputQueue();
+
+    void PushKey(int key, int scancode, int action, int mods, double time);
+    void PushMouseButton(int button, int action, int mods, double time);
+    void PushCursorMove(double x, double y, double time);
+    void PushScroll(double offsetX, double offsetY, double time);
+
+    // Replaces batch with every pending event, oldest first, and empties the queue
+    void Drain(std::vector<InputEvent>& batch);
+
+    // Starting cursor position, before the first move arrives
+    void SetCursorPosition(double x, double y);
+    double GetCursorX() const { return m_CursorX; }
+    double GetCursorY() const { return m_CursorY; }
+
+    uint64_t GetCoalescedCount() const { return m_CoalescedCount; }
+    // Events lost because a frame took so long that the queue filled up
+    uint64_t GetDroppedCount() const { return m_DroppedCount; }
+
+private:
+    void Push(const InputEvent& event);
+    // Newest queued event, nullptr when the queue is empty
+    InputEvent* GetLast();
+
+    InputEvent m_Events[CAPACITY];
+    size_t m_Head;      // Oldest event
+    size_t m_Count;
+
+    double m_CursorX;
+    double m_CursorY;
+
+    uint64_t m_CoalescedCount;
+    uint64_t m_DroppedCount;
+};
@@ -0,0 +1,93 @@
+#pragma once
+#include "InputQueue.h"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+// Input recording: every frame's input batch, as the layers received it, and the frame time
+// the simulation stepped through. Replaying both reproduces the same fixed steps with the same
+// input in the same order, so a session plays back identically however fast it is replayed.
+//
+// Layout (native little-endian, unaligned):
+//   InputRecordingHeader
+//   per frame: uint8 flags, double frameTime, [int32 window w/h, framebuffer w/h if
+//              FRAME_HAS_SIZE], uint16 eventCount, the events
+//   per event: uint8 type, then
+//              KEY           int16 key, int32 scancode, uint8 action, uint8 mods, double time
+//              MOUSE_BUTTON  uint8 button, uint8 action, uint8 mods, double x, y, time
+//              CURSOR_MOVE   double x, y, time
+//              SCROLL        double x, y, time
+// Key events take the cursor position of the events before them, as the queue gives them.
+// Sizes are only written when they change; the first frame always has them.
+
+static const uint32_t INPUT_RECORDING_VERSION = 1;
+
+struct InputRecordingHeader {
+    char magic[4];             // "TGIR"
+    uint32_t version;
+    double cursorX;            // Cursor before the first event
+    double cursorY;
+};
+
+// What a frame ran with besides its input
+struct RecordedFrame {
+    double frameTime;          // Seconds since the previous frame
+    int windowWidth;           // Screen coordinates, like the cursor
+    int windowHeight;
+    int framebufferWidth;
+    int framebufferHeight;
+};
+
+class InputRecorder {
+public:
+    InputRecorder();
+    ~InputRecorder();
+
+    bool Open(const char* path, double cursorX, double cursorY);
+    void WriteFrame(const RecordedFrame& frame, const std::vector<InputEvent>& events);
+    void Close();
+
+    bool IsOpen() const { return m_File.is_open(); }
+    uint64_t GetFrameCount() const { return m_FrameCount; }
+
+private:
+    std::ofstream m_File;
+    std::vector<uint8_t> m_Buffer;     // One frame, written at once
+    RecordedFrame m_LastFrame;
+    uint64_t m_FrameCount;
+};
+
+// Reads a whole recording into memory up front, so replaying does no file I/O
+class InputReplay {
+public:
+    InputReplay();
+
+    bool Open(const char* path);
+    bool IsOpen() const { return m_IsOpen; }
+
+    // The next frame and its input; false at the end of the recording
+    bool ReadFrame(RecordedFrame& frame, std::vector<InputEvent>& events);
+
+    // Cursor after the events read so far
+    double GetCursorX() const { return m_CursorX; }
+    double GetCursorY() const { return m_CursorY; }
+
+    uint64_t GetFrameCount() const { return m_FrameCount; }
+    uint64_t GetEventCount() const { return m_EventCount; }
+
+private:
+    template <typename T>
+    bool Read(T& value);
+
+    std::vector<uint8_t> m_Data;
+    size_t m_Position;
+    bool m_IsOpen;
+
+    RecordedFrame m_Frame;             // Sizes carry over from frame to frame
+    double m_CursorX;
+    double m_CursorY;
+
+    uint64_t m_FrameCount;
+    uint64_t m_EventCount;
+};
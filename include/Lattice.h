@@ -0,0 +1,107 @@
+#pragma once
+#include <cstdint>
+#include <glm/glm.hpp>
+
+// Exact coordinate of the form (a + b*sqrt(2)) / 4.
+// Every tangram vertex lies on multiples of sqrt(2)/2 and 1/2, so storing the two integer
+// coefficients keeps positions exact: comparisons never drift and never need a tolerance.
+struct LatticeScalar {
+    static const int DENOMINATOR = 4;
+
+    int a;
+    int b;
+
+    LatticeScalar() : a(0), b(0) {}
+    LatticeScalar(int rational, int irrational) : a(rational), b(irrational) {}
+
+    LatticeScalar operator+(const LatticeScalar& other) const { return LatticeScalar(a + other.a, b + other.b); }
+    LatticeScalar operator-(const LatticeScalar& other) const { return LatticeScalar(a - other.a, b - other.b); }
+    LatticeScalar operator-() const { return LatticeScalar(-a, -b); }
+    bool operator==(const LatticeScalar& other) const { return a == other.a && b == other.b; }
+    bool operator!=(const LatticeScalar& other) const { return !(*this == other); }
+    bool operator<(const LatticeScalar& other) const { return (*this - other).Sign() < 0; }
+
+    // Multiply by sqrt(2)/2, the scale of a 45 degree rotation. The result is on the lattice
+    // only when a is even, which holds for all piece outlines relative to their anchor; for
+    // an odd a it fails and leaves out unchanged
+    bool MulHalfSqrt2(LatticeScalar& out) const {
+        if (a % 2 != 0) {
+            return false;
+        }
+        out = LatticeScalar(b, a / 2);
+        return true;
+    }
+
+    int Sign() const;
+    float ToFloat() const;
+
+    // The lattice value the float represents: the one it is exactly, or the only one within
+    // tolerance. Fails when none or several are that close
+    static bool FromFloat(float value, float tolerance, LatticeScalar& out);
+};
+
+// Exact product of two lattice scalars, (a + b*sqrt(2)) / 16. Used for cross products and areas
+struct LatticeProduct {
+    static const int DENOMINATOR = 16;
+
+    int64_t a;
+    int64_t b;
+
+    LatticeProduct() : a(0), b(0) {}
+    LatticeProduct(int64_t rational, int64_t irrational) : a(rational), b(irrational) {}
+
+    LatticeProduct operator+(const LatticeProduct& other) const { return LatticeProduct(a + other.a, b + other.b); }
+    LatticeProduct operator-(const LatticeProduct& other) const { return LatticeProduct(a - other.a, b - other.b); }
+    bool operator==(const LatticeProduct& other) const { return a == other.a && b == other.b; }
+    bool operator!=(const LatticeProduct& other) const { return !(*this == other); }
+
+    int Sign() const;
+    double ToDouble() const;
+};
+
+LatticeProduct operator*(const LatticeScalar& lhs, const LatticeScalar& rhs);
+
+struct LatticePoint {
+    LatticeScalar x;
+    LatticeScalar y;
+
+    LatticePoint() {}
+    LatticePoint(const LatticeScalar& px, const LatticeScalar& py) : x(px), y(py) {}
+
+    LatticePoint operator+(const LatticePoint& other) const { return LatticePoint(x + other.x, y + other.y); }
+    LatticePoint operator-(const LatticePoint& other) const { return LatticePoint(x - other.x, y - other.y); }
+    bool operator==(const LatticePoint& other) const { return x == other.x && y == other.y; }
+    bool operator!=(const LatticePoint& other) const { return !(*this == other); }
+
+    // Strict ordering (x first) so outlines can be sorted and compared as sets
+    bool operator<(const LatticePoint& other) const {
+        if (x != other.x) return x < other.x;
+        return y < other.y;
+    }
+
+    // Rotate by steps of 45 degrees counter-clockwise around the origin. Odd steps need
+    // x - y and x + y to have even rational parts (see MulHalfSqrt2) and fail otherwise
+    bool Rotated(int steps, LatticePoint& out) const;
+    LatticePoint Flipped() const { return LatticePoint(-x, y); }
+
+    glm::vec2 ToVec2() const { return glm::vec2(x.ToFloat(), y.ToFloat()); }
+    static bool FromVec2(const glm::vec2& value, float tolerance, LatticePoint& out);
+};
+
+// Exact cross product (b - a) x (c - a); its sign is the orientation of the three points
+LatticeProduct Cross(const LatticePoint& a, const LatticePoint& b, const LatticePoint& c);
+
+// Exact placement of a tangram piece: the lattice point its outline is built around,
+// a rotation in steps of 45 degrees and the flip state (flip applied before rotation)
+struct LatticePose {
+    LatticePoint anchor;
+    int rotation;
+    bool isFlipped;
+
+    LatticePose() : rotation(0), isFlipped(false) {}
+    LatticePose(const LatticePoint& point, int steps, bool flipped) : anchor(point), rotation(steps), isFlipped(flipped) {}
+
+    bool operator==(const LatticePose& other) const {
+        return anchor == other.anchor && rotation == other.rotation && isFlipped == other.isFlipped;
+    }
+};
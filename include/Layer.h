@@ -3,12 +3,36 @@
 #include "Shader.h"
 #include "Renderer.h"
 #include "Shape.h"
+#include "MagnetGrid.h"
+#include "ShapeArena.h"
+#include "EditLog.h"
+#include "InputQueue.h"
+#include <cstdint>
 #include <GLFW/glfw3.h>
 #include <vector>
 #include <glm/glm.hpp>
 
 class Application;
 
+enum class ShapeEditType {
+	TRANSLATE,
+	ROTATE,
+	SCALE,
+	COLOR,
+	CREATE,
+	DELETE
+};
+
+//One editor change, kept as a delta. A deleted shape stays in the arena, hidden, for as long as
+//its entry can be undone
+struct ShapeEdit {
+	ShapeEditType type;
+	ShapeHandle shape;
+	glm::vec2 amount;     //TRANSLATE offset, SCALE factors, ROTATE angle in x
+	glm::vec3 fromColor;  //COLOR only
+	glm::vec3 toColor;
+};
+
 class Layer{
 public:
 
@@ -19,17 +43,39 @@ public:
 	void OnUpdate(GLFWwindow* window);
 	void OnMouseButtonEvent(int button, int action, int mods, double mouseX, double mouseY);
 	void OnKeyEvent(int key, int scancode, int action, int mods);
+	//The input since the last frame, oldest first
+	void OnInputEvents(const InputEvent* events, size_t count);
+	//Where the cursor is before the first input event arrives
+	void SetCursorPosition(double x, double y) { m_CursorX = x; m_CursorY = y; }
 	void ConvertScreenToNDC(double mouseX, double mouseY, float& outX, float& outY);
 	void ConvertScreenToWorld(double mouseX, double mouseY, float& outX, float& outY);
 	void UpdateViewMatrix();
 
+	//Stress testing: adds count random rectangles, triangles, circles and polygons spread over
+	//the visible canvas, the same ones for the same seed
+	void GenerateStressScene(size_t count, uint32_t seed);
+	size_t GetShapeCount() const { return m_Shapes.GetCount(); }
+	size_t GetSelectionCount() const { return m_SelectedShape.size(); }
+
 private:
 
+	//Magnetic snapping
+	void RefreshMagnet(Shape* shape);
+	glm::vec2 ApplyMagnet(const glm::vec2& delta);
+
+	//Undo history
+	void RecordEdit(ShapeEditType type, ShapeHandle handle, const glm::vec2& amount);
+	void SetSelectionColor(const glm::vec3& color);
+	void ApplyEdit(const ShapeEdit& edit, bool isUndo);
+	void DiscardEdit(const ShapeEdit& edit, bool isUndone);
+	void Undo();
+	void Redo();
+
 	Shader m_Shader;
 	Renderer m_Renderer;
 
-	std::vector<Shape*> m_Shape;
-	std::vector<Shape*> m_SelectedShape;
+	ShapeArena m_Shapes;
+	std::vector<ShapeHandle> m_SelectedShape;
 
 	int m_CurrentMode;
 
@@ -43,6 +89,10 @@ private:
 	bool m_IsTranslating;
 	bool m_IsPanning;
 
+	//Cursor as of the last input event, in screen coordinates
+	double m_CursorX;
+	double m_CursorY;
+
 	double m_LastMouseX;
     double m_LastMouseY;
 	double m_LastPanMouseX;
@@ -51,5 +101,13 @@ private:
 	float m_ZoomLevel;
 	glm::vec3 m_PanOffset;
 
+	MagnetGrid m_MagnetGrid;
+	std::vector<glm::vec2> m_MagnetOutline;
+	glm::vec2 m_MagnetOffset; //Pull applied on top of the mouse movement
+	bool m_IsMagnetEnabled;
+
+	EditLog<ShapeEdit> m_EditLog;
+	glm::vec2 m_DragDelta; //Applied so far in the current drag, recorded on release
+
 };
 
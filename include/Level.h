@@ -2,6 +2,7 @@
 #include <vector>
 #include <string>
 #include <glm/glm.hpp>
+#include "Lattice.h"
 
 struct PiecePosition {
     int pieceIndex;           // Index in the pieces array
@@ -15,15 +16,42 @@ public:
     Level(int levelNumber, const std::string& name, 
           const std::vector<glm::vec2>& silhouetteVertices,
           const std::vector<PiecePosition>& solution);
+    // Exact level, e.g. from a level pack or the generator; pieceIndices parallels solution
+    Level(int levelNumber, const std::string& name,
+          const std::vector<LatticePoint>& silhouette,
+          const std::vector<int>& pieceIndices,
+          const std::vector<LatticePose>& solution,
+          const std::vector<std::vector<LatticePoint>>& holes = {});
     
     int GetLevelNumber() const { return m_LevelNumber; }
     const std::string& GetName() const { return m_Name; }
     const std::vector<glm::vec2>& GetSilhouetteVertices() const { return m_SilhouetteVertices; }
     const std::vector<PiecePosition>& GetSolution() const { return m_Solution; }
+    // Clockwise outlines of the gaps inside the silhouette, usually none
+    const std::vector<std::vector<glm::vec2>>& GetSilhouetteHoles() const { return m_SilhouetteHoles; }
+    
+    // Exact lattice versions of the silhouette and solution, valid when IsOnLattice()
+    bool IsOnLattice() const { return m_IsOnLattice; }
+    const std::vector<LatticePoint>& GetLatticeSilhouette() const { return m_LatticeSilhouette; }
+    const std::vector<LatticePose>& GetLatticeSolution() const { return m_LatticeSolution; }
+    const std::vector<std::vector<LatticePoint>>& GetLatticeHoles() const { return m_LatticeHoles; }
+    
+    // Replaces the silhouette with the exact union of the solution pieces. Keeps the stored
+    // one and returns false when the level is off the lattice or its pieces overlap
+    bool DeriveSilhouette();
     
 private:
+    void QuantizeToLattice();
+    void UpdateSilhouetteVertices();
+    
     int m_LevelNumber;
     std::string m_Name;
     std::vector<glm::vec2> m_SilhouetteVertices;  // Outline of target shape
     std::vector<PiecePosition> m_Solution;         // Solution piece positions
+    std::vector<std::vector<glm::vec2>> m_SilhouetteHoles;
+    
+    bool m_IsOnLattice;
+    std::vector<LatticePoint> m_LatticeSilhouette;
+    std::vector<LatticePose> m_LatticeSolution;    // Same order as m_Solution
+    std::vector<std::vector<LatticePoint>> m_LatticeHoles;
 };
@@ -0,0 +1,33 @@
+#pragma once
+#include "Lattice.h"
+#include "ThreadPool.h"
+#include <cstdint>
+#include <random>
+#include <vector>
+
+struct GeneratedLevel {
+    std::vector<LatticePoint> silhouette;   // Counter-clockwise, centered near the origin
+    std::vector<LatticePose> poses;         // Standard piece order
+    uint64_t hash = 0;                      // HashCanonicalContour of the silhouette
+};
+
+// Random tangram puzzles: the seven pieces are dropped one at a time, each corner to corner
+// with a piece already down and sharing part of an edge with one, never overlapping. The
+// outline of the result is the silhouette; arrangements with holes or shapes touching only
+// at a point are thrown away. Duplicates are detected on the canonical silhouette, so
+// rotated, mirrored or shifted copies of a shape count as the same puzzle.
+class LevelGenerator {
+public:
+    explicit LevelGenerator(ThreadPool& pool);
+
+    // Up to count distinct levels, fewer if the attempt budget runs out first. Every attempt
+    // is seeded from seed and its index and the results are merged in index order, so the
+    // same seed gives the same levels whatever the pool size
+    std::vector<GeneratedLevel> Generate(int count, uint32_t seed) const;
+
+    // One random arrangement; false when it dead-ends or has an unusable silhouette
+    static bool TryGenerate(std::mt19937& random, GeneratedLevel& outLevel);
+
+private:
+    ThreadPool& m_Pool;
+};
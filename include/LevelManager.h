@@ -1,29 +1,94 @@
 #pragma once
 #include "Level.h"
+#include "LevelPack.h"
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 #include <memory>
 
+// Levels are decoded on first use and kept in a bounded LRU cache, so startup cost does not
+// depend on the number of levels. Neighbours of every requested level are decoded ahead of
+// time on a background thread. Levels handed out stay alive while the caller holds them,
+// even after the cache has dropped them.
 class LevelManager {
 public:
-    LevelManager();
+    static const size_t DEFAULT_CACHE_CAPACITY = 32;
+
+    explicit LevelManager(size_t cacheCapacity = DEFAULT_CACHE_CAPACITY);
     ~LevelManager();
-    
+
+    LevelManager(const LevelManager&) = delete;
+    LevelManager& operator=(const LevelManager&) = delete;
+
+    // Selects the built-in levels
     void LoadLevels();
-    Level* GetLevel(int index);
-    int GetLevelCount() const { return m_Levels.size(); }
-    
+    // Replaces the built-in levels with those of a binary pack (see LevelPack.h)
+    bool LoadLevelPack(const std::string& path);
+
+    std::shared_ptr<Level> GetLevel(int index);
+    int GetLevelCount() const;
+
+    // Read from the pack index when possible, without decoding the level
+    std::string GetLevelName(int index);
+    // Identifies a level's geometry for caches keyed on it; read from the pack without
+    // decoding when possible. 0 for a missing or corrupt level
+    uint64_t GetLevelHash(int index);
+
+    static const int BUILTIN_LEVEL_COUNT = 10;
+
+    // Built-in level as written, silhouette not yet derived from the solution; safe to call
+    // from any thread
+    static Level* CreateBuiltinLevel(int index);
+
 private:
-    std::vector<Level*> m_Levels;
-    
-    // Helper methods to create individual levels
-    void CreateLevel1();
-    void CreateLevel2();
-    void CreateLevel3();
-    void CreateLevel4();
-    void CreateLevel5();
-    void CreateLevel6();
-    void CreateLevel7();
-    void CreateLevel8();
-    void CreateLevel9();
-    void CreateLevel10();
+    struct CacheEntry {
+        int index;
+        std::shared_ptr<Level> level;
+    };
+
+    // Builds a level from the current source; nullptr on a corrupt entry
+    Level* DecodeLevel(int index) const;
+
+    // Cached level marked as most recently used, or nullptr
+    std::shared_ptr<Level> FindCached(int index);
+    // Takes ownership and evicts the least recently used levels; keeps an existing entry if
+    // another thread decoded the same level first
+    std::shared_ptr<Level> Insert(int index, Level* level);
+    void ClearCache();
+
+    void RequestPrefetch(int index);
+    void PrefetchLoop();
+
+    // Level source: the pack when open, the built-in levels otherwise
+    LevelPack m_Pack;
+    std::mutex m_SourceMutex;
+
+    // Most recently used first
+    std::list<CacheEntry> m_Cache;
+    std::unordered_map<int, std::list<CacheEntry>::iterator> m_CacheLookup;
+    size_t m_CacheCapacity;
+    std::mutex m_CacheMutex;
+
+    std::deque<int> m_PrefetchQueue;
+    std::mutex m_PrefetchMutex;
+    std::condition_variable m_PrefetchCondition;
+    bool m_IsStopping;
+    std::thread m_PrefetchThread;
+
+    // Factories for the built-in levels
+    static Level* CreateLevel1();
+    static Level* CreateLevel2();
+    static Level* CreateLevel3();
+    static Level* CreateLevel4();
+    static Level* CreateLevel5();
+    static Level* CreateLevel6();
+    static Level* CreateLevel7();
+    static Level* CreateLevel8();
+    static Level* CreateLevel9();
+    static Level* CreateLevel10();
 };
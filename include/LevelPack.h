@@ -0,0 +1,167 @@
+#pragma once
+#include "Level.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <glm/glm.hpp>
+
+// Binary level pack, memory-mapped read-only and read in place.
+//
+// Layout (native little-endian, every section 4-byte aligned):
+//   LevelPackHeader
+//   LevelPackEntry[levelCount]     fixed-size index, so level i is found in O(1)
+//   name bytes, silhouette and solution blobs, referenced by offset from the entries
+//
+// Levels on the tangram lattice are stored exactly (PackedLatticePoint, PackedLatticePiece),
+// so they load without re-quantizing float positions; others fall back to floats
+// (PackedVertex, PackedPiece). Opening only validates the header and the index bounds;
+// each entry is checked when read.
+//
+// Silhouette holes (exact levels only) follow the outer vertices in the same vertex block,
+// and a uint32_t vertex count per hole follows the block.
+
+static const uint32_t LEVEL_PACK_VERSION = 3;
+
+// LevelPackEntry::flags
+static const uint16_t LEVEL_PACK_EXACT = 1;
+
+struct LevelPackHeader {
+    char magic[4];             // "TGPK"
+    uint32_t version;
+    uint32_t levelCount;
+    uint32_t indexOffset;      // Offset of the LevelPackEntry array
+    uint32_t fileSize;         // Total size, guards against truncated files
+    uint32_t reserved[3];
+};
+
+struct LevelPackEntry {
+    uint32_t levelNumber;
+    uint32_t nameOffset;
+    uint32_t nameLength;
+    uint32_t vertexOffset;
+    uint32_t vertexCount;      // Outer and hole vertices together
+    uint32_t pieceOffset;
+    uint32_t pieceCount;
+    uint16_t flags;
+    uint16_t holeCount;
+};
+
+struct PackedVertex {
+    float x;
+    float y;
+};
+
+struct PackedPiece {
+    int32_t pieceIndex;
+    float x;
+    float y;
+    float rotation;            // Radians
+    uint32_t isFlipped;
+};
+
+struct PackedLatticePoint {
+    int32_t xRational;
+    int32_t xIrrational;
+    int32_t yRational;
+    int32_t yIrrational;
+};
+
+struct PackedLatticePiece {
+    int32_t pieceIndex;
+    PackedLatticePoint anchor;
+    int32_t rotation;          // Steps of 45 degrees
+    uint32_t isFlipped;
+};
+
+static_assert(sizeof(LevelPackHeader) == 32, "LevelPackHeader layout is part of the file format");
+static_assert(sizeof(LevelPackEntry) == 32, "LevelPackEntry layout is part of the file format");
+static_assert(sizeof(PackedVertex) == 8, "PackedVertex layout is part of the file format");
+static_assert(sizeof(PackedPiece) == 20, "PackedPiece layout is part of the file format");
+static_assert(sizeof(PackedLatticePoint) == 16, "PackedLatticePoint layout is part of the file format");
+static_assert(sizeof(PackedLatticePiece) == 28, "PackedLatticePiece layout is part of the file format");
+
+static const uint64_t LEVEL_HASH_SEED = 14695981039346656037ull;
+
+// FNV-1a over raw bytes, chained by passing the previous result; keys caches on level data
+uint64_t HashLevelBytes(const void* data, size_t size, uint64_t hash = LEVEL_HASH_SEED);
+
+// Zero-copy view of one level inside a mapped pack; valid while the pack stays open
+class LevelView {
+public:
+    LevelView() : m_Base(nullptr), m_Entry(nullptr) {}
+    LevelView(const uint8_t* base, const LevelPackEntry* entry) : m_Base(base), m_Entry(entry) {}
+
+    bool IsValid() const { return m_Entry != nullptr; }
+
+    int GetLevelNumber() const { return m_Entry->levelNumber; }
+    std::string_view GetName() const {
+        return std::string_view((const char*)(m_Base + m_Entry->nameOffset), m_Entry->nameLength);
+    }
+
+    int GetVertexCount() const { return m_Entry->vertexCount; }
+    int GetPieceCount() const { return m_Entry->pieceCount; }
+    int GetHoleCount() const { return m_Entry->holeCount; }
+
+    // Exact levels only expose the lattice records, the others only the float ones
+    bool IsExact() const { return (m_Entry->flags & LEVEL_PACK_EXACT) != 0; }
+    const PackedVertex* GetSilhouette() const { return (const PackedVertex*)(m_Base + m_Entry->vertexOffset); }
+    const PackedPiece* GetSolution() const { return (const PackedPiece*)(m_Base + m_Entry->pieceOffset); }
+    const PackedLatticePoint* GetLatticeSilhouette() const { return (const PackedLatticePoint*)(m_Base + m_Entry->vertexOffset); }
+    const PackedLatticePiece* GetLatticeSolution() const { return (const PackedLatticePiece*)(m_Base + m_Entry->pieceOffset); }
+    const uint32_t* GetHoleSizes() const {
+        return (const uint32_t*)(m_Base + m_Entry->vertexOffset + m_Entry->vertexCount * sizeof(PackedLatticePoint));
+    }
+
+    // Hash of the geometry records, name excluded; no decoding needed
+    uint64_t GetContentHash() const;
+
+    // Decodes the view into a heap Level the game layers can own
+    Level* CreateLevel() const;
+
+private:
+    const uint8_t* m_Base;
+    const LevelPackEntry* m_Entry;
+};
+
+class LevelPack {
+public:
+    LevelPack();
+    ~LevelPack();
+
+    LevelPack(const LevelPack&) = delete;
+    LevelPack& operator=(const LevelPack&) = delete;
+
+    // Maps the file and checks the header; constant time regardless of the level count
+    bool Open(const std::string& path);
+    void Close();
+
+    bool IsOpen() const { return m_Data != nullptr; }
+    int GetLevelCount() const { return m_Header != nullptr ? (int)m_Header->levelCount : 0; }
+
+    // Invalid view when the index is out of range, the entry points outside the file or a
+    // piece index or rotation is out of range
+    LevelView GetLevel(int index) const;
+
+private:
+    const uint8_t* m_Data;
+    size_t m_Size;
+    const LevelPackHeader* m_Header;
+    const LevelPackEntry* m_Entries;
+};
+
+// Accumulates levels and writes them out as a pack in one go
+class LevelPackWriter {
+public:
+    // Stored exactly when the level is on the lattice
+    void AddLevel(const Level& level);
+
+    int GetLevelCount() const { return m_Entries.size(); }
+
+    bool Write(const std::string& path) const;
+
+private:
+    std::vector<LevelPackEntry> m_Entries;   // Offsets relative to the start of m_Blob
+    std::vector<uint8_t> m_Blob;
+};
@@ -0,0 +1,94 @@
+#pragma once
+#include <cstddef>
+#include <ostream>
+#include <streambuf>
+
+// Lowest level compiled in: 0 debug, 1 info, 2 warning, 3 error. Messages below it are removed
+// at compile time, formatting included; the Makefile sets it from LOG_LEVEL
+#ifndef TANGRAM_LOG_LEVEL
+#define TANGRAM_LOG_LEVEL 1
+#endif
+
+enum class LogLevel {
+    DEBUG,
+    INFO,
+    WARNING,
+    ERROR
+};
+
+enum class LogCategory {
+    APP,
+    EDITOR,
+    GAME,
+    MENU,
+    RENDER
+};
+
+// Asynchronous console log.
+//
+// A message is formatted into a fixed-size record on the caller's stack and pushed into a
+// bounded lock-free queue; a background thread writes the records out and flushes the console
+// once per batch. Callers never wait for the terminal or a lock, and a full queue drops the
+// message instead of blocking (the drops are reported on Stop). Info messages print as they
+// are, other levels get a "[level:category]" prefix and warnings and errors go to stderr.
+// Before Start and after Stop messages are written synchronously.
+class Log {
+public:
+    // Longest message kept; longer ones are cut off
+    static const size_t MAX_MESSAGE_LENGTH = 500;
+
+    static void Start();
+    // Writes out everything still queued and stops the writer thread
+    static void Stop();
+    // Waits until every message queued so far has been written
+    static void Flush();
+
+    // Runtime threshold on top of the compiled one
+    static void SetLevel(LogLevel level);
+    static bool IsEnabled(LogLevel level);
+
+    static void Write(LogLevel level, LogCategory category, const char* text, size_t length);
+};
+
+// One message being formatted; queued when it goes out of scope
+class LogMessage {
+public:
+    LogMessage(LogLevel level, LogCategory category);
+    ~LogMessage();
+
+    LogMessage(const LogMessage&) = delete;
+    LogMessage& operator=(const LogMessage&) = delete;
+
+    std::ostream& GetStream() { return m_Stream; }
+
+private:
+    // Formats into m_Text and silently stops when it is full
+    class Buffer : public std::streambuf {
+    public:
+        Buffer(char* begin, size_t size) { setp(begin, begin + size); }
+        size_t GetLength() const { return pptr() - pbase(); }
+
+    protected:
+        int_type overflow(int_type ch) override { return traits_type::not_eof(ch); }
+    };
+
+    LogLevel m_Level;
+    LogCategory m_Category;
+    char m_Text[Log::MAX_MESSAGE_LENGTH];
+    Buffer m_Buffer;
+    std::ostream m_Stream;
+};
+
+#define TANGRAM_LOG(level, category, message)                                   \
+    do {                                                                        \
+        if ((int)(level) >= TANGRAM_LOG_LEVEL && Log::IsEnabled(level)) {       \
+            LogMessage logMessage_(level, category);                            \
+            logMessage_.GetStream() << message;                                 \
+        }                                                                       \
+    } while (0)
+
+// LOG_INFO(GAME, "Zoom level: " << zoom);
+#define LOG_DEBUG(category, message) TANGRAM_LOG(LogLevel::DEBUG, LogCategory::category, message)
+#define LOG_INFO(category, message) TANGRAM_LOG(LogLevel::INFO, LogCategory::category, message)
+#define LOG_WARNING(category, message) TANGRAM_LOG(LogLevel::WARNING, LogCategory::category, message)
+#define LOG_ERROR(category, message) TANGRAM_LOG(LogLevel::ERROR, LogCategory::category, message)
@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+
+class Shape;
+
+// Magnet pull range in world units for the game and the editor; the grid cells must be at
+// least this large, since FindSnap only looks at the neighbouring cells
+static const float MAGNET_RADIUS = 0.12f;
+static const float MAGNET_CELL_SIZE = 0.25f;
+
+// Shape outline transformed by its model matrix
+void GetWorldOutline(const Shape& shape, std::vector<glm::vec2>& outVertices);
+
+// Spatial hash of world-space vertices and edges used for magnetic snapping.
+// Each shape's outline is stored under its owner pointer and replaced incrementally
+// when that shape moves, so the cost of an update is proportional to its own outline.
+class MagnetGrid {
+public:
+    explicit MagnetGrid(float cellSize);
+
+    // Replace the owner's features with a closed world-space outline
+    void Update(const Shape* owner, const std::vector<glm::vec2>& outline);
+    void Remove(const Shape* owner);
+    void Clear();
+
+    // Offset that moves the outline onto a nearby vertex, or flush against a nearby parallel
+    // edge, of any shape not in ignoredOwners. Returns false if nothing is within radius
+    bool FindSnap(const std::vector<glm::vec2>& outline, const std::vector<const Shape*>& ignoredOwners,
+                  float radius, glm::vec2& outOffset) const;
+
+private:
+    struct Edge {
+        glm::vec2 start;
+        glm::vec2 end;
+        glm::vec2 direction;   // Unit vector from start to end
+    };
+
+    struct OwnerFeatures {
+        std::vector<glm::vec2> vertices;
+        std::vector<Edge> edges;
+        std::vector<int64_t> cells;   // Cells holding an entry for this owner, for removal
+    };
+
+    struct CellEntry {
+        const Shape* owner;
+        int feature;
+        bool isEdge;
+    };
+
+    int64_t CellKey(const glm::vec2& point) const;
+    int64_t CellKey(int cellX, int cellY) const;
+    void Insert(int64_t key, const CellEntry& entry, OwnerFeatures& features);
+
+    template <typename Visitor>
+    void VisitNeighbourhood(const glm::vec2& point, const std::vector<const Shape*>& ignoredOwners, Visitor visitor) const;
+
+    float m_CellSize;
+    std::unordered_map<int64_t, std::vector<CellEntry>> m_Cells;
+    std::unordered_map<const Shape*, OwnerFeatures> m_Owners;
+};
@@ -2,42 +2,125 @@
 #include "VertexArray.h"
 #include "Shader.h"
 #include "Renderer.h"
-#include "Rectangle.h"
+#include "IndexBuffer.h"
 #include "LevelManager.h"
+#include "ThumbnailAtlas.h"
+#include "InputQueue.h"
+#include "CommandList.h"
 #include <GLFW/glfw3.h>
 #include <vector>
 #include <glm/glm.hpp>
 
 class Application;
 
+// One level button as drawn by the instanced menu shader
+struct ButtonInstance {
+    glm::vec4 rect;     // Min x, min y, max x, max y in world space
+    glm::vec4 uv;       // Thumbnail cell in the atlas
+    glm::vec4 color;    // Background
+};
+
+// What the render side needs to draw one menu frame, copied out of the main-thread state
+struct MenuFrame {
+    int firstLevel;           // Visible levels, end exclusive
+    int endLevel;
+    int hoveredButton;
+    int columns;
+    float gridLeft;
+    float gridTop;
+    bool isDirty;             // The buttons changed since the last recorded frame
+    glm::mat4 projection;
+    glm::mat4 view;
+};
+
+// Scrolling grid of level buttons. Only the rows on screen exist as instances and have
+// thumbnails resident, and the button under a point is found by arithmetic on the grid,
+// so nothing per frame depends on the number of levels.
+//
+// Scrolling, hover and hit testing run on the main thread; the thumbnail atlas and the button
+// instances belong to the render side and are only touched by the task OnRender records.
 class MenuLayer {
 public:
     MenuLayer(const char* vertPath, const char* fragPath, Application* windowContext, LevelManager* levelManager);
     ~MenuLayer();
-    
-    void OnRender();
-    void OnUpdate(GLFWwindow* window);
-    void OnMouseButtonEvent(int button, int action, int mods, double mouseX, double mouseY);
-    void OnKeyEvent(int key, int scancode, int action, int mods);
-    
+
+    // Records the frame; alpha is how far it lies between the previous and the last simulation step
+    void OnRender(CommandList& commands, float alpha);
+    // One fixed simulation step
+    void OnUpdate(GLFWwindow* window, float deltaTime);
+    // The input since the last frame, oldest first
+    void OnInputEvents(const InputEvent* events, size_t count);
+
     void ConvertScreenToNDC(double mouseX, double mouseY, float& outX, float& outY);
     void ConvertScreenToWorld(double mouseX, double mouseY, float& outX, float& outY);
-    
+
     int GetSelectedLevel() const { return m_SelectedLevel; }
     void ResetSelection() { m_SelectedLevel = -1; }
-    
+
 private:
-    void CreateLevelButtons();
-    
-    Shader m_Shader;
+    void OnMouseButtonEvent(int button, int action, int mods, double mouseX, double mouseY, double time);
+    void OnCursorMoveEvent(double mouseX, double mouseY, double time);
+    void OnKeyEvent(int key, int scancode, int action, int mods);
+    void OnScrollEvent(double offsetX, double offsetY);
+
+    void CreateButtonQuad();
+    // Fits the columns to the window; the grid is laid out at a scroll offset of zero
+    void UpdateLayout();
+    void UpdateScroll(float deltaTime);
+    // Rows on screen, anywhere between the last two steps
+    void UpdateVisibleRows();
+    // Render side: resident thumbnails, then the instances when they or their contents changed
+    void RenderButtons(const MenuFrame& frame);
+    int FindButton(float worldX, float worldY) const;
+    glm::vec2 GetButtonCenter(int index) const;
+    static glm::vec2 GetButtonCenter(int columns, float gridLeft, float gridTop, int index);
+
+    // Render side
+    Shader m_Shader;          // Flat shader, used to bake the thumbnails
+    Shader m_ButtonShader;    // Instanced buttons sampling the thumbnail atlas
     Renderer m_Renderer;
-    
-    std::vector<Rectangle*> m_LevelButtons;
-    LevelManager* m_LevelManager;
+
+    // Every visible button is one instance of a unit quad, so the menu is a single draw call
+    std::vector<ButtonInstance> m_VisibleButtons;
+    int m_InstanceCapacity;
+    VertexArray* m_ButtonVAO;
+    IndexBuffer* m_ButtonIBO;
+    ThumbnailAtlas m_Thumbnails;
+    LevelManager* m_LevelManager;   // Thread-safe, shared by both sides
+
+    // Main thread
     Application* m_WindowContext;
-    
+
     int m_SelectedLevel;
     int m_HoveredButton;
-    
+
+    // Grid
+    int m_Columns;
+    float m_GridLeft;         // Center of the first column
+    float m_GridTop;          // Center of the first row
+    float m_VisibleTop;       // Visible world range at scroll offset zero
+    float m_VisibleBottom;
+    int m_FirstVisibleRow;
+    int m_LastVisibleRow;
+    bool m_IsDirty;
+
+    // Kinetic scrolling: how far the grid has moved up, and its speed in world units per second
+    float m_ScrollOffset;
+    float m_PreviousScrollOffset;   // Before the last simulation step, for interpolated rendering
+    float m_ScrollVelocity;
+    float m_MaxScrollOffset;
+
+    // Last cursor position the input reported, in window pixels
+    double m_CursorX;
+    double m_CursorY;
+
+    // Left button drag: scrolls once it moved far enough, and is a click otherwise
+    bool m_IsPressed;
+    bool m_IsDragging;
+    double m_PressX;
+    double m_PressY;
+    double m_LastDragY;
+    double m_LastDragTime;
+
     glm::mat4 m_ViewMatrix;
 };
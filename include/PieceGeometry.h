@@ -0,0 +1,49 @@
+#pragma once
+#include "Lattice.h"
+#include "Level.h"
+#include "TangramPiece.h"
+#include <vector>
+#include <glm/glm.hpp>
+
+// Exact outlines of the seven tangram pieces and conversions between float poses
+// (PiecePosition, centered on the piece) and exact lattice poses (anchored on a lattice point).
+// The anchor is the (x, y) point each piece class builds its vertices around.
+
+// Piece type of each index in the standard set created by GameLayer::InitializePieces
+PieceType GetPieceTypeForIndex(int pieceIndex);
+
+// Outline relative to the anchor, in the same vertex order as the piece class
+const std::vector<LatticePoint>& GetPieceOutline(PieceType type);
+
+// Offset from the anchor to the point the piece rotates around (GetLocalCenter)
+glm::vec2 GetPieceCenterOffset(PieceType type);
+
+// World-space outline of a piece placed at the given pose
+void GetPlacedOutline(PieceType type, const LatticePose& pose, std::vector<LatticePoint>& outVertices);
+
+// True when both poses cover exactly the same area (e.g. a square rotated by 90 degrees)
+bool IsSamePlacement(PieceType type, const LatticePose& a, const LatticePose& b);
+
+// How far a float coordinate, e.g. from a text level file, may be from its lattice value: float
+// rounding plus the digits written, and tight enough that a + b*sqrt(2) rarely has two
+// candidates that close (LatticeScalar::FromFloat rejects those)
+static const float LATTICE_TOLERANCE = 1e-5f;
+
+bool ToLatticePose(PieceType type, const PiecePosition& position, float tolerance, LatticePose& outPose);
+PiecePosition ToPiecePosition(PieceType type, int pieceIndex, const LatticePose& pose);
+
+// Exact signed area of a polygon, doubled (positive for counter-clockwise winding)
+LatticeProduct GetDoubleArea(const std::vector<LatticePoint>& polygon);
+
+// True when p lies on the segment between a and b, excluding the endpoints
+bool IsInsideSegment(const LatticePoint& a, const LatticePoint& b, const LatticePoint& p);
+
+// Crossing-number test for a point known not to lie on the boundary
+bool IsStrictlyInsidePolygon(const std::vector<LatticePoint>& polygon, const LatticePoint& p);
+bool IsOnPolygonBoundary(const std::vector<LatticePoint>& polygon, const LatticePoint& p);
+
+// Separating axis test between convex polygons (a segment counts as one); touching is not overlap
+bool DoInteriorsOverlap(const std::vector<LatticePoint>& a, const std::vector<LatticePoint>& b);
+
+// Direction of to - from in steps of 45 degrees counter-clockwise from +x, -1 otherwise
+int GetLatticeDirection(const LatticePoint& from, const LatticePoint& to);
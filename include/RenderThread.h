@@ -0,0 +1,59 @@
+#pragma once
+#include "CommandList.h"
+#include "Renderer.h"
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+class Application;
+
+// Executes the frames' command lists and presents them.
+//
+// Inline, Submit replays the list and swaps buffers on the calling thread. Threaded, a dedicated
+// thread owns the GL context and replays the lists while the main thread polls input, updates
+// and records the next frame; two lists alternate, so the main thread runs at most one frame
+// ahead and only waits when the render thread falls behind, never on a slow swap of the
+// current frame. GL objects must still be created and destroyed with the context current,
+// which Invoke provides on either side.
+class RenderThread {
+public:
+    RenderThread(Application* window, bool isThreaded);
+    ~RenderThread();
+
+    // Threaded, hands the GL context over to the render thread
+    void Start();
+    // Presents what is still queued and gives the context back to the calling thread
+    void Stop();
+    bool IsThreaded() const { return m_IsThreaded; }
+
+    // Runs work with the GL context current, after every list submitted so far, and waits for it
+    void Invoke(const std::function<void()>& work);
+
+    // List to record the next frame into; still holds the input times and present time of the
+    // frame it carried last, until Reset
+    CommandList& BeginFrame();
+    // Queues the recorded list for presentation, or presents it right away when inline
+    void Submit();
+
+private:
+    void Run();
+    void Present(CommandList& list);
+
+    Application* m_Window;
+    bool m_IsThreaded;
+    bool m_IsRunning;
+    Renderer m_Renderer;
+
+    CommandList m_Lists[2];
+    bool m_IsListBusy[2];           // Submitted and not presented yet
+    int m_RecordIndex;
+    int m_PendingIndex;             // Submitted list the render thread has not picked up, -1 if none
+
+    const std::function<void()>* m_Work;
+    bool m_IsStopping;
+
+    std::thread m_Thread;
+    std::mutex m_Mutex;
+    std::condition_variable m_Condition;
+};
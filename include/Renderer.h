@@ -7,6 +7,7 @@ class Renderer{
 
 public:
 	void Draw(const VertexArray& VertexArray, const IndexBuffer& IndexBuffer, GLenum DrawnMode);
+	void DrawInstanced(const VertexArray& VertexArray, const IndexBuffer& IndexBuffer, GLenum DrawnMode, unsigned int instanceCount);
 	void Unbind(const VertexArray& vertexarray, const IndexBuffer& IndexBuffer, const Shader& shader);
 
 private:
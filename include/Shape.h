@@ -3,6 +3,8 @@
 #include "BufferLayout.h"
 #include "IndexBuffer.h"
 #include "VertexArray.h"
+#include <vector>
+#include <glm/glm.hpp>
 #include <glm/ext/matrix_float4x4.hpp>
 
 class VertexArray;
@@ -26,6 +28,7 @@ public:
 	
 	virtual bool IsInside(float ndcX, float ndcY) const = 0;
 	virtual void SetColor(float r, float g, float b) = 0;
+	virtual glm::vec3 GetColor() const = 0;
 
 	//u_Model Matrix
 	
@@ -38,5 +41,8 @@ public:
 	virtual float GetArea() const = 0;
 	virtual float GetPerimeter() const = 0;
 
+	//Outline in local space (before u_Model), vertices in boundary order
+	virtual void GetOutline(std::vector<glm::vec2>& outVertices) const = 0;
+
 
 };
@@ -0,0 +1,132 @@
+#pragma once
+#include "Circle.h"
+#include "Polygon.h"
+#include "Rectangle.h"
+#include "Shape.h"
+#include "Triangle.h"
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Fixed-size object pool for one shape type. Objects live in chunks that never move,
+// so pointers stay valid until the object is destroyed, and freed slots are reused first.
+template <typename T>
+class ShapePool {
+public:
+    ShapePool() : m_FreeList(nullptr), m_NextInChunk(SLOTS_PER_CHUNK) {}
+    ShapePool(const ShapePool&) = delete;
+    ShapePool& operator=(const ShapePool&) = delete;
+
+    template <typename... Args>
+    T* Create(Args&&... args) {
+        Slot* slot = m_FreeList;
+        if (slot != nullptr) {
+            m_FreeList = slot->next;
+        } else {
+            if (m_NextInChunk == SLOTS_PER_CHUNK) {
+                m_Chunks.emplace_back(new Slot[SLOTS_PER_CHUNK]);
+                m_NextInChunk = 0;
+            }
+            slot = &m_Chunks.back()[m_NextInChunk++];
+        }
+        return new (slot->storage) T(std::forward<Args>(args)...);
+    }
+
+    void Destroy(T* object) {
+        object->~T();
+        Slot* slot = reinterpret_cast<Slot*>(object);
+        slot->next = m_FreeList;
+        m_FreeList = slot;
+    }
+
+private:
+    static const int SLOTS_PER_CHUNK = 256;
+
+    union Slot {
+        Slot* next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    std::vector<std::unique_ptr<Slot[]>> m_Chunks;
+    Slot* m_FreeList;
+    int m_NextInChunk;
+};
+
+// Stable reference to a shape in a ShapeArena. The generation makes handles to destroyed
+// shapes invalid even after their slot is reused
+struct ShapeHandle {
+    uint32_t index;
+    uint32_t generation;
+
+    ShapeHandle() : index(UINT32_MAX), generation(0) {}
+    ShapeHandle(uint32_t slotIndex, uint32_t slotGeneration) : index(slotIndex), generation(slotGeneration) {}
+
+    bool operator==(const ShapeHandle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const ShapeHandle& other) const { return !(*this == other); }
+};
+
+// Owns the editor shapes: per-type pools for the objects and a dense list of live shapes
+// in drawing order. Destroy() and Hide() are O(1); they move the last shape into the freed position.
+class ShapeArena {
+public:
+    ShapeArena();
+    ~ShapeArena();
+    ShapeArena(const ShapeArena&) = delete;
+    ShapeArena& operator=(const ShapeArena&) = delete;
+
+    ShapeHandle CreateRectangle(float x1, float y1, float x2, float y2, bool isFilled);
+    ShapeHandle CreateTriangle(float x1, float y1, float x2, float y2, bool isFilled);
+    ShapeHandle CreateCircle(float x1, float y1, float x2, float y2, bool isFilled);
+    ShapeHandle CreatePolygon(float x1, float y1, bool isFilled);
+
+    void Destroy(ShapeHandle handle);
+    void Clear();
+
+    // Takes a shape out of the drawing order without destroying it, so a deletion can be undone;
+    // the handle stays valid. Show() appends it again at the top
+    void Hide(ShapeHandle handle);
+    void Show(ShapeHandle handle);
+    bool IsHidden(ShapeHandle handle) const;
+
+    // nullptr when the handle is stale
+    Shape* Get(ShapeHandle handle) const;
+    bool IsValid(ShapeHandle handle) const { return Get(handle) != nullptr; }
+
+    // Live shapes in drawing order
+    size_t GetCount() const { return m_Live.size(); }
+    Shape* GetShape(size_t position) const { return m_Live[position]; }
+    ShapeHandle GetHandle(size_t position) const;
+    const std::vector<Shape*>& GetShapes() const { return m_Live; }
+
+private:
+    enum class ShapeKind : uint8_t {
+        RECTANGLE,
+        TRIANGLE,
+        CIRCLE,
+        POLYGON
+    };
+
+    struct HandleSlot {
+        Shape* shape;
+        uint32_t generation;
+        uint32_t livePosition;    // Index into m_Live while shown, next free slot once destroyed
+        ShapeKind kind;
+        bool isHidden;
+    };
+
+    ShapeHandle Register(Shape* shape, ShapeKind kind);
+    void RemoveFromLive(HandleSlot& slot);
+
+    ShapePool<Rectangle> m_Rectangles;
+    ShapePool<Triangle> m_Triangles;
+    ShapePool<Circle> m_Circles;
+    ShapePool<Polygon> m_Polygons;
+
+    std::vector<HandleSlot> m_Slots;
+    uint32_t m_FreeSlot;
+
+    std::vector<Shape*> m_Live;
+    std::vector<uint32_t> m_LiveSlots;   // Handle slot of each live shape, same order as m_Live
+};
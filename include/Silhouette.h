@@ -0,0 +1,29 @@
+#pragma once
+#include "Lattice.h"
+#include <cstdint>
+#include <vector>
+
+// Outline of an arrangement of non-overlapping pieces, traced exactly on the lattice.
+//
+// Piece edges are split wherever another piece's vertex lies on them; a segment shared by two
+// pieces then appears once in each direction and cancels out, and what remains is the
+// boundary of the union. It is chained into closed contours taking the sharpest left turn at
+// every vertex, so shapes touching at a single point come out as separate contours.
+// Outer contours are counter-clockwise, holes clockwise, with collinear vertices removed.
+// Fails when two pieces overlap along an edge in the same direction.
+bool TraceSilhouette(const std::vector<std::vector<LatticePoint>>& pieces,
+                     std::vector<std::vector<LatticePoint>>& outContours);
+
+// Union of a piece arrangement as one outer contour (counter-clockwise) and its holes
+// (clockwise). Fails when pieces overlap or the union falls apart into several shapes
+bool UnitePieces(const std::vector<std::vector<LatticePoint>>& pieces,
+                 std::vector<LatticePoint>& outOuter,
+                 std::vector<std::vector<LatticePoint>>& outHoles);
+
+// Same contour up to translation, 45 degree rotation and reflection gives the same result:
+// the lexicographically smallest of the 16 transformed copies, moved so its smallest vertex
+// is at the origin and listed counter-clockwise from there
+std::vector<LatticePoint> GetCanonicalContour(const std::vector<LatticePoint>& contour);
+
+// FNV-1a hash of a canonical contour, for bucketing before the exact comparison
+uint64_t HashCanonicalContour(const std::vector<LatticePoint>& canonical);
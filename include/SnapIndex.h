@@ -0,0 +1,62 @@
+#pragma once
+#include "Level.h"
+#include "BoardState.h"
+#include "TangramPiece.h"
+#include <vector>
+#include <glm/glm.hpp>
+
+// Symmetry of a piece shape, used to find the equivalent pose closest to the player's one
+struct PieceSymmetry {
+    float rotationPeriod;     // Smallest rotation (radians) that maps the piece onto itself
+    bool isMirrorSymmetric;   // Whether a flipped piece can be matched by rotation alone
+    float mirrorRotation;     // Rotation that makes a flipped piece match the unflipped one
+};
+
+PieceSymmetry GetPieceSymmetry(PieceType type);
+
+// A target position from the level solution that any piece of the same type can fill
+struct SnapSlot {
+    int targetPieceIndex;     // Piece the solution originally assigned to this slot
+    PieceType type;
+    glm::vec2 position;
+    float rotation;
+    bool isFlipped;
+    int occupant;             // Index of the piece locked in the slot, -1 when free
+};
+
+class SnapIndex {
+public:
+    SnapIndex();
+
+    // Groups the solution targets by piece type and builds one k-d tree per type
+    void Build(const std::vector<PiecePosition>& solution, const BoardState& board);
+
+    // Nearest free slot compatible with the type within maxDistance, -1 if there is none
+    int FindNearestFreeSlot(PieceType type, const glm::vec2& position, float maxDistance) const;
+
+    // Rotation equivalent to the slot's one for a piece with the given flip state,
+    // chosen as close as possible to currentRotation
+    bool GetEquivalentRotation(int slotIndex, bool pieceFlipped, float currentRotation, float& outRotation) const;
+
+    void Occupy(int slotIndex, int pieceIndex);
+    void ClearOccupancy();
+
+    const std::vector<SnapSlot>& GetSlots() const { return m_Slots; }
+
+private:
+    static const int PIECE_TYPE_COUNT = 5;
+
+    struct KdNode {
+        int slot;
+        int axis;
+        int left;
+        int right;
+    };
+
+    int BuildTree(std::vector<int>& slots, int begin, int end, int depth);
+    void SearchTree(int node, const glm::vec2& position, int& bestSlot, float& bestDistanceSq) const;
+
+    std::vector<SnapSlot> m_Slots;
+    std::vector<KdNode> m_Nodes;
+    int m_Roots[PIECE_TYPE_COUNT];
+};
@@ -31,6 +31,24 @@ public:
     // Get raw vertices
     virtual const std::vector<float>& GetVertices() const = 0;
     
+    // Piece vertices are already stored in boundary order
+    void GetOutline(std::vector<glm::vec2>& outVertices) const override {
+        const std::vector<float>& vertices = GetVertices();
+        outVertices.clear();
+        for (size_t i = 0; i + 1 < vertices.size(); i += 6) {
+            outVertices.push_back(glm::vec2(vertices[i], vertices[i + 1]));
+        }
+    }
+    
+    // Every vertex carries the piece color
+    glm::vec3 GetColor() const override {
+        const std::vector<float>& vertices = GetVertices();
+        if (vertices.size() < 6) {
+            return glm::vec3(1.0f, 1.0f, 1.0f);
+        }
+        return glm::vec3(vertices[2], vertices[3], vertices[4]);
+    }
+    
     // Lock/unlock piece (when correctly placed)
     void SetLocked(bool locked) { m_IsLocked = locked; }
     bool IsLocked() const { return m_IsLocked; }
@@ -39,6 +57,18 @@ public:
     // Get current rotation angle in radians
     virtual float GetRotation() const = 0;
     
+    // Place the piece at an absolute pose, using the same convention as PiecePosition:
+    // rotation and flip are applied around the piece center, then the center is moved to position
+    void SetPose(const glm::vec2& position, float rotation, bool flipped) {
+        ResetToOriginal();
+        Rotate(rotation);
+        if (flipped) {
+            Flip();
+        }
+        glm::vec2 center = GetCenter();
+        Translate(position.x - center.x, position.y - center.y);
+    }
+    
 protected:
     bool m_IsLocked = false;
     bool m_IsFlipped = false;
@@ -0,0 +1,92 @@
+#pragma once
+#include "Lattice.h"
+#include "Level.h"
+#include "TangramPiece.h"
+#include "ThreadPool.h"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+struct SolverResult {
+    bool isSolved = false;
+    std::vector<PiecePosition> solution;   // Standard piece order, ready for a Level
+    std::vector<LatticePose> poses;        // Exact poses, same order as solution
+    uint64_t nodesVisited = 0;
+};
+
+// Exact placement of one piece
+struct LatticePlacement {
+    PieceType type;
+    LatticePose pose;
+};
+
+enum class SearchStatus {
+    RUNNING,
+    SOLVED,
+    FAILED
+};
+
+// Exact backtracking solver for simple silhouettes on the tangram lattice.
+//
+// Every vertex of the region still to cover is a silhouette or piece vertex, and all edges
+// run at multiples of 45 degrees, so each such point is split into eight 45 degree sectors.
+// The search always fills the free corner with the fewest sectors: a corner narrower than
+// 180 degrees can only be covered by a piece with a vertex there and one edge flush with the
+// corner's side, which leaves a handful of candidates per step (edge-match pruning). Pieces
+// must lie inside the silhouette and not overlap; with the silhouette area checked to be 4
+// up front, that also guarantees there are no gaps once all seven pieces are down.
+class TangramSolver {
+public:
+    explicit TangramSolver(ThreadPool& pool);
+
+    // Splits the top of the search tree across the pool and returns the first solution found
+    SolverResult Solve(const std::vector<LatticePoint>& silhouette) const;
+
+    // One sequential search per silhouette, run across the pool; results in input order
+    std::vector<SolverResult> SolveBatch(const std::vector<std::vector<LatticePoint>>& silhouettes) const;
+
+    static SolverResult SolveSequential(const std::vector<LatticePoint>& silhouette);
+
+private:
+    ThreadPool& m_Pool;
+};
+
+// The sequential search kept on an explicit stack, so it can stop when its time budget runs out
+// and resume there on the next call; meant for searches spread over frames.
+//
+// Fixed pieces are already in place and never moved. At every step, candidates that match one
+// of the preferred placements are tried before the others, so a search steered towards a known
+// solution reaches it without backtracking, yet still finds any other completion
+class IncrementalSolver {
+public:
+    IncrementalSolver();
+    ~IncrementalSolver();
+
+    IncrementalSolver(const IncrementalSolver&) = delete;
+    IncrementalSolver& operator=(const IncrementalSolver&) = delete;
+
+    // Cheap: all search work happens in Step. Fails when the silhouette cannot be tiled by one
+    // tangram set or the fixed pieces use more pieces of a type than the set has
+    bool Start(const std::vector<LatticePoint>& silhouette,
+               const std::vector<LatticePlacement>& fixed,
+               const std::vector<LatticePlacement>& preferred);
+
+    // Searches until solved, exhausted or budget has elapsed; checked after every node
+    SearchStatus Step(std::chrono::steady_clock::duration budget);
+
+    SearchStatus GetStatus() const { return m_Status; }
+
+    // Pieces placed by the search so far, in the order they were placed (fixed ones excluded);
+    // once SOLVED, they complete the silhouette
+    std::vector<LatticePlacement> GetPlacements() const;
+
+    uint64_t GetNodesVisited() const { return m_NodesVisited; }
+
+private:
+    struct Search;
+
+    std::unique_ptr<Search> m_Search;
+    SearchStatus m_Status;
+    uint64_t m_NodesVisited;
+};
@@ -0,0 +1,49 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing thread pool. Every worker owns a deque: it pushes and pops its own tasks
+// at the back (depth first, cache friendly) and steals from the front of other workers'
+// deques when it runs dry. Tasks submitted from outside the pool are spread round-robin.
+class ThreadPool {
+public:
+    // threadCount 0 uses every hardware thread
+    explicit ThreadPool(unsigned threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void Submit(std::function<void()> task);
+
+    // Block until counter reaches zero, running queued tasks meanwhile so that waiting
+    // from inside a task cannot deadlock the pool
+    void WaitFor(const std::atomic<int>& counter);
+
+    unsigned GetThreadCount() const { return m_Threads.size(); }
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void WorkerLoop(unsigned index);
+    bool PopTask(int preferredQueue, std::function<void()>& outTask);
+    int GetCurrentWorker() const;
+
+    std::vector<std::unique_ptr<WorkerQueue>> m_Queues;
+    std::vector<std::thread> m_Threads;
+
+    std::mutex m_WakeMutex;
+    std::condition_variable m_WakeCondition;
+    std::atomic<int> m_QueuedTasks;
+    std::atomic<unsigned> m_NextQueue;
+    bool m_IsStopping;
+};
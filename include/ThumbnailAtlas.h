@@ -0,0 +1,96 @@
+#pragma once
+#include "LevelManager.h"
+#include "Shader.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+
+// Level silhouettes pre-rendered into a single-channel texture of fixed-size slots.
+//
+// Only levels requested recently are resident: a request for a level without a slot takes
+// the least recently used one that was not requested this frame, so the texture size does
+// not depend on the number of levels. Slots are filled from the disk cache when possible;
+// the rest are baked together in one offscreen pass: every contour is drawn as a triangle
+// fan that inverts the stencil, which leaves exactly the inside of the silhouette (holes
+// excluded) odd, and a quad over each slot then fills its odd pixels. Baked cells are
+// appended to the cache, keyed by LevelManager::GetLevelHash, so later launches neither
+// decode nor draw them. Bump THUMBNAIL_CACHE_VERSION when the silhouette derivation changes.
+class ThumbnailAtlas {
+public:
+    ThumbnailAtlas(int cellWidth, int cellHeight, int slotCount);
+    ~ThumbnailAtlas();
+
+    ThumbnailAtlas(const ThumbnailAtlas&) = delete;
+    ThumbnailAtlas& operator=(const ThumbnailAtlas&) = delete;
+
+    // Needs a current GL context. shader is the flat position and color shader, used for
+    // baking; an empty cachePath disables the disk cache. Only indexes the cache file
+    void Open(LevelManager* levelManager, Shader* shader, const std::string& cachePath);
+
+    // Per frame: BeginFrame, Request every level on screen, then Update fills the slots
+    void BeginFrame() { ++m_Frame; }
+    void Request(int index);
+    // Returns true when new thumbnails became resident
+    bool Update();
+
+    void Bind(unsigned int slot) const;
+
+    // Texture coordinates (u0, v0, u1, v1) of a resident level's slot; an empty spot for
+    // levels that are not resident (yet)
+    glm::vec4 GetCellUV(int index) const;
+
+    int GetSlotCount() const { return m_SlotCount; }
+    int GetCachedCount() const { return m_CachedCount; }
+    int GetBakedCount() const { return m_BakedCount; }
+
+private:
+    struct BakeJob {
+        int slot;
+        uint64_t hash;
+        std::shared_ptr<Level> level;
+    };
+
+    glm::ivec2 GetSlotOrigin(int slot) const;
+    int AcquireSlot(int index);
+
+    // Renders the jobs into their slots and appends their pixels to the cache
+    void Bake(const std::vector<BakeJob>& jobs);
+    void AppendSilhouette(const Level& level, int slot, std::vector<float>& vertices) const;
+    void ReleaseFramebuffer();
+
+    void OpenCache(const std::string& path);
+    void CloseCache();
+    bool ReadCell(uint64_t hash, std::vector<uint8_t>& outPixels) const;
+    void AppendCell(uint64_t hash, const std::vector<uint8_t>& pixels);
+
+    int m_CellWidth;
+    int m_CellHeight;
+    int m_SlotCount;
+    int m_Columns;
+    int m_Rows;
+    unsigned int m_TextureID;
+    unsigned int m_Framebuffer;     // Renders into the texture, with a stencil for the fill
+    unsigned int m_StencilBuffer;
+
+    LevelManager* m_LevelManager;
+    Shader* m_Shader;
+    bool m_CanBake;                 // Cleared when the offscreen framebuffer is unsupported
+
+    // Residency: level in every slot (-1 when free), when it was last requested, and back
+    std::vector<int> m_SlotLevels;
+    std::vector<uint64_t> m_SlotLastUsed;
+    std::unordered_map<int, int> m_LevelSlots;
+    std::vector<int> m_Pending;     // Levels requested this frame without a slot
+    uint64_t m_Frame;
+
+    // Disk cache: append-only records, indexed by hash when opened
+    int m_CacheFile;
+    uint64_t m_CacheSize;
+    std::unordered_map<uint64_t, uint64_t> m_CacheIndex;    // Hash to pixel offset
+
+    int m_CachedCount;
+    int m_BakedCount;
+};
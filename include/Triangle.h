@@ -4,6 +4,7 @@
 #include "IndexBuffer.h"
 #include "VertexArray.h"
 #include "Shape.h"
+#include "VertexArena.h"
 
 class Triangle : public Shape{
 
@@ -21,6 +22,7 @@ public:
 	void FinalizeShape();
 
 	void SetColor(float r, float g, float b);
+	glm::vec3 GetColor() const;
     bool IsInside(float ndcX, float ndcY) const;
 
     const glm::mat4& GetModelMatrix() const;
@@ -29,11 +31,12 @@ public:
 	void Scale(float sx, float sy);
 	float GetArea() const;
 	float GetPerimeter() const;
+	void GetOutline(std::vector<glm::vec2>& outVertices) const;
 
 private:
 
-    std::vector<float> m_Vertices;
-    std::vector<unsigned int> m_Indices;
+    ArenaVector<float> m_Vertices;
+    ArenaVector<unsigned int> m_Indices;
 
     BufferLayout m_BufferLayout;
 
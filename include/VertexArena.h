@@ -0,0 +1,68 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Shared chunked arena for shape vertex and index data.
+// Blocks are rounded up to power-of-two size classes carved from 1 MiB chunks, and freed
+// blocks go to a per-class free list, so creating and deleting many shapes reuses the same
+// memory instead of fragmenting the heap. Chunks are only released with the arena.
+// Not thread safe: shapes are created and edited on the main thread.
+class VertexArena {
+public:
+    static VertexArena& Get();
+
+    void* Allocate(size_t bytes);
+    void Deallocate(void* block, size_t bytes);
+
+    size_t GetChunkCount() const { return m_Chunks.size(); }
+
+private:
+    VertexArena();
+    VertexArena(const VertexArena&) = delete;
+    VertexArena& operator=(const VertexArena&) = delete;
+
+    static const size_t CHUNK_SIZE = 1 << 20;
+    static const size_t MIN_BLOCK_SHIFT = 4;    // 16 bytes, keeps every block 16-byte aligned
+    static const int CLASS_COUNT = 17;          // 16 bytes up to CHUNK_SIZE
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    static int GetSizeClass(size_t bytes);
+    static size_t GetClassSize(int sizeClass) { return (size_t)1 << (sizeClass + MIN_BLOCK_SHIFT); }
+
+    void AddChunk();
+
+    std::vector<std::unique_ptr<unsigned char[]>> m_Chunks;
+    unsigned char* m_Cursor;
+    size_t m_Remaining;
+    FreeBlock* m_FreeLists[CLASS_COUNT];
+};
+
+// Standard allocator over the shared arena, so shapes keep using std::vector
+template <typename T>
+struct ArenaAllocator {
+    using value_type = T;
+
+    ArenaAllocator() {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>&) {}
+
+    T* allocate(size_t count) {
+        return static_cast<T*>(VertexArena::Get().Allocate(count * sizeof(T)));
+    }
+
+    void deallocate(T* block, size_t count) {
+        VertexArena::Get().Deallocate(block, count * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>&) const { return true; }
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>&) const { return false; }
+};
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
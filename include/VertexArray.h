@@ -13,10 +13,16 @@ public:
 	void Unbind() const;
 	void SetData(const void* data, unsigned int size, const BufferLayout* layout);
 
+	//Per-instance attributes in a second buffer, numbered after the SetData ones
+	void SetInstanceData(const void* data, unsigned int size, const BufferLayout* layout);
+	void UpdateInstanceData(unsigned int offset, const void* data, unsigned int size);
+
 
 private:
 
 	unsigned int m_VAOID;
 	unsigned int m_VBOID;
+	unsigned int m_InstanceVBOID;
+	unsigned int m_AttributeCount;
 
 };
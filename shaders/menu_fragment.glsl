@@ -0,0 +1,18 @@
+#version 330 core
+out vec4 FragColor;
+in vec2 UV;
+in vec4 Color;
+flat in int HasThumbnail;
+
+uniform sampler2D u_Atlas;   // Silhouette coverage in the red channel
+uniform vec4 u_ShapeColor;
+
+void main()
+{
+   if (HasThumbnail == 0) {
+      FragColor = Color;
+      return;
+   }
+   float coverage = texture(u_Atlas, UV).r;
+   FragColor = mix(Color, u_ShapeColor, coverage);
+}
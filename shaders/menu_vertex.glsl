@@ -0,0 +1,20 @@
+#version 330 core
+layout (location = 0) in vec2 aCorner;   // Unit quad corner, (0,0) to (1,1)
+layout (location = 1) in vec4 aRect;     // Per button: min x, min y, max x, max y in world space
+layout (location = 2) in vec4 aUV;       // Per button: thumbnail cell in the atlas
+layout (location = 3) in vec4 aColor;    // Per button: background color
+
+out vec2 UV;
+out vec4 Color;
+flat out int HasThumbnail;   // Not resident yet: an empty cell in aUV
+
+uniform mat4 u_View;       // Camera Matrix (Pan, Zoom)
+uniform mat4 u_Projection; // Projection Matrix (2D World)
+
+void main(){
+
+	gl_Position = u_Projection * u_View * vec4(mix(aRect.xy, aRect.zw, aCorner), 0.0, 1.0);
+	UV = mix(aUV.xy, aUV.zw, aCorner);
+	Color = aColor;
+	HasThumbnail = aUV.z > aUV.x ? 1 : 0;
+}
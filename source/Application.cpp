@@ -1,11 +1,12 @@
 #include "Application.h"
+#include "GLRecorder.h"
 #include <cstdlib>
 #include <glm/ext/matrix_clip_space.hpp>
 #include <iostream>
 #include <glad.h>
 #include <GLFW/glfw3.h>
 
-Application::Application(int windowWidth, int windowHeight, const char* title) :m_Width(windowWidth), m_Height(windowHeight), m_Title(title){
+Application::Application(int windowWidth, int windowHeight, const char* title) :m_Window(nullptr), m_Width(windowWidth), m_Height(windowHeight), m_WindowWidth(windowWidth), m_WindowHeight(windowHeight), m_Title(title), m_IsVSync(true), m_IsVisible(true){
 }
 
 Application::~Application(){
@@ -24,6 +25,7 @@ void Application::CreateGLFWWindow(){
 	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
 	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
 	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+	glfwWindowHint(GLFW_VISIBLE, m_IsVisible ? GLFW_TRUE : GLFW_FALSE);
 
 	//Compatibility special for you Rodack <3
 	#ifdef __APPLE__
@@ -37,9 +39,12 @@ void Application::CreateGLFWWindow(){
 	}
 
 	glfwMakeContextCurrent(m_Window);
+	glfwSwapInterval(m_IsVSync ? 1 : 0);
 	
 	// Update width and height to match actual window size (important for tiling WMs)
 	glfwGetWindowSize(m_Window, &m_Width, &m_Height);
+	m_WindowWidth = m_Width;
+	m_WindowHeight = m_Height;
 }
 
 void Application::InitGLAD(){
@@ -57,6 +62,19 @@ void Application::MainLoop(){
 	}
 }
 
+void Application::SetVSync(bool enabled){
+	glfwSwapInterval(enabled ? 1 : 0);
+	m_IsVSync = enabled;
+}
+
+double Application::GetRefreshInterval() const{
+	const GLFWvidmode* mode = glfwGetVideoMode(glfwGetPrimaryMonitor());
+	if(mode == NULL || mode->refreshRate <= 0){
+		return 1.0 / 60.0;
+	}
+	return 1.0 / mode->refreshRate;
+}
+
 GLFWwindow* Application::GetWindow(){
 	return m_Window;
 }
@@ -96,11 +114,15 @@ void Application::Run(){
 	SetupGL();
 }
 
+void Application::RunNull(){
+	GLRecorder::InstallNull();
+	SetupGL();
+}
+
 void Application::OnResize(int width, int height) {
 	m_Width = width;
 	m_Height = height;
-	
-	glViewport(0, 0, m_Width, m_Height);
+	// The viewport follows on the next command list, wherever the context is current
 	
 	float aspectRatio = (float)m_Width / (float)m_Height;
     float worldHeight = 10.0f; 
@@ -113,3 +135,8 @@ void Application::OnResize(int width, int height) {
 
     m_ProjectionMatrix = glm::ortho(left, right, bottom, top, -1.0f, 1.0f);
 }
+
+void Application::OnWindowResize(int width, int height){
+	m_WindowWidth = width;
+	m_WindowHeight = height;
+}
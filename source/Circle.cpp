@@ -111,6 +111,14 @@ void Circle::SetColor(float r, float g, float b){
 	m_VertexArray->SetData(m_Vertices.data(), m_Vertices.size()*sizeof(float) , &m_BufferLayout);
 }
 
+glm::vec3 Circle::GetColor() const{
+	//Every vertex carries the same color
+	if (m_Vertices.size() < 6){
+		return glm::vec3(1.0f, 1.0f, 1.0f);
+	}
+	return glm::vec3(m_Vertices[2], m_Vertices[3], m_Vertices[4]);
+}
+
 bool Circle::IsInside(float ndcX, float ndcY) const{
 
 	return (sqrt((m_AnchorX - ndcX)*(m_AnchorX - ndcX) + (m_AnchorY - ndcY)*(m_AnchorY - ndcY)) <= m_Radius);
@@ -174,3 +182,11 @@ Circle::~Circle(){
 void Circle::AddPoint(double x, double y){}
 
 void Circle::FinalizeShape(){}
+
+void Circle::GetOutline(std::vector<glm::vec2>& outVertices) const {
+    outVertices.clear();
+    //Vertex 0 is the center, the rim starts at vertex 1
+    for (size_t i = 6; i < m_Vertices.size(); i += 6) {
+        outVertices.push_back(glm::vec2(m_Vertices[i], m_Vertices[i + 1]));
+    }
+}
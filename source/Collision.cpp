@@ -0,0 +1,99 @@
+#include "Collision.h"
+#include <algorithm>
+#include <cfloat>
+
+// Pieces sharing an edge touch without overlapping; ignore penetration below this depth
+static const float CONTACT_EPSILON = 0.002f;
+
+CollisionShape::CollisionShape()
+    : m_Min(0.0f, 0.0f)
+    , m_Max(0.0f, 0.0f) {
+}
+
+void CollisionShape::Update(const TangramPiece& piece) {
+    const std::vector<float>& vertices = piece.GetVertices();
+    const glm::mat4& model = piece.GetModelMatrix();
+
+    m_Vertices.clear();
+    m_Axes.clear();
+
+    // Vertices are interleaved as x, y, r, g, b, a
+    for (size_t i = 0; i + 1 < vertices.size(); i += 6) {
+        glm::vec4 world = model * glm::vec4(vertices[i], vertices[i + 1], 0.0f, 1.0f);
+        m_Vertices.push_back(glm::vec2(world.x, world.y));
+    }
+
+    size_t count = m_Vertices.size();
+    if (count == 0) {
+        return;
+    }
+
+    m_Min = m_Max = m_Vertices[0];
+    for (size_t i = 0; i < count; ++i) {
+        const glm::vec2& current = m_Vertices[i];
+        const glm::vec2& next = m_Vertices[(i + 1) % count];
+
+        m_Min = glm::min(m_Min, current);
+        m_Max = glm::max(m_Max, current);
+
+        glm::vec2 edge = next - current;
+        float length = glm::length(edge);
+        if (length > 0.0f) {
+            m_Axes.push_back(glm::vec2(-edge.y, edge.x) / length);
+        }
+    }
+}
+
+void CollisionShape::Translate(const glm::vec2& delta) {
+    for (glm::vec2& vertex : m_Vertices) {
+        vertex += delta;
+    }
+    m_Min += delta;
+    m_Max += delta;
+}
+
+bool CollisionShape::BoundsOverlap(const CollisionShape& other) const {
+    return m_Min.x < other.m_Max.x && other.m_Min.x < m_Max.x &&
+           m_Min.y < other.m_Max.y && other.m_Min.y < m_Max.y;
+}
+
+void CollisionShape::Project(const glm::vec2& axis, float& outMin, float& outMax) const {
+    outMin = FLT_MAX;
+    outMax = -FLT_MAX;
+    for (const glm::vec2& vertex : m_Vertices) {
+        float projection = glm::dot(vertex, axis);
+        outMin = std::min(outMin, projection);
+        outMax = std::max(outMax, projection);
+    }
+}
+
+bool CollisionShape::Overlaps(const CollisionShape& other, glm::vec2& outPush) const {
+    float smallestOverlap = FLT_MAX;
+    glm::vec2 smallestAxis(0.0f, 0.0f);
+
+    // Convex shapes are disjoint if any edge normal of either one separates them
+    const std::vector<glm::vec2>* axisSets[2] = {&m_Axes, &other.m_Axes};
+    for (const std::vector<glm::vec2>* axes : axisSets) {
+        for (const glm::vec2& axis : *axes) {
+            float minA, maxA, minB, maxB;
+            Project(axis, minA, maxA);
+            other.Project(axis, minB, maxB);
+
+            float overlap = std::min(maxA - minB, maxB - minA);
+            if (overlap <= CONTACT_EPSILON) {
+                return false;
+            }
+
+            if (overlap < smallestOverlap) {
+                smallestOverlap = overlap;
+                // Push this shape away from the other one along the axis
+                float centerA = (minA + maxA) * 0.5f;
+                float centerB = (minB + maxB) * 0.5f;
+                smallestAxis = (centerA < centerB) ? -axis : axis;
+            }
+        }
+    }
+
+    outPush = smallestAxis * smallestOverlap;
+    return true;
+}
@@ -0,0 +1,72 @@
+#include "CommandList.h"
+#include <glad.h>
+
+CommandList::CommandList()
+    : m_Width(0)
+    , m_Height(0)
+    , m_PresentTime(0.0) {
+}
+
+void CommandList::Reset(int width, int height) {
+    // clear() keeps the capacity, so recording stops allocating once the lists have grown
+    m_Commands.clear();
+    m_Cameras.clear();
+    m_Packets.clear();
+    m_Tasks.clear();
+    m_InputTimes.clear();
+    m_Width = width;
+    m_Height = height;
+    m_PresentTime = 0.0;
+}
+
+void CommandList::SetCamera(Shader* shader, const glm::mat4& projection, const glm::mat4& view) {
+    m_Commands.push_back({CommandType::CAMERA, m_Cameras.size()});
+    m_Cameras.push_back({shader, projection, view});
+}
+
+void CommandList::Draw(const DrawPacket& packet) {
+    m_Commands.push_back({CommandType::DRAW, m_Packets.size()});
+    m_Packets.push_back(packet);
+}
+
+void CommandList::AddTask(std::function<void()> task) {
+    m_Commands.push_back({CommandType::TASK, m_Tasks.size()});
+    m_Tasks.push_back(std::move(task));
+}
+
+void CommandList::Execute(Renderer& renderer) {
+    glViewport(0, 0, m_Width, m_Height);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    Shader* shader = nullptr;
+    for (const Command& command : m_Commands) {
+        switch (command.type) {
+            case CommandType::CAMERA: {
+                const Camera& camera = m_Cameras[command.index];
+                shader = camera.shader;
+                shader->Bind();
+                shader->SetUniformMat4f("u_Projection", camera.projection);
+                shader->SetUniformMat4f("u_View", camera.view);
+                break;
+            }
+            case CommandType::DRAW: {
+                const DrawPacket& packet = m_Packets[command.index];
+                if (shader == nullptr) {
+                    break;
+                }
+                shader->SetUniformMat4f("u_Model", packet.model);
+                shader->SetUniform1i("u_UseUniformColor", packet.useUniformColor ? 1 : 0);
+                if (packet.useUniformColor) {
+                    shader->SetUniform4f("u_Color", packet.color.x, packet.color.y, packet.color.z, packet.color.w);
+                }
+                renderer.Draw(*packet.mesh, *packet.indices, packet.mode);
+                break;
+            }
+            case CommandType::TASK:
+                // Tasks bind their own state, so the next draw needs a camera again
+                m_Tasks[command.index]();
+                shader = nullptr;
+                break;
+        }
+    }
+}
@@ -0,0 +1,77 @@
+#include "FrameStats.h"
+#include <algorithm>
+#include <cmath>
+
+// Frames this much longer than the target interval missed a refresh
+static const double LATE_FRAME_FACTOR = 1.5;
+
+SampleWindow::SampleWindow(size_t size)
+    : m_Samples(std::max<size_t>(size, 1), 0.0)
+    , m_Next(0)
+    , m_Count(0) {
+}
+
+void SampleWindow::Add(double value) {
+    m_Samples[m_Next] = value;
+    m_Next = (m_Next + 1) % m_Samples.size();
+    m_Count = std::min(m_Count + 1, m_Samples.size());
+}
+
+double SampleWindow::GetPercentile(double percentile) const {
+    if (m_Count == 0) {
+        return 0.0;
+    }
+
+    // Nearest rank; nth_element keeps the query linear in the window size
+    std::vector<double> samples(m_Samples.begin(), m_Samples.begin() + m_Count);
+    double rank = std::ceil(std::min(std::max(percentile, 0.0), 100.0) / 100.0 * m_Count);
+    size_t index = std::max<size_t>((size_t)rank, 1) - 1;
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return samples[index];
+}
+
+double SampleWindow::GetAverage() const {
+    if (m_Count == 0) {
+        return 0.0;
+    }
+    double total = 0.0;
+    for (size_t i = 0; i < m_Count; ++i) {
+        total += m_Samples[i];
+    }
+    return total / m_Count;
+}
+
+FrameStats::FrameStats(size_t windowSize)
+    : m_FrameTimes(windowSize)
+    , m_InputLatencies(windowSize)
+    , m_TargetInterval(0.0)
+    , m_FrameCount(0)
+    , m_LateFrameCount(0)
+    , m_SkippedStepCount(0) {
+}
+
+void FrameStats::AddFrame(double seconds) {
+    m_FrameTimes.Add(seconds);
+
+    ++m_FrameCount;
+    if (m_TargetInterval > 0.0 && seconds > m_TargetInterval * LATE_FRAME_FACTOR) {
+        ++m_LateFrameCount;
+    }
+}
+
+void FrameStats::Print(std::ostream& out) const {
+    double average = GetAverageFrameTime();
+    out << "Frames: " << m_FrameCount << ", last " << m_FrameTimes.GetCount() << " at "
+        << (average > 0.0 ? 1.0 / average : 0.0) << " fps" << std::endl;
+    out << "Frame time p50 " << GetPercentile(50.0) * 1000.0 << " ms, p95 " << GetPercentile(95.0) * 1000.0
+        << " ms, p99 " << GetPercentile(99.0) * 1000.0 << " ms" << std::endl;
+    if (m_TargetInterval > 0.0) {
+        out << "Late frames (over " << m_TargetInterval * LATE_FRAME_FACTOR * 1000.0 << " ms): " << m_LateFrameCount << std::endl;
+    }
+    out << "Skipped simulation steps: " << m_SkippedStepCount << std::endl;
+    if (m_InputLatencies.GetCount() > 0) {
+        out << "Input to swap p50 " << GetInputLatencyPercentile(50.0) * 1000.0 << " ms, p95 "
+            << GetInputLatencyPercentile(95.0) * 1000.0 << " ms, p99 " << GetInputLatencyPercentile(99.0) * 1000.0
+            << " ms (last " << m_InputLatencies.GetCount() << " events)" << std::endl;
+    }
+}
@@ -0,0 +1,613 @@
+#include "GLRecorder.h"
+#include <glad.h>
+
+// Every GL function the program calls, as (pointer type, name without the gl prefix)
+#define GL_RECORDED_FUNCTIONS(X) \
+    X(PFNGLACTIVETEXTUREPROC, ActiveTexture) \
+    X(PFNGLATTACHSHADERPROC, AttachShader) \
+    X(PFNGLBINDBUFFERPROC, BindBuffer) \
+    X(PFNGLBINDFRAMEBUFFERPROC, BindFramebuffer) \
+    X(PFNGLBINDRENDERBUFFERPROC, BindRenderbuffer) \
+    X(PFNGLBINDTEXTUREPROC, BindTexture) \
+    X(PFNGLBINDVERTEXARRAYPROC, BindVertexArray) \
+    X(PFNGLBUFFERDATAPROC, BufferData) \
+    X(PFNGLBUFFERSUBDATAPROC, BufferSubData) \
+    X(PFNGLCHECKFRAMEBUFFERSTATUSPROC, CheckFramebufferStatus) \
+    X(PFNGLCLEARPROC, Clear) \
+    X(PFNGLCLEARCOLORPROC, ClearColor) \
+    X(PFNGLCLEARSTENCILPROC, ClearStencil) \
+    X(PFNGLCOLORMASKPROC, ColorMask) \
+    X(PFNGLCOMPILESHADERPROC, CompileShader) \
+    X(PFNGLCREATEPROGRAMPROC, CreateProgram) \
+    X(PFNGLCREATESHADERPROC, CreateShader) \
+    X(PFNGLDELETEBUFFERSPROC, DeleteBuffers) \
+    X(PFNGLDELETEFRAMEBUFFERSPROC, DeleteFramebuffers) \
+    X(PFNGLDELETEPROGRAMPROC, DeleteProgram) \
+    X(PFNGLDELETERENDERBUFFERSPROC, DeleteRenderbuffers) \
+    X(PFNGLDELETESHADERPROC, DeleteShader) \
+    X(PFNGLDELETETEXTURESPROC, DeleteTextures) \
+    X(PFNGLDELETEVERTEXARRAYSPROC, DeleteVertexArrays) \
+    X(PFNGLDISABLEPROC, Disable) \
+    X(PFNGLDRAWARRAYSPROC, DrawArrays) \
+    X(PFNGLDRAWELEMENTSPROC, DrawElements) \
+    X(PFNGLDRAWELEMENTSINSTANCEDPROC, DrawElementsInstanced) \
+    X(PFNGLENABLEPROC, Enable) \
+    X(PFNGLENABLEVERTEXATTRIBARRAYPROC, EnableVertexAttribArray) \
+    X(PFNGLFINISHPROC, Finish) \
+    X(PFNGLFRAMEBUFFERRENDERBUFFERPROC, FramebufferRenderbuffer) \
+    X(PFNGLFRAMEBUFFERTEXTURE2DPROC, FramebufferTexture2D) \
+    X(PFNGLGENBUFFERSPROC, GenBuffers) \
+    X(PFNGLGENFRAMEBUFFERSPROC, GenFramebuffers) \
+    X(PFNGLGENRENDERBUFFERSPROC, GenRenderbuffers) \
+    X(PFNGLGENTEXTURESPROC, GenTextures) \
+    X(PFNGLGENVERTEXARRAYSPROC, GenVertexArrays) \
+    X(PFNGLGETFLOATVPROC, GetFloatv) \
+    X(PFNGLGETINTEGERVPROC, GetIntegerv) \
+    X(PFNGLGETPROGRAMINFOLOGPROC, GetProgramInfoLog) \
+    X(PFNGLGETPROGRAMIVPROC, GetProgramiv) \
+    X(PFNGLGETSHADERINFOLOGPROC, GetShaderInfoLog) \
+    X(PFNGLGETSHADERIVPROC, GetShaderiv) \
+    X(PFNGLGETSTRINGPROC, GetString) \
+    X(PFNGLGETUNIFORMLOCATIONPROC, GetUniformLocation) \
+    X(PFNGLLINKPROGRAMPROC, LinkProgram) \
+    X(PFNGLPIXELSTOREIPROC, PixelStorei) \
+    X(PFNGLREADPIXELSPROC, ReadPixels) \
+    X(PFNGLRENDERBUFFERSTORAGEPROC, RenderbufferStorage) \
+    X(PFNGLSCISSORPROC, Scissor) \
+    X(PFNGLSHADERSOURCEPROC, ShaderSource) \
+    X(PFNGLSTENCILFUNCPROC, StencilFunc) \
+    X(PFNGLSTENCILOPPROC, StencilOp) \
+    X(PFNGLTEXIMAGE2DPROC, TexImage2D) \
+    X(PFNGLTEXPARAMETERIPROC, TexParameteri) \
+    X(PFNGLTEXSUBIMAGE2DPROC, TexSubImage2D) \
+    X(PFNGLUNIFORM1IPROC, Uniform1i) \
+    X(PFNGLUNIFORM4FPROC, Uniform4f) \
+    X(PFNGLUNIFORMMATRIX4FVPROC, UniformMatrix4fv) \
+    X(PFNGLUSEPROGRAMPROC, UseProgram) \
+    X(PFNGLVERTEXATTRIBDIVISORPROC, VertexAttribDivisor) \
+    X(PFNGLVERTEXATTRIBPOINTERPROC, VertexAttribPointer) \
+    X(PFNGLVIEWPORTPROC, Viewport)
+
+// Version string glGetString returns on the null backend
+static const char* NULL_BACKEND_NAME = "Tangram null GL backend";
+
+// What glGetIntegerv(GL_MAX_TEXTURE_SIZE) reports on the null backend; the minimum GL 3.3 guarantees is 1024
+static const GLint NULL_MAX_TEXTURE_SIZE = 4096;
+
+struct GLDriverTable {
+#define GL_DECLARE_ENTRY(type, name) type name = nullptr;
+    GL_RECORDED_FUNCTIONS(GL_DECLARE_ENTRY)
+#undef GL_DECLARE_ENTRY
+};
+
+// The table the wrappers forward to; all null on the null backend
+static GLDriverTable s_Driver;
+// The glad table as it was before the install
+static GLDriverTable s_Saved;
+static bool s_IsInstalled = false;
+static bool s_IsNull = false;
+static bool s_IsLogging = false;
+static GLCallCounts s_FrameCounts;
+static GLCallCounts s_TotalCounts;
+static std::vector<GLCallRecord> s_FrameLog;
+// Object names handed out by the null backend; 0 is never a valid name
+static GLuint s_NextName = 1;
+
+void GLCallCounts::Add(GLCallType type, uint64_t bytes) {
+    switch (type) {
+    case GLCallType::DRAW:
+        ++draws;
+        break;
+    case GLCallType::BIND:
+        ++binds;
+        break;
+    case GLCallType::UPLOAD:
+        ++uploads;
+        break;
+    case GLCallType::UNIFORM:
+        ++uniforms;
+        break;
+    case GLCallType::PROGRAM:
+        ++programSwitches;
+        break;
+    case GLCallType::OTHER:
+        ++otherCalls;
+        break;
+    }
+    uploadedBytes += bytes;
+}
+
+static void Record(GLCallType type, const char* name, uint64_t bytes = 0) {
+    s_FrameCounts.Add(type, bytes);
+    s_TotalCounts.Add(type, bytes);
+    if (s_IsLogging) {
+        s_FrameLog.push_back({type, name, bytes});
+    }
+}
+
+// Calls the driver function, or nothing on the null backend
+template <typename F, typename... Args>
+static void Forward(F function, Args... args) {
+    if (function != nullptr) {
+        function(args...);
+    }
+}
+
+static void GenerateNames(void (APIENTRYP function)(GLsizei, GLuint*), GLsizei n, GLuint* names) {
+    if (function != nullptr) {
+        function(n, names);
+        return;
+    }
+    for (GLsizei i = 0; i < n; ++i) {
+        names[i] = s_NextName++;
+    }
+}
+
+static uint64_t GetPixelBytes(GLsizei width, GLsizei height, GLenum format, GLenum type) {
+    uint64_t channels = 4;
+    switch (format) {
+    case GL_RED:
+    case GL_DEPTH_COMPONENT:
+        channels = 1;
+        break;
+    case GL_RG:
+        channels = 2;
+        break;
+    case GL_RGB:
+        channels = 3;
+        break;
+    }
+    uint64_t channelBytes = 1;
+    switch (type) {
+    case GL_UNSIGNED_SHORT:
+    case GL_SHORT:
+    case GL_HALF_FLOAT:
+        channelBytes = 2;
+        break;
+    case GL_UNSIGNED_INT:
+    case GL_INT:
+    case GL_FLOAT:
+        channelBytes = 4;
+        break;
+    }
+    return (uint64_t)width * (uint64_t)height * channels * channelBytes;
+}
+
+// Counted, then passed on to the driver; nothing to do on the null backend
+static void APIENTRY RecordActiveTexture(GLenum texture) {
+    Record(GLCallType::OTHER, "glActiveTexture");
+    Forward(s_Driver.ActiveTexture, texture);
+}
+
+static void APIENTRY RecordAttachShader(GLuint program, GLuint shader) {
+    Record(GLCallType::OTHER, "glAttachShader");
+    Forward(s_Driver.AttachShader, program, shader);
+}
+
+static void APIENTRY RecordBindBuffer(GLenum target, GLuint buffer) {
+    Record(GLCallType::BIND, "glBindBuffer");
+    Forward(s_Driver.BindBuffer, target, buffer);
+}
+
+static void APIENTRY RecordBindFramebuffer(GLenum target, GLuint framebuffer) {
+    Record(GLCallType::BIND, "glBindFramebuffer");
+    Forward(s_Driver.BindFramebuffer, target, framebuffer);
+}
+
+static void APIENTRY RecordBindRenderbuffer(GLenum target, GLuint renderbuffer) {
+    Record(GLCallType::BIND, "glBindRenderbuffer");
+    Forward(s_Driver.BindRenderbuffer, target, renderbuffer);
+}
+
+static void APIENTRY RecordBindTexture(GLenum target, GLuint texture) {
+    Record(GLCallType::BIND, "glBindTexture");
+    Forward(s_Driver.BindTexture, target, texture);
+}
+
+static void APIENTRY RecordBindVertexArray(GLuint array) {
+    Record(GLCallType::BIND, "glBindVertexArray");
+    Forward(s_Driver.BindVertexArray, array);
+}
+
+static void APIENTRY RecordBufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage) {
+    Record(GLCallType::UPLOAD, "glBufferData", (uint64_t)size);
+    Forward(s_Driver.BufferData, target, size, data, usage);
+}
+
+static void APIENTRY RecordBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data) {
+    Record(GLCallType::UPLOAD, "glBufferSubData", (uint64_t)size);
+    Forward(s_Driver.BufferSubData, target, offset, size, data);
+}
+
+static void APIENTRY RecordClear(GLbitfield mask) {
+    Record(GLCallType::OTHER, "glClear");
+    Forward(s_Driver.Clear, mask);
+}
+
+static void APIENTRY RecordClearColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha) {
+    Record(GLCallType::OTHER, "glClearColor");
+    Forward(s_Driver.ClearColor, red, green, blue, alpha);
+}
+
+static void APIENTRY RecordClearStencil(GLint s) {
+    Record(GLCallType::OTHER, "glClearStencil");
+    Forward(s_Driver.ClearStencil, s);
+}
+
+static void APIENTRY RecordColorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha) {
+    Record(GLCallType::OTHER, "glColorMask");
+    Forward(s_Driver.ColorMask, red, green, blue, alpha);
+}
+
+static void APIENTRY RecordCompileShader(GLuint shader) {
+    Record(GLCallType::OTHER, "glCompileShader");
+    Forward(s_Driver.CompileShader, shader);
+}
+
+static void APIENTRY RecordDeleteBuffers(GLsizei n, const GLuint* buffers) {
+    Record(GLCallType::OTHER, "glDeleteBuffers");
+    Forward(s_Driver.DeleteBuffers, n, buffers);
+}
+
+static void APIENTRY RecordDeleteFramebuffers(GLsizei n, const GLuint* framebuffers) {
+    Record(GLCallType::OTHER, "glDeleteFramebuffers");
+    Forward(s_Driver.DeleteFramebuffers, n, framebuffers);
+}
+
+static void APIENTRY RecordDeleteProgram(GLuint program) {
+    Record(GLCallType::OTHER, "glDeleteProgram");
+    Forward(s_Driver.DeleteProgram, program);
+}
+
+static void APIENTRY RecordDeleteRenderbuffers(GLsizei n, const GLuint* renderbuffers) {
+    Record(GLCallType::OTHER, "glDeleteRenderbuffers");
+    Forward(s_Driver.DeleteRenderbuffers, n, renderbuffers);
+}
+
+static void APIENTRY RecordDeleteShader(GLuint shader) {
+    Record(GLCallType::OTHER, "glDeleteShader");
+    Forward(s_Driver.DeleteShader, shader);
+}
+
+static void APIENTRY RecordDeleteTextures(GLsizei n, const GLuint* textures) {
+    Record(GLCallType::OTHER, "glDeleteTextures");
+    Forward(s_Driver.DeleteTextures, n, textures);
+}
+
+static void APIENTRY RecordDeleteVertexArrays(GLsizei n, const GLuint* arrays) {
+    Record(GLCallType::OTHER, "glDeleteVertexArrays");
+    Forward(s_Driver.DeleteVertexArrays, n, arrays);
+}
+
+static void APIENTRY RecordDisable(GLenum cap) {
+    Record(GLCallType::OTHER, "glDisable");
+    Forward(s_Driver.Disable, cap);
+}
+
+static void APIENTRY RecordDrawArrays(GLenum mode, GLint first, GLsizei count) {
+    Record(GLCallType::DRAW, "glDrawArrays");
+    Forward(s_Driver.DrawArrays, mode, first, count);
+}
+
+static void APIENTRY RecordDrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices) {
+    Record(GLCallType::DRAW, "glDrawElements");
+    Forward(s_Driver.DrawElements, mode, count, type, indices);
+}
+
+static void APIENTRY RecordDrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instancecount) {
+    Record(GLCallType::DRAW, "glDrawElementsInstanced");
+    Forward(s_Driver.DrawElementsInstanced, mode, count, type, indices, instancecount);
+}
+
+static void APIENTRY RecordEnable(GLenum cap) {
+    Record(GLCallType::OTHER, "glEnable");
+    Forward(s_Driver.Enable, cap);
+}
+
+static void APIENTRY RecordEnableVertexAttribArray(GLuint index) {
+    Record(GLCallType::OTHER, "glEnableVertexAttribArray");
+    Forward(s_Driver.EnableVertexAttribArray, index);
+}
+
+static void APIENTRY RecordFinish() {
+    Record(GLCallType::OTHER, "glFinish");
+    Forward(s_Driver.Finish);
+}
+
+static void APIENTRY RecordFramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer) {
+    Record(GLCallType::OTHER, "glFramebufferRenderbuffer");
+    Forward(s_Driver.FramebufferRenderbuffer, target, attachment, renderbuffertarget, renderbuffer);
+}
+
+static void APIENTRY RecordFramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level) {
+    Record(GLCallType::OTHER, "glFramebufferTexture2D");
+    Forward(s_Driver.FramebufferTexture2D, target, attachment, textarget, texture, level);
+}
+
+static void APIENTRY RecordLinkProgram(GLuint program) {
+    Record(GLCallType::OTHER, "glLinkProgram");
+    Forward(s_Driver.LinkProgram, program);
+}
+
+static void APIENTRY RecordPixelStorei(GLenum pname, GLint param) {
+    Record(GLCallType::OTHER, "glPixelStorei");
+    Forward(s_Driver.PixelStorei, pname, param);
+}
+
+static void APIENTRY RecordReadPixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void* pixels) {
+    Record(GLCallType::OTHER, "glReadPixels");
+    Forward(s_Driver.ReadPixels, x, y, width, height, format, type, pixels);
+}
+
+static void APIENTRY RecordRenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height) {
+    Record(GLCallType::OTHER, "glRenderbufferStorage");
+    Forward(s_Driver.RenderbufferStorage, target, internalformat, width, height);
+}
+
+static void APIENTRY RecordScissor(GLint x, GLint y, GLsizei width, GLsizei height) {
+    Record(GLCallType::OTHER, "glScissor");
+    Forward(s_Driver.Scissor, x, y, width, height);
+}
+
+static void APIENTRY RecordShaderSource(GLuint shader, GLsizei count, const GLchar* const* string, const GLint* length) {
+    Record(GLCallType::OTHER, "glShaderSource");
+    Forward(s_Driver.ShaderSource, shader, count, string, length);
+}
+
+static void APIENTRY RecordStencilFunc(GLenum func, GLint ref, GLuint mask) {
+    Record(GLCallType::OTHER, "glStencilFunc");
+    Forward(s_Driver.StencilFunc, func, ref, mask);
+}
+
+static void APIENTRY RecordStencilOp(GLenum fail, GLenum zfail, GLenum zpass) {
+    Record(GLCallType::OTHER, "glStencilOp");
+    Forward(s_Driver.StencilOp, fail, zfail, zpass);
+}
+
+static void APIENTRY RecordTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void* pixels) {
+    Record(GLCallType::UPLOAD, "glTexImage2D", pixels != nullptr ? GetPixelBytes(width, height, format, type) : 0);
+    Forward(s_Driver.TexImage2D, target, level, internalformat, width, height, border, format, type, pixels);
+}
+
+static void APIENTRY RecordTexParameteri(GLenum target, GLenum pname, GLint param) {
+    Record(GLCallType::OTHER, "glTexParameteri");
+    Forward(s_Driver.TexParameteri, target, pname, param);
+}
+
+static void APIENTRY RecordTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pixels) {
+    Record(GLCallType::UPLOAD, "glTexSubImage2D", GetPixelBytes(width, height, format, type));
+    Forward(s_Driver.TexSubImage2D, target, level, xoffset, yoffset, width, height, format, type, pixels);
+}
+
+static void APIENTRY RecordUniform1i(GLint location, GLint v0) {
+    Record(GLCallType::UNIFORM, "glUniform1i");
+    Forward(s_Driver.Uniform1i, location, v0);
+}
+
+static void APIENTRY RecordUniform4f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3) {
+    Record(GLCallType::UNIFORM, "glUniform4f");
+    Forward(s_Driver.Uniform4f, location, v0, v1, v2, v3);
+}
+
+static void APIENTRY RecordUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) {
+    Record(GLCallType::UNIFORM, "glUniformMatrix4fv");
+    Forward(s_Driver.UniformMatrix4fv, location, count, transpose, value);
+}
+
+static void APIENTRY RecordUseProgram(GLuint program) {
+    Record(GLCallType::PROGRAM, "glUseProgram");
+    Forward(s_Driver.UseProgram, program);
+}
+
+static void APIENTRY RecordVertexAttribDivisor(GLuint index, GLuint divisor) {
+    Record(GLCallType::OTHER, "glVertexAttribDivisor");
+    Forward(s_Driver.VertexAttribDivisor, index, divisor);
+}
+
+static void APIENTRY RecordVertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer) {
+    Record(GLCallType::OTHER, "glVertexAttribPointer");
+    Forward(s_Driver.VertexAttribPointer, index, size, type, normalized, stride, pointer);
+}
+
+static void APIENTRY RecordViewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+    Record(GLCallType::OTHER, "glViewport");
+    Forward(s_Driver.Viewport, x, y, width, height);
+}
+
+// Calls whose results the null backend has to make up
+static GLenum APIENTRY RecordCheckFramebufferStatus(GLenum target) {
+    Record(GLCallType::OTHER, "glCheckFramebufferStatus");
+    return s_Driver.CheckFramebufferStatus != nullptr ? s_Driver.CheckFramebufferStatus(target) : GL_FRAMEBUFFER_COMPLETE;
+}
+
+static GLuint APIENTRY RecordCreateProgram() {
+    Record(GLCallType::OTHER, "glCreateProgram");
+    return s_Driver.CreateProgram != nullptr ? s_Driver.CreateProgram() : s_NextName++;
+}
+
+static GLuint APIENTRY RecordCreateShader(GLenum type) {
+    Record(GLCallType::OTHER, "glCreateShader");
+    return s_Driver.CreateShader != nullptr ? s_Driver.CreateShader(type) : s_NextName++;
+}
+
+static void APIENTRY RecordGenBuffers(GLsizei n, GLuint* buffers) {
+    Record(GLCallType::OTHER, "glGenBuffers");
+    GenerateNames(s_Driver.GenBuffers, n, buffers);
+}
+
+static void APIENTRY RecordGenFramebuffers(GLsizei n, GLuint* framebuffers) {
+    Record(GLCallType::OTHER, "glGenFramebuffers");
+    GenerateNames(s_Driver.GenFramebuffers, n, framebuffers);
+}
+
+static void APIENTRY RecordGenRenderbuffers(GLsizei n, GLuint* renderbuffers) {
+    Record(GLCallType::OTHER, "glGenRenderbuffers");
+    GenerateNames(s_Driver.GenRenderbuffers, n, renderbuffers);
+}
+
+static void APIENTRY RecordGenTextures(GLsizei n, GLuint* textures) {
+    Record(GLCallType::OTHER, "glGenTextures");
+    GenerateNames(s_Driver.GenTextures, n, textures);
+}
+
+static void APIENTRY RecordGenVertexArrays(GLsizei n, GLuint* arrays) {
+    Record(GLCallType::OTHER, "glGenVertexArrays");
+    GenerateNames(s_Driver.GenVertexArrays, n, arrays);
+}
+
+static void APIENTRY RecordGetFloatv(GLenum pname, GLfloat* data) {
+    Record(GLCallType::OTHER, "glGetFloatv");
+    if (s_Driver.GetFloatv != nullptr) {
+        s_Driver.GetFloatv(pname, data);
+        return;
+    }
+    int count = pname == GL_COLOR_CLEAR_VALUE ? 4 : 1;
+    for (int i = 0; i < count; ++i) {
+        data[i] = 0.0f;
+    }
+}
+
+static void APIENTRY RecordGetIntegerv(GLenum pname, GLint* data) {
+    Record(GLCallType::OTHER, "glGetIntegerv");
+    if (s_Driver.GetIntegerv != nullptr) {
+        s_Driver.GetIntegerv(pname, data);
+        return;
+    }
+    if (pname == GL_MAX_TEXTURE_SIZE) {
+        data[0] = NULL_MAX_TEXTURE_SIZE;
+        return;
+    }
+    int count = pname == GL_VIEWPORT ? 4 : 1;
+    for (int i = 0; i < count; ++i) {
+        data[i] = 0;
+    }
+}
+
+// Shaders compile and programs link on the null backend, with nothing to report
+static void APIENTRY RecordGetProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei* length, GLchar* infoLog) {
+    Record(GLCallType::OTHER, "glGetProgramInfoLog");
+    if (s_Driver.GetProgramInfoLog != nullptr) {
+        s_Driver.GetProgramInfoLog(program, bufSize, length, infoLog);
+        return;
+    }
+    if (length != nullptr) {
+        *length = 0;
+    }
+    if (bufSize > 0) {
+        infoLog[0] = '\0';
+    }
+}
+
+static void APIENTRY RecordGetProgramiv(GLuint program, GLenum pname, GLint* params) {
+    Record(GLCallType::OTHER, "glGetProgramiv");
+    if (s_Driver.GetProgramiv != nullptr) {
+        s_Driver.GetProgramiv(program, pname, params);
+        return;
+    }
+    *params = pname == GL_LINK_STATUS || pname == GL_VALIDATE_STATUS ? GL_TRUE : 0;
+}
+
+static void APIENTRY RecordGetShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog) {
+    Record(GLCallType::OTHER, "glGetShaderInfoLog");
+    if (s_Driver.GetShaderInfoLog != nullptr) {
+        s_Driver.GetShaderInfoLog(shader, bufSize, length, infoLog);
+        return;
+    }
+    if (length != nullptr) {
+        *length = 0;
+    }
+    if (bufSize > 0) {
+        infoLog[0] = '\0';
+    }
+}
+
+static void APIENTRY RecordGetShaderiv(GLuint shader, GLenum pname, GLint* params) {
+    Record(GLCallType::OTHER, "glGetShaderiv");
+    if (s_Driver.GetShaderiv != nullptr) {
+        s_Driver.GetShaderiv(shader, pname, params);
+        return;
+    }
+    *params = pname == GL_COMPILE_STATUS ? GL_TRUE : 0;
+}
+
+static const GLubyte* APIENTRY RecordGetString(GLenum name) {
+    Record(GLCallType::OTHER, "glGetString");
+    if (s_Driver.GetString != nullptr) {
+        return s_Driver.GetString(name);
+    }
+    return (const GLubyte*)NULL_BACKEND_NAME;
+}
+
+static GLint APIENTRY RecordGetUniformLocation(GLuint program, const GLchar* name) {
+    Record(GLCallType::OTHER, "glGetUniformLocation");
+    return s_Driver.GetUniformLocation != nullptr ? s_Driver.GetUniformLocation(program, name) : 0;
+}
+
+static void InstallTable(bool isNull) {
+    if (s_IsInstalled) {
+        GLRecorder::Uninstall();
+    }
+#define GL_INSTALL_ENTRY(type, name) \
+    s_Saved.name = glad_gl##name; \
+    s_Driver.name = isNull ? nullptr : glad_gl##name; \
+    glad_gl##name = Record##name;
+    GL_RECORDED_FUNCTIONS(GL_INSTALL_ENTRY)
+#undef GL_INSTALL_ENTRY
+    s_IsInstalled = true;
+    s_IsNull = isNull;
+    s_FrameCounts = GLCallCounts();
+    s_TotalCounts = GLCallCounts();
+    s_FrameLog.clear();
+}
+
+void GLRecorder::Install() {
+    InstallTable(false);
+}
+
+void GLRecorder::InstallNull() {
+    InstallTable(true);
+}
+
+void GLRecorder::Uninstall() {
+    if (!s_IsInstalled) {
+        return;
+    }
+#define GL_RESTORE_ENTRY(type, name) glad_gl##name = s_Saved.name;
+    GL_RECORDED_FUNCTIONS(GL_RESTORE_ENTRY)
+#undef GL_RESTORE_ENTRY
+    s_Driver = GLDriverTable();
+    s_IsInstalled = false;
+    s_IsNull = false;
+}
+
+bool GLRecorder::IsInstalled() {
+    return s_IsInstalled;
+}
+
+bool GLRecorder::IsNull() {
+    return s_IsNull;
+}
+
+void GLRecorder::BeginFrame() {
+    s_FrameCounts = GLCallCounts();
+    s_FrameLog.clear();
+}
+
+const GLCallCounts& GLRecorder::GetFrameCounts() {
+    return s_FrameCounts;
+}
+
+const GLCallCounts& GLRecorder::GetTotalCounts() {
+    return s_TotalCounts;
+}
+
+void GLRecorder::SetLogging(bool enabled) {
+    s_IsLogging = enabled;
+    if (!enabled) {
+        s_FrameLog.clear();
+    }
+}
+
+const std::vector<GLCallRecord>& GLRecorder::GetFrameLog() {
+    return s_FrameLog;
+}
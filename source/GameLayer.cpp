@@ -4,20 +4,52 @@
 #include "TangramSquare.h"
 #include "TangramParallelogram.h"
 #include "BufferLayout.h"
+#include "PieceGeometry.h"
+#include "TangramSolver.h"
+#include "LevelPack.h"
+#include "Log.h"
 #include <GLFW/glfw3.h>
-#include <iostream>
+#include <algorithm>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+// Hint search time per frame, small enough to leave the frame to rendering
+static const std::chrono::microseconds HINT_FRAME_BUDGET(2000);
+// Same for the full solve of the silhouette ('V' key)
+static const std::chrono::microseconds SOLVE_FRAME_BUDGET(2000);
+
+// Undo entries kept; a level rarely needs more than a few hundred moves
+static const size_t EDIT_LOG_CAPACITY = 1024;
+
+static PieceEdit MakeEdit(PieceEditType type, int piece) {
+    PieceEdit edit;
+    edit.type = type;
+    edit.piece = piece;
+    edit.offset = glm::vec2(0.0f, 0.0f);
+    edit.angle = 0.0f;
+    edit.slot = -1;
+    edit.fromColor = glm::vec3(0.0f, 0.0f, 0.0f);
+    edit.toColor = glm::vec3(0.0f, 0.0f, 0.0f);
+    return edit;
+}
+
 GameLayer::GameLayer(const char* vertPath, const char* fragPath, Application* windowContext, Level* level)
     : m_Shader(vertPath, fragPath)
     , m_CurrentLevel(level)
     , m_WindowContext(windowContext)
     , m_SelectedPiece(nullptr)
+    , m_SelectedPieceIndex(-1)
+    , m_MagnetGrid(MAGNET_CELL_SIZE)
+    , m_MagnetOffset(0.0f, 0.0f)
+    , m_IsMagnetEnabled(true)
+    , m_EditLog(EDIT_LOG_CAPACITY)
+    , m_DragStartPosition(0.0f, 0.0f)
     , m_GameState(GameState::PLAYING)
     , m_ViewMatrix(glm::mat4(1.0f))
     , m_IsTranslating(false)
     , m_IsPanning(false)
+    , m_CursorX(0.0)
+    , m_CursorY(0.0)
     , m_LastMouseX(0.0)
     , m_LastMouseY(0.0)
     , m_LastPanMouseX(0.0)
@@ -29,21 +61,32 @@ GameLayer::GameLayer(const char* vertPath, const char* fragPath, Application* wi
     
     UpdateViewMatrix();
     InitializePieces();
+    m_SnapIndex.Build(m_CurrentLevel->GetSolution(), m_Board);
     
-    // Setup silhouette rendering
-    const auto& silhouetteVerts = m_CurrentLevel->GetSilhouetteVertices();
-    for (const auto& vert : silhouetteVerts) {
-        m_SilhouetteVertices.push_back(vert.x);
-        m_SilhouetteVertices.push_back(vert.y);
-        m_SilhouetteVertices.push_back(0.5f);  // R
-        m_SilhouetteVertices.push_back(0.5f);  // G
-        m_SilhouetteVertices.push_back(0.5f);  // B
-        m_SilhouetteVertices.push_back(0.3f);  // A (semi-transparent)
+    m_CollisionShapes.resize(m_Pieces.size());
+    m_IgnoreCollision.assign(m_Pieces.size(), false);
+    for (size_t i = 0; i < m_Pieces.size(); ++i) {
+        RefreshCollisionShape(i);
     }
     
-    // Create indices for line loop
-    for (size_t i = 0; i < silhouetteVerts.size(); ++i) {
-        m_SilhouetteIndices.push_back(i);
+    // Setup silhouette rendering: the outline and its holes as separate closed line strips
+    std::vector<std::vector<glm::vec2>> silhouetteContours = m_CurrentLevel->GetSilhouetteHoles();
+    silhouetteContours.insert(silhouetteContours.begin(), m_CurrentLevel->GetSilhouetteVertices());
+    for (const auto& contour : silhouetteContours) {
+        unsigned int first = m_SilhouetteVertices.size() / 6;
+        for (size_t i = 0; i < contour.size(); ++i) {
+            const glm::vec2& vert = contour[i];
+            m_SilhouetteVertices.push_back(vert.x);
+            m_SilhouetteVertices.push_back(vert.y);
+            m_SilhouetteVertices.push_back(0.5f);  // R
+            m_SilhouetteVertices.push_back(0.5f);  // G
+            m_SilhouetteVertices.push_back(0.5f);  // B
+            m_SilhouetteVertices.push_back(0.3f);  // A (semi-transparent)
+            
+            // Indices for GL_LINES, closing the contour back to its first vertex
+            m_SilhouetteIndices.push_back(first + i);
+            m_SilhouetteIndices.push_back(first + (i + 1) % contour.size());
+        }
     }
     
     BufferLayout silhouetteLayout;
@@ -73,102 +116,131 @@ void GameLayer::InitializePieces() {
     float startY = 2.0f;
     float spacing = 0.8f;
     
+    const glm::vec3 colors[] = {
+        glm::vec3(1.0f, 0.0f, 0.0f),  // Red
+        glm::vec3(0.0f, 1.0f, 0.0f),  // Green
+        glm::vec3(0.0f, 0.0f, 1.0f),  // Blue
+        glm::vec3(1.0f, 1.0f, 0.0f),  // Yellow
+        glm::vec3(1.0f, 0.0f, 1.0f),  // Magenta
+        glm::vec3(0.0f, 1.0f, 1.0f),  // Cyan
+        glm::vec3(1.0f, 0.5f, 0.0f)   // Orange
+    };
+    
     // 2 Large Triangles
-    m_Pieces.push_back(new TangramTriangle(startX, startY, TriangleSize::LARGE, 1.0f, 0.0f, 0.0f));  // Red
-    m_Pieces.push_back(new TangramTriangle(startX, startY - spacing, TriangleSize::LARGE, 0.0f, 1.0f, 0.0f));  // Green
+    m_Pieces.push_back(new TangramTriangle(startX, startY, TriangleSize::LARGE, colors[0].x, colors[0].y, colors[0].z));
+    m_Pieces.push_back(new TangramTriangle(startX, startY - spacing, TriangleSize::LARGE, colors[1].x, colors[1].y, colors[1].z));
     
     // 1 Medium Triangle
-    m_Pieces.push_back(new TangramTriangle(startX, startY - spacing * 2, TriangleSize::MEDIUM, 0.0f, 0.0f, 1.0f));  // Blue
+    m_Pieces.push_back(new TangramTriangle(startX, startY - spacing * 2, TriangleSize::MEDIUM, colors[2].x, colors[2].y, colors[2].z));
     
     // 2 Small Triangles
-    m_Pieces.push_back(new TangramTriangle(startX, startY - spacing * 3, TriangleSize::SMALL, 1.0f, 1.0f, 0.0f));  // Yellow
-    m_Pieces.push_back(new TangramTriangle(startX, startY - spacing * 4, TriangleSize::SMALL, 1.0f, 0.0f, 1.0f));  // Magenta
+    m_Pieces.push_back(new TangramTriangle(startX, startY - spacing * 3, TriangleSize::SMALL, colors[3].x, colors[3].y, colors[3].z));
+    m_Pieces.push_back(new TangramTriangle(startX, startY - spacing * 4, TriangleSize::SMALL, colors[4].x, colors[4].y, colors[4].z));
     
     // 1 Square
-    m_Pieces.push_back(new TangramSquare(startX, startY - spacing * 5, 0.707f, 0.0f, 1.0f, 1.0f));  // Cyan
+    m_Pieces.push_back(new TangramSquare(startX, startY - spacing * 5, 0.707f, colors[5].x, colors[5].y, colors[5].z));
     
     // 1 Parallelogram
-    m_Pieces.push_back(new TangramParallelogram(startX, startY - spacing * 6, 0.707f, 1.0f, 0.5f, 0.0f));  // Orange
+    m_Pieces.push_back(new TangramParallelogram(startX, startY - spacing * 6, 0.707f, colors[6].x, colors[6].y, colors[6].z));
+    
+    // The board mirrors the pieces as built; the copy is what ResetLevel() restores
+    m_Board = BoardState();
+    for (size_t i = 0; i < m_Pieces.size(); ++i) {
+        m_Board.AddPiece(m_Pieces[i]->GetPieceType(), m_Pieces[i]->GetCenter(), colors[i]);
+    }
+    m_InitialBoard = m_Board;
+    m_PreviousBoard = m_Board;
     
     // DEBUG: Print piece information
-    std::cout << "\n=== PIECE GEOMETRY DEBUG ===" << std::endl;
+    LOG_DEBUG(GAME, "\n=== PIECE GEOMETRY DEBUG ===");
     const char* names[] = {"LT-Red", "LT-Green", "MT-Blue", "ST-Yellow", "ST-Magenta", "Sq-Cyan", "Para-Orange"};
     for (size_t i = 0; i < m_Pieces.size(); ++i) {
         glm::vec2 localCenter = m_Pieces[i]->GetLocalCenter();
         glm::vec2 worldCenter = m_Pieces[i]->GetCenter();
-        std::cout << i << ". " << names[i] << ": LocalCenter(" << localCenter.x << ", " << localCenter.y << ")" 
-                  << " WorldCenter(" << worldCenter.x << ", " << worldCenter.y << ")" << std::endl;
+        LOG_DEBUG(GAME, i << ". " << names[i] << ": LocalCenter(" << localCenter.x << ", " << localCenter.y << ")" 
+                  << " WorldCenter(" << worldCenter.x << ", " << worldCenter.y << ")");
     }
-    std::cout << "===========================\n" << std::endl;
+    LOG_DEBUG(GAME, "===========================\n");
 }
 
-void GameLayer::OnRender() {
-    m_Shader.Bind();
-    
-    const glm::mat4& proj = m_WindowContext->GetProjectionMatrix();
-    const glm::mat4& view = m_ViewMatrix;
+void GameLayer::OnRender(CommandList& commands, float alpha) {
+    // Search slices follow rendered frames rather than simulation steps, so the budget is per frame
+    if (m_HintEngine.Update(HINT_FRAME_BUDGET)) {
+        ReportHint();
+    }
+    if (m_Solver.GetStatus() == SearchStatus::RUNNING && m_Solver.Step(SOLVE_FRAME_BUDGET) != SearchStatus::RUNNING) {
+        ReportSolution();
+    }
     
-    m_Shader.SetUniformMat4f("u_Projection", proj);
-    m_Shader.SetUniformMat4f("u_View", view);
+    commands.SetCamera(&m_Shader, m_WindowContext->GetProjectionMatrix(), m_ViewMatrix);
     
     // Render silhouette outline (shows target shape border)
-    // RenderSilhouette();  // DISABLED - only using ghost pieces now
+    // RenderSilhouette(commands);  // DISABLED - only using ghost pieces now
     
     // Render ghost pieces showing target positions (only for unlocked pieces)
-    RenderDynamicSilhouette();
-    
-    // Reset color override for pieces
-    m_Shader.SetUniform1i("u_UseUniformColor", 0);
+    RenderDynamicSilhouette(commands);
     
-    // Render all Tangram pieces
-    for (TangramPiece* piece : m_Pieces) {
-        const glm::mat4& model = piece->GetModelMatrix();
-        m_Shader.SetUniformMat4f("u_Model", model);
-        m_Renderer.Draw(piece->GetVAO(), piece->GetIBO(), piece->GetDrawnMode());
+    // Render all Tangram pieces, in their board color
+    for (int i = 0; i < (int)m_Pieces.size(); ++i) {
+        TangramPiece* piece = m_Pieces[i];
+        glm::mat4 model = piece->GetModelMatrix();
+        
+        // Moves between steps are drawn part way; rotations, flips and snaps are discrete and jump
+        bool isMoving = m_PreviousBoard.rotation[i] == m_Board.rotation[i] &&
+                        m_PreviousBoard.isFlipped[i] == m_Board.isFlipped[i] &&
+                        m_PreviousBoard.isLocked[i] == m_Board.isLocked[i];
+        if (isMoving) {
+            glm::vec2 lag = (m_PreviousBoard.GetPosition(i) - m_Board.GetPosition(i)) * (1.0f - alpha);
+            model = glm::translate(glm::mat4(1.0f), glm::vec3(lag.x, lag.y, 0.0f)) * model;
+        }
+        
+        commands.Draw({&piece->GetVAO(), &piece->GetIBO(), piece->GetDrawnMode(), model, glm::vec4(m_Board.GetColor(i), 1.0f), true});
     }
 }
 
-void GameLayer::RenderSilhouette() {
-    glm::mat4 identityModel(1.0f);
-    m_Shader.SetUniformMat4f("u_Model", identityModel);
-    m_Renderer.Draw(*m_SilhouetteVAO, *m_SilhouetteIBO, GL_LINE_LOOP);
+void GameLayer::RenderSilhouette(CommandList& commands) {
+    commands.Draw({m_SilhouetteVAO, m_SilhouetteIBO, GL_LINES, glm::mat4(1.0f), glm::vec4(0.0f), false});
 }
 
-void GameLayer::RenderDynamicSilhouette() {
-    m_Shader.SetUniform1i("u_UseUniformColor", 1);
-    m_Shader.SetUniform4f("u_Color", 0.3f, 0.3f, 0.3f, 0.3f); // Semi-transparent gray
-    
-    const auto& solution = m_CurrentLevel->GetSolution();
-    for (const auto& target : solution) {
-        if (target.pieceIndex >= 0 && target.pieceIndex < (int)m_Pieces.size()) {
-            TangramPiece* piece = m_Pieces[target.pieceIndex];
-            
-            // Only show ghost for unlocked pieces
-            if (piece->IsLocked()) {
-                continue;
-            }
-            
-            glm::vec2 localCenter = piece->GetLocalCenter();
-            
-            glm::mat4 targetModel = glm::mat4(1.0f);
-            targetModel = glm::translate(targetModel, glm::vec3(target.position.x, target.position.y, 0.0f));
-            targetModel = glm::rotate(targetModel, target.rotation, glm::vec3(0.0f, 0.0f, 1.0f));
-            
-            if (target.isFlipped) {
-                targetModel = glm::scale(targetModel, glm::vec3(-1.0f, 1.0f, 1.0f));
-            }
-            
-            targetModel = glm::translate(targetModel, glm::vec3(-localCenter.x, -localCenter.y, 0.0f));
-            
-            m_Shader.SetUniformMat4f("u_Model", targetModel);
-            m_Renderer.Draw(piece->GetVAO(), piece->GetIBO(), piece->GetDrawnMode());
+void GameLayer::RenderDynamicSilhouette(CommandList& commands) {
+    const glm::vec4 ghostColor(0.3f, 0.3f, 0.3f, 0.3f); // Semi-transparent gray
+    
+    const std::vector<SnapSlot>& slots = m_SnapIndex.GetSlots();
+    for (size_t i = 0; i < slots.size(); ++i) {
+        const SnapSlot& slot = slots[i];
+        // Only show ghost for slots no piece has been locked into yet
+        if (slot.occupant != -1) {
+            continue;
+        }
+        
+        // The hinted slot is tinted with the color of the piece to put there
+        glm::vec4 color = ghostColor;
+        if (m_HintEngine.HasHint() && m_HintEngine.GetHint().slotIndex == (int)i) {
+            color = glm::vec4(m_Board.GetColor(m_HintEngine.GetHint().pieceIndex), 0.6f);
+        }
+        
+        // Any piece of the slot's type has the same outline, so draw the one it was authored with
+        TangramPiece* piece = m_Pieces[slot.targetPieceIndex];
+        glm::vec2 localCenter = piece->GetLocalCenter();
+        
+        glm::mat4 targetModel = glm::mat4(1.0f);
+        targetModel = glm::translate(targetModel, glm::vec3(slot.position.x, slot.position.y, 0.0f));
+        targetModel = glm::rotate(targetModel, slot.rotation, glm::vec3(0.0f, 0.0f, 1.0f));
+        
+        if (slot.isFlipped) {
+            targetModel = glm::scale(targetModel, glm::vec3(-1.0f, 1.0f, 1.0f));
         }
+        
+        targetModel = glm::translate(targetModel, glm::vec3(-localCenter.x, -localCenter.y, 0.0f));
+        
+        commands.Draw({&piece->GetVAO(), &piece->GetIBO(), piece->GetDrawnMode(), targetModel, color, true});
     }
 }
 
 void GameLayer::ConvertScreenToNDC(double mouseX, double mouseY, float& outX, float& outY) {
-    int windowWidth, windowHeight;
-    glfwGetWindowSize(m_WindowContext->GetWindow(), &windowWidth, &windowHeight);
+    // The window size the input was delivered with, which a replay sets from the recording
+    int windowWidth = m_WindowContext->GetWindowWidth();
+    int windowHeight = m_WindowContext->GetWindowHeight();
     
     outX = (mouseX / (float)windowWidth) * 2.0f - 1.0f;
     outY = 1.0f - (mouseY / (float)windowHeight) * 2.0f;
@@ -195,28 +267,40 @@ void GameLayer::ConvertScreenToWorld(double mouseX, double mouseY, float& outX,
     }
 }
 
-void GameLayer::OnUpdate(GLFWwindow* window) {
+void GameLayer::OnUpdate(GLFWwindow* /*window*/, float /*deltaTime*/) {
+    // Drags and pans follow the cursor, so they need no step length
+    m_PreviousBoard = m_Board;
+    
     if (m_IsTranslating && m_SelectedPiece != nullptr) {
-        double mouseX, mouseY;
         float outX, outY;
-        glfwGetCursorPos(window, &mouseX, &mouseY);
-        ConvertScreenToWorld(mouseX, mouseY, outX, outY);
+        ConvertScreenToWorld(m_CursorX, m_CursorY, outX, outY);
         
         float dx = (float)(outX - m_LastMouseX);
         float dy = (float)(outY - m_LastMouseY);
         
-        m_SelectedPiece->Translate(dx, dy);
+        glm::vec2 delta(dx, dy);
+        if (m_IsMagnetEnabled && !m_Board.isLocked[m_SelectedPieceIndex]) {
+            delta = ApplyMagnet(delta);
+        }
+        
+        // Pieces cannot be dragged through each other; the move slides along the contact instead
+        glm::vec2 pulled = delta;
+        delta = ResolveDragCollision(delta);
+        if (delta != pulled) {
+            // The pull was cut short or blocked, so it is not what moved the piece; the next
+            // frame must not take it back
+            m_MagnetOffset = glm::vec2(0.0f, 0.0f);
+        }
+        m_Board.Translate(m_SelectedPieceIndex, delta);
+        m_SelectedPiece->Translate(delta.x, delta.y);
         
         m_LastMouseX = outX;
         m_LastMouseY = outY;
     }
     
     if (m_IsPanning) {
-        double mouseX, mouseY;
-        glfwGetCursorPos(window, &mouseX, &mouseY);
-        
-        double dx = mouseX - m_LastPanMouseX;
-        double dy = mouseY - m_LastPanMouseY;
+        double dx = m_CursorX - m_LastPanMouseX;
+        double dy = m_CursorY - m_LastPanMouseY;
         
         float windowWidth = (float)m_WindowContext->GetWidth();
         float windowHeight = (float)m_WindowContext->GetHeight();
@@ -236,8 +320,31 @@ void GameLayer::OnUpdate(GLFWwindow* window) {
         
         UpdateViewMatrix();
         
-        m_LastPanMouseX = mouseX;
-        m_LastPanMouseY = mouseY;
+        m_LastPanMouseX = m_CursorX;
+        m_LastPanMouseY = m_CursorY;
+    }
+}
+
+void GameLayer::OnInputEvents(const InputEvent* events, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const InputEvent& event = events[i];
+        switch (event.type) {
+            case InputEventType::KEY:
+                OnKeyEvent(event.code, event.scancode, event.action, event.mods);
+                break;
+            case InputEventType::MOUSE_BUTTON:
+                m_CursorX = event.x;
+                m_CursorY = event.y;
+                OnMouseButtonEvent(event.code, event.action, event.mods, event.x, event.y);
+                break;
+            case InputEventType::CURSOR_MOVE:
+                // Drags and pans catch up with the cursor in the next simulation step
+                m_CursorX = event.x;
+                m_CursorY = event.y;
+                break;
+            case InputEventType::SCROLL:
+                break;
+        }
     }
 }
 
@@ -250,7 +357,7 @@ void GameLayer::UpdateViewMatrix() {
 void GameLayer::OnKeyEvent(int key, int /*scancode*/, int action, int mods) {
     if (key == GLFW_KEY_SPACE && action == GLFW_RELEASE) {
         m_IsPanning = false;
-        std::cout << "Panning mode deactivated" << std::endl;
+        LOG_INFO(GAME, "Panning mode deactivated");
         return;
     }
     
@@ -261,48 +368,70 @@ void GameLayer::OnKeyEvent(int key, int /*scancode*/, int action, int mods) {
     switch (key) {
         case GLFW_KEY_Q: {
             if (mods & GLFW_MOD_CONTROL) {
-                std::cout << "Quitting to menu..." << std::endl;
+                LOG_INFO(GAME, "Quitting to menu...");
                 GLFWwindow* window = m_WindowContext->GetWindow();
                 glfwSetWindowShouldClose(window, GLFW_TRUE);
-            } else if (m_SelectedPiece != nullptr) {
+            } else if (m_SelectedPiece != nullptr && !m_Board.isLocked[m_SelectedPieceIndex]) {
                 float rotationAngle = 0.1f;
-                m_SelectedPiece->Rotate(rotationAngle);
-                std::cout << "Rotated piece counter-clockwise" << std::endl;
+                m_Board.rotation[m_SelectedPieceIndex] += rotationAngle;
+                SyncPiece(m_SelectedPieceIndex);
+                PieceEdit edit = MakeEdit(PieceEditType::ROTATE, m_SelectedPieceIndex);
+                edit.angle = rotationAngle;
+                RecordEdit(edit);
+                LOG_INFO(GAME, "Rotated piece counter-clockwise");
             }
             break;
         }
         
         case GLFW_KEY_E: {
-            if (m_SelectedPiece != nullptr) {
+            if (m_SelectedPiece != nullptr && !m_Board.isLocked[m_SelectedPieceIndex]) {
                 float rotationAngle = -0.1f;
-                m_SelectedPiece->Rotate(rotationAngle);
-                std::cout << "Rotated piece clockwise" << std::endl;
+                m_Board.rotation[m_SelectedPieceIndex] += rotationAngle;
+                SyncPiece(m_SelectedPieceIndex);
+                PieceEdit edit = MakeEdit(PieceEditType::ROTATE, m_SelectedPieceIndex);
+                edit.angle = rotationAngle;
+                RecordEdit(edit);
+                LOG_INFO(GAME, "Rotated piece clockwise");
             }
             break;
         }
         
         case GLFW_KEY_F: {
-            if (m_SelectedPiece != nullptr) {
-                m_SelectedPiece->Flip();
-                std::cout << "Flipped piece" << std::endl;
+            if (m_SelectedPiece != nullptr && !m_Board.isLocked[m_SelectedPieceIndex]) {
+                m_Board.isFlipped[m_SelectedPieceIndex] = !m_Board.isFlipped[m_SelectedPieceIndex];
+                SyncPiece(m_SelectedPieceIndex);
+                RecordEdit(MakeEdit(PieceEditType::FLIP, m_SelectedPieceIndex));
+                LOG_INFO(GAME, "Flipped piece");
             }
             break;
         }
         
         case GLFW_KEY_R: {
-            if (m_SelectedPiece != nullptr && !m_SelectedPiece->IsLocked()) {
+            if (m_SelectedPiece != nullptr && !m_Board.isLocked[m_SelectedPieceIndex]) {
                 float rotationAngle = glm::radians(45.0f);  // 45 degrees in radians
-                m_SelectedPiece->Rotate(rotationAngle);
-                std::cout << "Rotated piece by 45 degrees" << std::endl;
+                m_Board.rotation[m_SelectedPieceIndex] += rotationAngle;
+                SyncPiece(m_SelectedPieceIndex);
+                PieceEdit edit = MakeEdit(PieceEditType::ROTATE, m_SelectedPieceIndex);
+                edit.angle = rotationAngle;
+                RecordEdit(edit);
+                LOG_INFO(GAME, "Rotated piece by 45 degrees");
             }
             break;
         }
         
         case GLFW_KEY_Z: {
+            if (mods & GLFW_MOD_CONTROL) {
+                if (mods & GLFW_MOD_SHIFT) {
+                    Redo();
+                } else {
+                    Undo();
+                }
+                break;
+            }
             m_ZoomLevel *= 1.2f;
             if (m_ZoomLevel > 10.0f) m_ZoomLevel = 10.0f;
             UpdateViewMatrix();
-            std::cout << "Zoomed in. Zoom level: " << m_ZoomLevel << std::endl;
+            LOG_INFO(GAME, "Zoomed in. Zoom level: " << m_ZoomLevel);
             break;
         }
         
@@ -310,151 +439,204 @@ void GameLayer::OnKeyEvent(int key, int /*scancode*/, int action, int mods) {
             m_ZoomLevel /= 1.2f;
             if (m_ZoomLevel < 0.1f) m_ZoomLevel = 0.1f;
             UpdateViewMatrix();
-            std::cout << "Zoomed out. Zoom level: " << m_ZoomLevel << std::endl;
+            LOG_INFO(GAME, "Zoomed out. Zoom level: " << m_ZoomLevel);
             break;
         }
         
         case GLFW_KEY_SPACE: {
-            GLFWwindow* window = m_WindowContext->GetWindow();
-            double mouseX, mouseY;
-            glfwGetCursorPos(window, &mouseX, &mouseY);
             m_IsPanning = true;
-            m_LastPanMouseX = mouseX;
-            m_LastPanMouseY = mouseY;
-            std::cout << "Panning mode activated (drag mouse)" << std::endl;
+            m_LastPanMouseX = m_CursorX;
+            m_LastPanMouseY = m_CursorY;
+            LOG_INFO(GAME, "Panning mode activated (drag mouse)");
+            break;
+        }
+        
+        case GLFW_KEY_Y: {
+            if (mods & GLFW_MOD_CONTROL) {
+                Redo();
+            }
+            break;
+        }
+        
+        case GLFW_KEY_M: {
+            m_IsMagnetEnabled = !m_IsMagnetEnabled;
+            LOG_INFO(GAME, "Magnetic snapping " << (m_IsMagnetEnabled ? "enabled" : "disabled"));
             break;
         }
         
         case GLFW_KEY_C: {
             if (CheckSolution()) {
-                std::cout << "CONGRATULATIONS! Level completed!" << std::endl;
+                LOG_INFO(GAME, "CONGRATULATIONS! Level completed!");
                 m_GameState = GameState::COMPLETED;
             } else {
-                std::cout << "Not quite right yet. Keep trying!" << std::endl;
+                LOG_INFO(GAME, "Not quite right yet. Keep trying!");
             }
             break;
         }
         
         case GLFW_KEY_P: {
             // Print current piece positions in C++ format for solution
-            std::cout << "\n=== CURRENT PIECE POSITIONS ===" << std::endl;
-            std::cout << "std::vector<PiecePosition> solution = {" << std::endl;
-            const char* names[] = {"LT-Red", "LT-Green", "MT-Blue", "ST-Yellow", "ST-Magenta", "Sq-Cyan", "Para-Orange"};
-            for (size_t i = 0; i < m_Pieces.size(); ++i) {
-                glm::vec2 center = m_Pieces[i]->GetCenter();
-                float rotation = m_Pieces[i]->GetRotation();
-                bool flipped = m_Pieces[i]->IsFlipped();
-                
-                std::cout << "    // " << names[i] << std::endl;
-                std::cout << "    {" << i << ", glm::vec2(" << center.x << "f, " << center.y << "f), "
-                          << "glm::radians(" << glm::degrees(rotation) << "f), " 
-                          << (flipped ? "true" : "false") << "}";
-                if (i < m_Pieces.size() - 1) std::cout << ",";
-                std::cout << std::endl;
+            std::vector<PiecePosition> positions;
+            for (int i = 0; i < m_Board.count; ++i) {
+                positions.push_back({i, m_Board.GetPosition(i), m_Board.rotation[i], m_Board.isFlipped[i]});
+            }
+            PrintPositions("CURRENT PIECE POSITIONS", positions);
+            break;
+        }
+        
+        case GLFW_KEY_H: {
+            // Searched over the next frames; ReportHint prints it once found
+            if (m_Board.CountLocked() == m_Board.count) {
+                break;
+            }
+            m_HintEngine.Request(*m_CurrentLevel, m_Board, m_SnapIndex);
+            if (m_HintEngine.IsSearching()) {
+                LOG_INFO(GAME, "Looking for a hint...");
+            } else {
+                ReportHint();
+            }
+            break;
+        }
+        
+        case GLFW_KEY_V: {
+            // Solve the silhouette from scratch; confirms the level is solvable and shows an alternative
+            if (!m_CurrentLevel->IsOnLattice()) {
+                LOG_INFO(GAME, "Level is not on the tangram lattice, cannot solve it");
+                break;
+            }
+            if (!m_CurrentLevel->GetLatticeHoles().empty()) {
+                LOG_INFO(GAME, "The solver only handles silhouettes without holes");
+                break;
+            }
+            if (m_Solver.GetStatus() == SearchStatus::RUNNING) {
+                LOG_INFO(GAME, "Still solving...");
+                break;
+            }
+            // Searched over the next frames; ReportSolution prints it once found
+            if (m_Solver.Start(m_CurrentLevel->GetLatticeSilhouette(), {}, {})) {
+                LOG_INFO(GAME, "Solving the silhouette...");
+            } else {
+                ReportSolution();
             }
-            std::cout << "};" << std::endl;
-            std::cout << "================================\n" << std::endl;
             break;
         }
     }
 }
 
+void GameLayer::PrintPositions(const char* title, const std::vector<PiecePosition>& positions) {
+    LOG_INFO(GAME, "\n=== " << title << " ===");
+    LOG_INFO(GAME, "std::vector<PiecePosition> solution = {");
+    const char* names[] = {"LT-Red", "LT-Green", "MT-Blue", "ST-Yellow", "ST-Magenta", "Sq-Cyan", "Para-Orange"};
+    for (size_t i = 0; i < positions.size(); ++i) {
+        const PiecePosition& current = positions[i];
+        
+        LOG_INFO(GAME, "    // " << names[current.pieceIndex]);
+        // One message per line, so the entry and its lattice comment stay together
+        LogMessage line(LogLevel::INFO, LogCategory::GAME);
+        line.GetStream() << "    {" << current.pieceIndex << ", glm::vec2(" << current.position.x << "f, " << current.position.y << "f), "
+                  << "glm::radians(" << glm::degrees(current.rotation) << "f), " 
+                  << (current.isFlipped ? "true" : "false") << "}";
+        if (i < positions.size() - 1) line.GetStream() << ",";
+        
+        // Report the exact lattice pose too, so captured levels can be checked for drift
+        LatticePose pose;
+        if (ToLatticePose(GetPieceTypeForIndex(current.pieceIndex), current, LATTICE_TOLERANCE, pose)) {
+            line.GetStream() << "  // lattice: anchor ((" << pose.anchor.x.a << " + " << pose.anchor.x.b << "r)/4, ("
+                      << pose.anchor.y.a << " + " << pose.anchor.y.b << "r)/4) rotation " << pose.rotation * 45;
+        } else {
+            line.GetStream() << "  // off lattice";
+        }
+    }
+    LOG_INFO(GAME, "};");
+    LOG_INFO(GAME, "================================\n");
+}
+
 void GameLayer::OnMouseButtonEvent(int button, int action, int mods, double mouseX, double mouseY) {
     float worldX, worldY;
     ConvertScreenToWorld(mouseX, mouseY, worldX, worldY);
     
+#if TANGRAM_LOG_LEVEL <= 0
     if (action == GLFW_PRESS && button == GLFW_MOUSE_BUTTON_LEFT) {
         float ndcX, ndcY;
         ConvertScreenToNDC(mouseX, mouseY, ndcX, ndcY);
-        std::cout << "DEBUG: Mouse Click - Screen(" << mouseX << ", " << mouseY << ")"
+        LOG_DEBUG(GAME, "Mouse Click - Screen(" << mouseX << ", " << mouseY << ")"
                   << " NDC(" << ndcX << ", " << ndcY << ")"
-                  << " World(" << worldX << ", " << worldY << ")" << std::endl;
+                  << " World(" << worldX << ", " << worldY << ")");
     }
+#endif
     
     if (action == GLFW_RELEASE) {
         if (m_IsTranslating) {
             m_IsTranslating = false;
+            m_MagnetOffset = glm::vec2(0.0f, 0.0f);
+            RefreshCollisionShape(m_SelectedPieceIndex);
+            
+            // The drag and the snap ending it undo together
+            int piece = m_SelectedPieceIndex;
+            m_EditLog.BeginGroup();
             
             // Target-based Snapping Logic
-            if (m_SelectedPiece != nullptr && !m_SelectedPiece->IsLocked()) {
-                int pieceIndex = -1;
-                for (size_t i = 0; i < m_Pieces.size(); ++i) {
-                    if (m_Pieces[i] == m_SelectedPiece) {
-                        pieceIndex = i;
-                        break;
-                    }
-                }
+            if (m_SelectedPiece != nullptr && !m_Board.isLocked[piece]) {
+                glm::vec2 currentCenter = m_Board.GetPosition(piece);
+                
+                // Relaxed tolerances for easier gameplay
+                float distanceTolerance = 0.25f;  // Only check distance!
                 
-                if (pieceIndex != -1) {
-                    // Find the target position for this piece
-                    const auto& solution = m_CurrentLevel->GetSolution();
-                    const PiecePosition* targetPos = nullptr;
+                // Any free slot of the same type is a valid target, e.g. either large triangle
+                // can fill either large triangle slot
+                int slotIndex = m_SnapIndex.FindNearestFreeSlot(m_Board.type[piece], currentCenter, distanceTolerance);
+                
+                if (slotIndex != -1) {
+                    const SnapSlot& slot = m_SnapIndex.GetSlots()[slotIndex];
+                    bool flipped = m_Board.isFlipped[piece];
+                    float rotation = 0.0f;
                     
-                    for (const auto& target : solution) {
-                        if (target.pieceIndex == pieceIndex) {
-                            targetPos = &target;
-                            break;
-                        }
+                    // Keep the player's flip state when the piece symmetry allows it,
+                    // otherwise auto-correct the flip to the target's
+                    if (!m_SnapIndex.GetEquivalentRotation(slotIndex, flipped, m_Board.rotation[piece], rotation)) {
+                        flipped = slot.isFlipped;
+                        m_SnapIndex.GetEquivalentRotation(slotIndex, flipped, m_Board.rotation[piece], rotation);
                     }
                     
-                    if (targetPos != nullptr) {
-                        glm::vec2 currentCenter = m_SelectedPiece->GetCenter();
-                        float currentRotation = m_SelectedPiece->GetRotation();
-                        bool currentFlipped = m_SelectedPiece->IsFlipped();
-                        
-                        // Check distance threshold (0.1f as suggested)
-                        float distance = glm::distance(currentCenter, targetPos->position);
-                        
-                        // Normalize rotations to [0, 2π) for comparison
-                        float normalizedCurrent = fmod(currentRotation, 2.0f * M_PI);
-                        if (normalizedCurrent < 0) normalizedCurrent += 2.0f * M_PI;
-                        
-                        float normalizedTarget = fmod(targetPos->rotation, 2.0f * M_PI);
-                        if (normalizedTarget < 0) normalizedTarget += 2.0f * M_PI;
-                        
-                        // Check rotation difference (allowing for ±5 degrees = ~0.087 radians)
-                        float rotationDiff = fabs(normalizedCurrent - normalizedTarget);
-                        // Handle wrap-around (e.g., 359° vs 1°)
-                        if (rotationDiff > M_PI) {
-                            rotationDiff = 2.0f * M_PI - rotationDiff;
-                        }
-                        
-                        // Relaxed tolerances for easier gameplay
-                        float distanceTolerance = 0.25f;  // Only check distance!
-                        
-                        // Debug output
-                        std::cout << "Piece " << pieceIndex << " - Distance: " << distance 
-                                  << " (threshold: " << distanceTolerance << ")"
-                                  << std::endl;
-                        
-                        // ONLY check position - auto-correct rotation and flip!
-                        if (distance < distanceTolerance) {
-                            
-                            // Snap to exact target position
-                            glm::vec2 offset = targetPos->position - currentCenter;
-                            m_SelectedPiece->Translate(offset.x, offset.y);
-                            
-                            // Auto-correct rotation to exact target
-                            float rotationAdjustment = targetPos->rotation - currentRotation;
-                            // Normalize to shortest path
-                            while (rotationAdjustment > M_PI) rotationAdjustment -= 2.0f * M_PI;
-                            while (rotationAdjustment < -M_PI) rotationAdjustment += 2.0f * M_PI;
-                            m_SelectedPiece->Rotate(rotationAdjustment);
-                            
-                            // Auto-correct flip state if needed
-                            if (currentFlipped != targetPos->isFlipped) {
-                                m_SelectedPiece->Flip();
-                            }
-                            
-                            // Lock the piece and change color to green
-                            m_SelectedPiece->SetLocked(true);
-                            m_SelectedPiece->SetColor(0.0f, 1.0f, 0.0f);  // Green
-                            
-                            std::cout << "Piece " << pieceIndex << " locked in place! (auto-corrected rotation and flip)" << std::endl;
-                        }
+                    PieceEdit turn = MakeEdit(PieceEditType::ROTATE, piece);
+                    turn.angle = rotation - m_Board.rotation[piece];
+                    PieceEdit paint = MakeEdit(PieceEditType::COLOR, piece);
+                    paint.fromColor = m_Board.GetColor(piece);
+                    paint.toColor = glm::vec3(0.0f, 1.0f, 0.0f);
+                    PieceEdit lock = MakeEdit(PieceEditType::LOCK, piece);
+                    lock.slot = slotIndex;
+                    if (turn.angle != 0.0f) {
+                        RecordEdit(turn);
+                    }
+                    if (flipped != m_Board.isFlipped[piece]) {
+                        RecordEdit(MakeEdit(PieceEditType::FLIP, piece));
                     }
+                    RecordEdit(paint);
+                    RecordEdit(lock);
+                    
+                    // Snap to exact target position, rotation and flip, lock the piece and turn it green
+                    m_Board.SetPosition(piece, slot.position);
+                    m_Board.rotation[piece] = rotation;
+                    m_Board.isFlipped[piece] = flipped;
+                    m_Board.isLocked[piece] = true;
+                    m_Board.SetColor(piece, glm::vec3(0.0f, 1.0f, 0.0f));
+                    SyncPiece(piece);
+                    m_SnapIndex.Occupy(slotIndex, piece);
+                    m_HintEngine.Cancel();
+                    
+                    LOG_INFO(GAME, "Piece " << piece << " locked in place! (slot of piece "
+                              << slot.targetPieceIndex << ", distance: "
+                              << glm::distance(currentCenter, slot.position) << ")");
                 }
             }
+            
+            glm::vec2 offset = m_Board.GetPosition(piece) - m_DragStartPosition;
+            if (offset != glm::vec2(0.0f, 0.0f)) {
+                PieceEdit move = MakeEdit(PieceEditType::TRANSLATE, piece);
+                move.offset = offset;
+                RecordEdit(move);
+            }
+            m_EditLog.EndGroup();
         }
         if (button == GLFW_MOUSE_BUTTON_MIDDLE && m_IsPanning) {
             m_IsPanning = false;
@@ -463,9 +645,6 @@ void GameLayer::OnMouseButtonEvent(int button, int action, int mods, double mous
     
     if (button == GLFW_MOUSE_BUTTON_MIDDLE && action == GLFW_PRESS) {
         m_IsPanning = true;
-        double mouseX, mouseY;
-        GLFWwindow* window = m_WindowContext->GetWindow();
-        glfwGetCursorPos(window, &mouseX, &mouseY);
         m_LastPanMouseX = mouseX;
         m_LastPanMouseY = mouseY;
         return;
@@ -473,6 +652,7 @@ void GameLayer::OnMouseButtonEvent(int button, int action, int mods, double mous
     
     if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_PRESS) {
         m_SelectedPiece = nullptr;
+        m_SelectedPieceIndex = -1;
         
         // Check pieces in reverse order (top to bottom in rendering)
         for (int i = m_Pieces.size() - 1; i >= 0; i--) {
@@ -483,7 +663,8 @@ void GameLayer::OnMouseButtonEvent(int button, int action, int mods, double mous
             
             if (m_Pieces[i]->IsInside(localPoint.x, localPoint.y)) {
                 m_SelectedPiece = m_Pieces[i];
-                std::cout << "Selected piece " << i << std::endl;
+                m_SelectedPieceIndex = i;
+                LOG_INFO(GAME, "Selected piece " << i);
                 break;
             }
         }
@@ -492,29 +673,225 @@ void GameLayer::OnMouseButtonEvent(int button, int action, int mods, double mous
             m_IsTranslating = true;
             m_LastMouseX = worldX;
             m_LastMouseY = worldY;
+            m_MagnetOffset = glm::vec2(0.0f, 0.0f);
+            m_DragStartPosition = m_Board.GetPosition(m_SelectedPieceIndex);
+            BeginDragCollision();
         }
     }
 }
 
 void GameLayer::ResetLevel() {
-    for (TangramPiece* piece : m_Pieces) {
-        piece->ResetToOriginal();
+    m_Board = m_InitialBoard;
+    m_PreviousBoard = m_Board;
+    for (int i = 0; i < m_Board.count; ++i) {
+        SyncPiece(i);
     }
+    m_SnapIndex.ClearOccupancy();
+    m_HintEngine.Cancel();
+    m_EditLog.Clear();
     m_GameState = GameState::PLAYING;
     m_SelectedPiece = nullptr;
+    m_SelectedPieceIndex = -1;
 }
 
-bool GameLayer::CheckSolution() {
-    // Check if all 7 pieces are locked (correctly placed)
-    // With the new snapping system, pieces only lock when they're in the correct position
+uint64_t GameLayer::GetStateHash() const {
+    // Field by field: the arrays past count are never written
+    size_t count = (size_t)m_Board.count;
+    uint64_t hash = HashLevelBytes(&m_Board.count, sizeof(m_Board.count));
+    hash = HashLevelBytes(m_Board.positionX, count * sizeof(float), hash);
+    hash = HashLevelBytes(m_Board.positionY, count * sizeof(float), hash);
+    hash = HashLevelBytes(m_Board.rotation, count * sizeof(float), hash);
+    hash = HashLevelBytes(m_Board.isFlipped, count * sizeof(bool), hash);
+    hash = HashLevelBytes(m_Board.isLocked, count * sizeof(bool), hash);
+    hash = HashLevelBytes(m_Board.colorR, count * sizeof(float), hash);
+    hash = HashLevelBytes(m_Board.colorG, count * sizeof(float), hash);
+    hash = HashLevelBytes(m_Board.colorB, count * sizeof(float), hash);
+    return HashLevelBytes(&m_GameState, sizeof(m_GameState), hash);
+}
+
+void GameLayer::ApplyEdit(const PieceEdit& edit, bool isUndo) {
+    int piece = edit.piece;
+    switch (edit.type) {
+        case PieceEditType::TRANSLATE:
+            m_Board.Translate(piece, isUndo ? -edit.offset : edit.offset);
+            break;
+        case PieceEditType::ROTATE:
+            m_Board.rotation[piece] += isUndo ? -edit.angle : edit.angle;
+            break;
+        case PieceEditType::FLIP:
+            m_Board.isFlipped[piece] = !m_Board.isFlipped[piece];
+            break;
+        case PieceEditType::LOCK:
+            m_Board.isLocked[piece] = !isUndo;
+            m_SnapIndex.Occupy(edit.slot, isUndo ? -1 : piece);
+            break;
+        case PieceEditType::COLOR:
+            m_Board.SetColor(piece, isUndo ? edit.fromColor : edit.toColor);
+            break;
+    }
+    SyncPiece(piece);
+}
+
+void GameLayer::Undo() {
+    // A drag in progress is not in the history yet
+    if (m_IsTranslating) {
+        return;
+    }
+    if (m_EditLog.Undo([this](const PieceEdit& edit) { ApplyEdit(edit, true); })) {
+        m_HintEngine.Cancel();
+        LOG_INFO(GAME, "Undone (" << m_EditLog.GetUndoCount() << " more to undo)");
+    } else {
+        LOG_INFO(GAME, "Nothing to undo");
+    }
+}
+
+void GameLayer::Redo() {
+    if (m_IsTranslating) {
+        return;
+    }
+    if (m_EditLog.Redo([this](const PieceEdit& edit) { ApplyEdit(edit, false); })) {
+        m_HintEngine.Cancel();
+        LOG_INFO(GAME, "Redone (" << m_EditLog.GetRedoCount() << " more to redo)");
+    } else {
+        LOG_INFO(GAME, "Nothing to redo");
+    }
+}
+
+void GameLayer::SyncPiece(int pieceIndex) {
+    // SetPose rebuilds the model matrix from scratch, so board and piece cannot drift apart
+    TangramPiece* piece = m_Pieces[pieceIndex];
+    piece->SetPose(m_Board.GetPosition(pieceIndex), m_Board.rotation[pieceIndex], m_Board.isFlipped[pieceIndex]);
+    piece->SetLocked(m_Board.isLocked[pieceIndex]);
+    RefreshCollisionShape(pieceIndex);
+}
+
+void GameLayer::RefreshCollisionShape(int pieceIndex) {
+    if (pieceIndex >= 0 && pieceIndex < (int)m_Pieces.size()) {
+        m_CollisionShapes[pieceIndex].Update(*m_Pieces[pieceIndex]);
+        m_MagnetGrid.Update(m_Pieces[pieceIndex], m_CollisionShapes[pieceIndex].GetVertices());
+    }
+}
+
+void GameLayer::BeginDragCollision() {
+    // The starting layout may already overlap; those pairs are allowed to be dragged apart
+    const CollisionShape& dragged = m_CollisionShapes[m_SelectedPieceIndex];
+    glm::vec2 push;
+    for (size_t i = 0; i < m_Pieces.size(); ++i) {
+        m_IgnoreCollision[i] = (int)i != m_SelectedPieceIndex &&
+                               dragged.BoundsOverlap(m_CollisionShapes[i]) &&
+                               dragged.Overlaps(m_CollisionShapes[i], push);
+    }
+}
+
+glm::vec2 GameLayer::ResolveDragCollision(const glm::vec2& delta) {
+    if (m_Board.isLocked[m_SelectedPieceIndex]) {
+        return glm::vec2(0.0f, 0.0f);
+    }
     
-    int lockedCount = 0;
-    for (TangramPiece* piece : m_Pieces) {
-        if (piece->IsLocked()) {
-            lockedCount++;
+    CollisionShape& dragged = m_CollisionShapes[m_SelectedPieceIndex];
+    dragged.Translate(delta);
+    glm::vec2 resolved = delta;
+    
+    // Push the piece out of every piece it hits; the push is along the contact normal,
+    // so the tangential part of the move survives and the piece slides. A push can land in
+    // another piece, so passes repeat until one finds nothing; the last pass only checks
+    const int maxPushPasses = 4;
+    bool isColliding = true;
+    for (int pass = 0; pass <= maxPushPasses && isColliding; ++pass) {
+        isColliding = false;
+        for (size_t i = 0; i < m_Pieces.size(); ++i) {
+            if ((int)i == m_SelectedPieceIndex) {
+                continue;
+            }
+            
+            glm::vec2 push;
+            if (!dragged.BoundsOverlap(m_CollisionShapes[i]) || !dragged.Overlaps(m_CollisionShapes[i], push)) {
+                m_IgnoreCollision[i] = false;  // Separated, so it blocks from now on
+                continue;
+            }
+            if (m_IgnoreCollision[i]) {
+                continue;
+            }
+            
+            isColliding = true;
+            if (pass == maxPushPasses) {
+                break;
+            }
+            dragged.Translate(push);
+            resolved += push;
+        }
+    }
+    
+    // Wedged between pieces: block the move entirely
+    if (isColliding) {
+        dragged.Translate(-resolved);
+        return glm::vec2(0.0f, 0.0f);
+    }
+    
+    return resolved;
+}
+
+glm::vec2 GameLayer::ApplyMagnet(const glm::vec2& delta) {
+    // Test where the mouse alone would put the piece, so the previous pull never accumulates
+    glm::vec2 unpulled = delta - m_MagnetOffset;
+    m_MagnetOutline = m_CollisionShapes[m_SelectedPieceIndex].GetVertices();
+    for (glm::vec2& vertex : m_MagnetOutline) {
+        vertex += unpulled;
+    }
+    
+    glm::vec2 offset(0.0f, 0.0f);
+    std::vector<const Shape*> ignored(1, m_SelectedPiece);
+    if (!m_MagnetGrid.FindSnap(m_MagnetOutline, ignored, MAGNET_RADIUS, offset)) {
+        offset = glm::vec2(0.0f, 0.0f);
+    }
+    
+    m_MagnetOffset = offset;
+    return unpulled + offset;
+}
+
+void GameLayer::ReportSolution() {
+    if (m_Solver.GetStatus() != SearchStatus::SOLVED) {
+        LOG_INFO(GAME, "No tiling found for this silhouette");
+        LOG_INFO(GAME, "Search visited " << m_Solver.GetNodesVisited() << " nodes");
+        return;
+    }
+    
+    // Placements come in search order; each goes to the first free piece of its type
+    std::vector<PiecePosition> solution;
+    bool isUsed[BoardState::MAX_PIECES] = {};
+    for (const LatticePlacement& placement : m_Solver.GetPlacements()) {
+        for (int i = 0; i < BoardState::MAX_PIECES; ++i) {
+            if (!isUsed[i] && GetPieceTypeForIndex(i) == placement.type) {
+                isUsed[i] = true;
+                solution.push_back(ToPiecePosition(placement.type, i, placement.pose));
+                break;
+            }
         }
     }
+    std::sort(solution.begin(), solution.end(), [](const PiecePosition& a, const PiecePosition& b) {
+        return a.pieceIndex < b.pieceIndex;
+    });
     
-    // All 7 pieces must be locked
-    return lockedCount == 7;
+    PrintPositions("SOLVER SOLUTION", solution);
+    LOG_INFO(GAME, "Search visited " << m_Solver.GetNodesVisited() << " nodes");
+}
+
+void GameLayer::ReportHint() {
+    if (!m_HintEngine.HasHint()) {
+        LOG_INFO(GAME, "No hint available");
+        return;
+    }
+    
+    const Hint& hint = m_HintEngine.GetHint();
+    const char* names[] = {"LT-Red", "LT-Green", "MT-Blue", "ST-Yellow", "ST-Magenta", "Sq-Cyan", "Para-Orange"};
+    LOG_INFO(GAME, "Hint: move " << names[hint.pieceIndex] << " to (" << hint.target.position.x << ", "
+              << hint.target.position.y << "), rotation " << glm::degrees(hint.target.rotation)
+              << (hint.target.isFlipped ? ", flipped" : "") << " (searched "
+              << m_HintEngine.GetNodesVisited() << " nodes)");
+}
+
+bool GameLayer::CheckSolution() {
+    // Check if all 7 pieces are locked (correctly placed)
+    // With the new snapping system, pieces only lock when they're in the correct position
+    return m_Board.count == 7 && m_Board.CountLocked() == 7;
 }
@@ -0,0 +1,139 @@
+#include "HintEngine.h"
+#include "PieceGeometry.h"
+#include <limits>
+
+HintEngine::HintEngine()
+    : m_SnapIndex(nullptr)
+    , m_IsSearching(false)
+    , m_HasHint(false)
+    , m_Hint({-1, -1, PiecePosition()}) {
+}
+
+void HintEngine::Request(const Level& level, const BoardState& board, const SnapIndex& snapIndex) {
+    Cancel();
+    m_Board = board;
+    m_SnapIndex = &snapIndex;
+
+    // Slot poses come from the exact solution, not from their float copies: a float pose can
+    // round to a different lattice point within tolerance. Locked pieces cover their slot
+    // exactly, so occupied slots are the fixed pieces and free ones the preferred placements
+    m_FreeSlotPlacements.clear();
+    m_FreeSlots.clear();
+    std::vector<LatticePlacement> fixed;
+    const std::vector<SnapSlot>& slots = snapIndex.GetSlots();
+    const std::vector<PiecePosition>& solution = level.GetSolution();
+    bool isExact = level.IsOnLattice() && level.GetLatticeHoles().empty();
+    for (size_t i = 0; i < slots.size() && isExact; ++i) {
+        const SnapSlot& slot = slots[i];
+        size_t target = 0;
+        while (target < solution.size() && solution[target].pieceIndex != slot.targetPieceIndex) {
+            ++target;
+        }
+        isExact = target < solution.size();
+        if (!isExact) {
+            break;
+        }
+
+        LatticePlacement placement = {slot.type, level.GetLatticeSolution()[target]};
+        if (slot.occupant == -1) {
+            m_FreeSlotPlacements.push_back(placement);
+            m_FreeSlots.push_back(i);
+        } else {
+            fixed.push_back(placement);
+        }
+    }
+
+    if (isExact && m_Solver.Start(level.GetLatticeSilhouette(), fixed, m_FreeSlotPlacements)) {
+        m_IsSearching = true;
+        return;
+    }
+
+    m_HasHint = MakeNearestHint();
+}
+
+void HintEngine::Cancel() {
+    m_IsSearching = false;
+    m_HasHint = false;
+}
+
+bool HintEngine::Update(std::chrono::steady_clock::duration budget) {
+    if (!m_IsSearching) {
+        return false;
+    }
+    SearchStatus status = m_Solver.Step(budget);
+    if (status == SearchStatus::RUNNING) {
+        return false;
+    }
+    m_IsSearching = false;
+
+    // The first placement the game accepts; with the slots preferred, normally the first one
+    if (status == SearchStatus::SOLVED) {
+        for (const LatticePlacement& placement : m_Solver.GetPlacements()) {
+            int slotIndex = FindSlot(placement);
+            if (slotIndex != -1 && MakeHint(slotIndex)) {
+                m_HasHint = true;
+                return true;
+            }
+        }
+    }
+    // Silhouettes the stored solution does not tile exactly still have their slots
+    m_HasHint = MakeNearestHint();
+    return true;
+}
+
+int HintEngine::FindSlot(const LatticePlacement& placement) const {
+    for (size_t i = 0; i < m_FreeSlotPlacements.size(); ++i) {
+        const LatticePlacement& slot = m_FreeSlotPlacements[i];
+        if (slot.type == placement.type && IsSamePlacement(slot.type, slot.pose, placement.pose)) {
+            return m_FreeSlots[i];
+        }
+    }
+    return -1;
+}
+
+bool HintEngine::MakeNearestHint() {
+    // The closest pair of unlocked piece and free slot of its type
+    int bestSlot = -1;
+    float bestDistance = std::numeric_limits<float>::max();
+    for (int i = 0; i < m_Board.count; ++i) {
+        if (m_Board.isLocked[i]) {
+            continue;
+        }
+        int slotIndex = m_SnapIndex->FindNearestFreeSlot(m_Board.type[i], m_Board.GetPosition(i), bestDistance);
+        if (slotIndex != -1) {
+            bestDistance = glm::distance(m_Board.GetPosition(i), m_SnapIndex->GetSlots()[slotIndex].position);
+            bestSlot = slotIndex;
+        }
+    }
+    return bestSlot != -1 && MakeHint(bestSlot);
+}
+
+bool HintEngine::MakeHint(int slotIndex) {
+    const SnapSlot& slot = m_SnapIndex->GetSlots()[slotIndex];
+
+    int bestPiece = -1;
+    float bestDistance = std::numeric_limits<float>::max();
+    for (int i = 0; i < m_Board.count; ++i) {
+        float distance = glm::distance(m_Board.GetPosition(i), slot.position);
+        if (!m_Board.isLocked[i] && m_Board.type[i] == slot.type && distance < bestDistance) {
+            bestDistance = distance;
+            bestPiece = i;
+        }
+    }
+    if (bestPiece == -1) {
+        return false;
+    }
+
+    // Same pose correction as snapping: keep the piece's flip when its symmetry allows it
+    bool flipped = m_Board.isFlipped[bestPiece];
+    float rotation = 0.0f;
+    if (!m_SnapIndex->GetEquivalentRotation(slotIndex, flipped, m_Board.rotation[bestPiece], rotation)) {
+        flipped = slot.isFlipped;
+        m_SnapIndex->GetEquivalentRotation(slotIndex, flipped, m_Board.rotation[bestPiece], rotation);
+    }
+
+    m_Hint.pieceIndex = bestPiece;
+    m_Hint.slotIndex = slotIndex;
+    m_Hint.target = {bestPiece, slot.position, rotation, flipped};
+    return true;
+}
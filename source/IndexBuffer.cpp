@@ -1,17 +1,59 @@
 #include "IndexBuffer.h"
 #include "BufferLayout.h"
+#include <algorithm>
+#include <vector>
 
-IndexBuffer::IndexBuffer(const unsigned int* data, unsigned int count) : m_Count(count){
+//Scratch kept between uploads up to this size; a larger one is released after its upload
+static const size_t MAX_KEPT_STAGING_BYTES = 64 * 1024;
+
+//Narrowed copy of the indices, shared by every buffer uploading on this thread
+static thread_local std::vector<unsigned char> s_Staging;
+
+template <typename T>
+static void NarrowIndices(const unsigned int* data, unsigned int count, std::vector<unsigned char>& staging){
+	staging.resize(sizeof(T) * count);
+	T* out = reinterpret_cast<T*>(staging.data());
+	for (unsigned int i = 0; i < count; i++) {
+		out[i] = (T)data[i];
+	}
+}
+
+IndexBuffer::IndexBuffer(const unsigned int* data, unsigned int count) : m_Count(count), m_IndexType(GL_UNSIGNED_INT){
 
 	glGenBuffers(1, &m_EBOId);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBOId);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned int)*count, data, GL_STATIC_DRAW);
+	Upload(data, count);
 };
 
 void IndexBuffer::SetData(const unsigned int* data, unsigned int count){
     m_Count = count;
+	Upload(data, count);
+}
+
+void IndexBuffer::Upload(const unsigned int* data, unsigned int count){
+	unsigned int maxIndex = (count > 0) ? *std::max_element(data, data + count) : 0;
+
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBOId);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned int)*count, data, GL_STATIC_DRAW);
+
+	//Small meshes (every shape but large polygons) fit in 8 or 16 bits, a 2-4x smaller upload
+	if (maxIndex <= 0xFF) {
+		m_IndexType = GL_UNSIGNED_BYTE;
+		NarrowIndices<unsigned char>(data, count, s_Staging);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, s_Staging.size(), s_Staging.data(), GL_STATIC_DRAW);
+	}
+	else if (maxIndex <= 0xFFFF) {
+		m_IndexType = GL_UNSIGNED_SHORT;
+		NarrowIndices<unsigned short>(data, count, s_Staging);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, s_Staging.size(), s_Staging.data(), GL_STATIC_DRAW);
+	}
+	else {
+		m_IndexType = GL_UNSIGNED_INT;
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned int)*count, data, GL_STATIC_DRAW);
+	}
+
+	//GL has its own copy now
+	if (s_Staging.capacity() > MAX_KEPT_STAGING_BYTES) {
+		std::vector<unsigned char>().swap(s_Staging);
+	}
 }
 
 IndexBuffer::~IndexBuffer(){
@@ -29,3 +71,7 @@ void IndexBuffer::Unbind() const {
 unsigned int IndexBuffer::GetCount() const{
 	return m_Count;
 }
+
+unsigned int IndexBuffer::GetIndexType() const{
+	return m_IndexType;
+}
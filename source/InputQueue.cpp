@@ -0,0 +1,77 @@
+#include "InputQueue.h"
+
+InputQueue::InputQueue()
+    : m_Head(0)
+    , m_Count(0)
+    , m_CursorX(0.0)
+    , m_CursorY(0.0)
+    , m_CoalescedCount(0)
+    , m_DroppedCount(0) {
+}
+
+void InputQueue::PushKey(int key, int scancode, int action, int mods, double time) {
+    Push({InputEventType::KEY, key, scancode, action, mods, m_CursorX, m_CursorY, time});
+}
+
+void InputQueue::PushMouseButton(int button, int action, int mods, double time) {
+    Push({InputEventType::MOUSE_BUTTON, button, 0, action, mods, m_CursorX, m_CursorY, time});
+}
+
+void InputQueue::PushCursorMove(double x, double y, double time) {
+    m_CursorX = x;
+    m_CursorY = y;
+
+    // Only where the cursor ended up matters, and when it got there
+    InputEvent* last = GetLast();
+    if (last != nullptr && last->type == InputEventType::CURSOR_MOVE) {
+        last->x = x;
+        last->y = y;
+        last->time = time;
+        ++m_CoalescedCount;
+        return;
+    }
+    Push({InputEventType::CURSOR_MOVE, 0, 0, 0, 0, x, y, time});
+}
+
+void InputQueue::PushScroll(double offsetX, double offsetY, double time) {
+    InputEvent* last = GetLast();
+    if (last != nullptr && last->type == InputEventType::SCROLL) {
+        last->x += offsetX;
+        last->y += offsetY;
+        last->time = time;
+        ++m_CoalescedCount;
+        return;
+    }
+    Push({InputEventType::SCROLL, 0, 0, 0, 0, offsetX, offsetY, time});
+}
+
+void InputQueue::Drain(std::vector<InputEvent>& batch) {
+    batch.clear();
+    for (size_t i = 0; i < m_Count; ++i) {
+        batch.push_back(m_Events[(m_Head + i) % CAPACITY]);
+    }
+    m_Head = 0;
+    m_Count = 0;
+}
+
+void InputQueue::SetCursorPosition(double x, double y) {
+    m_CursorX = x;
+    m_CursorY = y;
+}
+
+void InputQueue::Push(const InputEvent& event) {
+    // Only a frame stalled for hundreds of distinct events gets here; what is queued stays in order
+    if (m_Count == CAPACITY) {
+        ++m_DroppedCount;
+        return;
+    }
+    m_Events[(m_Head + m_Count) % CAPACITY] = event;
+    ++m_Count;
+}
+
+InputEvent* InputQueue::GetLast() {
+    if (m_Count == 0) {
+        return nullptr;
+    }
+    return &m_Events[(m_Head + m_Count - 1) % CAPACITY];
+}
@@ -0,0 +1,237 @@
+#include "InputRecording.h"
+#include "Log.h"
+#include <cstring>
+#include <iterator>
+
+static const char INPUT_RECORDING_MAGIC[4] = {'T', 'G', 'I', 'R'};
+
+// RecordedFrame sizes follow
+static const uint8_t FRAME_HAS_SIZE = 1;
+
+template <typename T>
+static void Append(std::vector<uint8_t>& buffer, T value) {
+    size_t offset = buffer.size();
+    buffer.resize(offset + sizeof(T));
+    std::memcpy(buffer.data() + offset, &value, sizeof(T));
+}
+
+InputRecorder::InputRecorder()
+    : m_LastFrame{0.0, 0, 0, 0, 0}
+    , m_FrameCount(0) {
+}
+
+InputRecorder::~InputRecorder() {
+    Close();
+}
+
+bool InputRecorder::Open(const char* path, double cursorX, double cursorY) {
+    m_File.open(path, std::ios::binary | std::ios::trunc);
+    if (!m_File) {
+        LOG_ERROR(APP, "Input recording: cannot write " << path);
+        return false;
+    }
+
+    InputRecordingHeader header = {};
+    std::memcpy(header.magic, INPUT_RECORDING_MAGIC, sizeof(INPUT_RECORDING_MAGIC));
+    header.version = INPUT_RECORDING_VERSION;
+    header.cursorX = cursorX;
+    header.cursorY = cursorY;
+    m_File.write((const char*)&header, sizeof(header));
+
+    m_LastFrame = {0.0, 0, 0, 0, 0};
+    m_FrameCount = 0;
+    return true;
+}
+
+void InputRecorder::WriteFrame(const RecordedFrame& frame, const std::vector<InputEvent>& events) {
+    if (!m_File.is_open()) {
+        return;
+    }
+
+    bool hasSize = m_FrameCount == 0 ||
+                   frame.windowWidth != m_LastFrame.windowWidth || frame.windowHeight != m_LastFrame.windowHeight ||
+                   frame.framebufferWidth != m_LastFrame.framebufferWidth ||
+                   frame.framebufferHeight != m_LastFrame.framebufferHeight;
+
+    m_Buffer.clear();
+    Append<uint8_t>(m_Buffer, hasSize ? FRAME_HAS_SIZE : 0);
+    Append<double>(m_Buffer, frame.frameTime);
+    if (hasSize) {
+        Append<int32_t>(m_Buffer, frame.windowWidth);
+        Append<int32_t>(m_Buffer, frame.windowHeight);
+        Append<int32_t>(m_Buffer, frame.framebufferWidth);
+        Append<int32_t>(m_Buffer, frame.framebufferHeight);
+    }
+    // A batch never holds more than InputQueue::CAPACITY events
+    Append<uint16_t>(m_Buffer, (uint16_t)events.size());
+
+    for (const InputEvent& event : events) {
+        Append<uint8_t>(m_Buffer, (uint8_t)event.type);
+        switch (event.type) {
+            case InputEventType::KEY:
+                Append<int16_t>(m_Buffer, (int16_t)event.code);
+                Append<int32_t>(m_Buffer, event.scancode);
+                Append<uint8_t>(m_Buffer, (uint8_t)event.action);
+                Append<uint8_t>(m_Buffer, (uint8_t)event.mods);
+                Append<double>(m_Buffer, event.time);
+                break;
+            case InputEventType::MOUSE_BUTTON:
+                Append<uint8_t>(m_Buffer, (uint8_t)event.code);
+                Append<uint8_t>(m_Buffer, (uint8_t)event.action);
+                Append<uint8_t>(m_Buffer, (uint8_t)event.mods);
+                Append<double>(m_Buffer, event.x);
+                Append<double>(m_Buffer, event.y);
+                Append<double>(m_Buffer, event.time);
+                break;
+            case InputEventType::CURSOR_MOVE:
+            case InputEventType::SCROLL:
+                Append<double>(m_Buffer, event.x);
+                Append<double>(m_Buffer, event.y);
+                Append<double>(m_Buffer, event.time);
+                break;
+        }
+    }
+
+    m_File.write((const char*)m_Buffer.data(), m_Buffer.size());
+    m_LastFrame = frame;
+    ++m_FrameCount;
+}
+
+void InputRecorder::Close() {
+    if (!m_File.is_open()) {
+        return;
+    }
+    m_File.close();
+    if (!m_File) {
+        LOG_ERROR(APP, "Input recording: failed writing the recording");
+    }
+}
+
+InputReplay::InputReplay()
+    : m_Position(0)
+    , m_IsOpen(false)
+    , m_Frame{0.0, 0, 0, 0, 0}
+    , m_CursorX(0.0)
+    , m_CursorY(0.0)
+    , m_FrameCount(0)
+    , m_EventCount(0) {
+}
+
+template <typename T>
+bool InputReplay::Read(T& value) {
+    if (m_Data.size() - m_Position < sizeof(T)) {
+        return false;
+    }
+    std::memcpy(&value, m_Data.data() + m_Position, sizeof(T));
+    m_Position += sizeof(T);
+    return true;
+}
+
+bool InputReplay::Open(const char* path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        LOG_ERROR(APP, "Input replay: cannot open " << path);
+        return false;
+    }
+    m_Data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    m_Position = 0;
+
+    InputRecordingHeader header;
+    if (!Read(header) || std::memcmp(header.magic, INPUT_RECORDING_MAGIC, sizeof(INPUT_RECORDING_MAGIC)) != 0) {
+        LOG_ERROR(APP, "Input replay: " << path << " is not an input recording");
+        return false;
+    }
+    if (header.version != INPUT_RECORDING_VERSION) {
+        LOG_ERROR(APP, "Input replay: " << path << " has version " << header.version
+                  << ", expected " << INPUT_RECORDING_VERSION);
+        return false;
+    }
+
+    m_CursorX = header.cursorX;
+    m_CursorY = header.cursorY;
+    m_Frame = {0.0, 0, 0, 0, 0};
+    m_FrameCount = 0;
+    m_EventCount = 0;
+    m_IsOpen = true;
+    return true;
+}
+
+bool InputReplay::ReadFrame(RecordedFrame& frame, std::vector<InputEvent>& events) {
+    events.clear();
+    if (!m_IsOpen || m_Position == m_Data.size()) {
+        return false;
+    }
+
+    // A recording cut off by a crash ends at its last complete frame
+    size_t frameStart = m_Position;
+    uint8_t flags;
+    uint16_t eventCount;
+    bool isComplete = Read(flags) && Read(m_Frame.frameTime);
+    if (isComplete && (flags & FRAME_HAS_SIZE)) {
+        int32_t sizes[4] = {};
+        isComplete = Read(sizes);
+        m_Frame.windowWidth = sizes[0];
+        m_Frame.windowHeight = sizes[1];
+        m_Frame.framebufferWidth = sizes[2];
+        m_Frame.framebufferHeight = sizes[3];
+    }
+    isComplete = isComplete && Read(eventCount);
+
+    double cursorX = m_CursorX;
+    double cursorY = m_CursorY;
+    for (uint16_t i = 0; isComplete && i < eventCount; ++i) {
+        uint8_t type;
+        if (!Read(type) || type > (uint8_t)InputEventType::SCROLL) {
+            isComplete = false;
+            break;
+        }
+        InputEvent event = {(InputEventType)type, 0, 0, 0, 0, cursorX, cursorY, 0.0};
+        switch (event.type) {
+            case InputEventType::KEY: {
+                int16_t key = 0;
+                int32_t scancode = 0;
+                uint8_t action = 0, mods = 0;
+                isComplete = Read(key) && Read(scancode) && Read(action) && Read(mods) && Read(event.time);
+                event.code = key;
+                event.scancode = scancode;
+                event.action = action;
+                event.mods = mods;
+                break;
+            }
+            case InputEventType::MOUSE_BUTTON: {
+                uint8_t button = 0, action = 0, mods = 0;
+                isComplete = Read(button) && Read(action) && Read(mods) &&
+                             Read(event.x) && Read(event.y) && Read(event.time);
+                event.code = button;
+                event.action = action;
+                event.mods = mods;
+                cursorX = event.x;
+                cursorY = event.y;
+                break;
+            }
+            case InputEventType::CURSOR_MOVE:
+                isComplete = Read(event.x) && Read(event.y) && Read(event.time);
+                cursorX = event.x;
+                cursorY = event.y;
+                break;
+            case InputEventType::SCROLL:
+                isComplete = Read(event.x) && Read(event.y) && Read(event.time);
+                break;
+        }
+        events.push_back(event);
+    }
+
+    if (!isComplete) {
+        LOG_WARNING(APP, "Input replay: recording ends in an incomplete frame at byte " << frameStart);
+        events.clear();
+        m_IsOpen = false;
+        return false;
+    }
+
+    m_CursorX = cursorX;
+    m_CursorY = cursorY;
+    frame = m_Frame;
+    ++m_FrameCount;
+    m_EventCount += events.size();
+    return true;
+}
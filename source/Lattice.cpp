@@ -0,0 +1,96 @@
+#include "Lattice.h"
+#include <cmath>
+#include <cstdlib>
+
+static const double SQRT2 = 1.41421356237309504880;
+
+// Largest sqrt(2) coefficient tried when snapping a float onto the lattice
+static const int MAX_IRRATIONAL_COEFFICIENT = 32;
+
+// Exact sign of a + b*sqrt(2): when the terms disagree, compare their squares
+static int SignOf(int64_t a, int64_t b) {
+    if (a >= 0 && b >= 0) return (a > 0 || b > 0) ? 1 : 0;
+    if (a <= 0 && b <= 0) return -1;
+
+    int64_t rationalSq = a * a;
+    int64_t irrationalSq = 2 * b * b;
+    if (a > 0) return (rationalSq > irrationalSq) ? 1 : -1;
+    return (irrationalSq > rationalSq) ? 1 : -1;
+}
+
+int LatticeScalar::Sign() const {
+    return SignOf(a, b);
+}
+
+float LatticeScalar::ToFloat() const {
+    return (float)((a + b * SQRT2) / DENOMINATOR);
+}
+
+bool LatticeScalar::FromFloat(float value, float tolerance, LatticeScalar& out) {
+    // sqrt(2) is irrational, so a + b*sqrt(2) is dense on the real line: a loose tolerance
+    // matches several values and no choice among them is safe. A float that is exactly a
+    // lattice value (e.g. written back by ToFloat) is taken as-is, so quantizing twice gives
+    // the same result; otherwise exactly one candidate may lie within tolerance
+    double scaled = value * DENOMINATOR;
+    int matchCount = 0;
+
+    for (int b = -MAX_IRRATIONAL_COEFFICIENT; b <= MAX_IRRATIONAL_COEFFICIENT; ++b) {
+        int a = (int)std::lround(scaled - b * SQRT2);
+        LatticeScalar candidate(a, b);
+        if (candidate.ToFloat() == value) {
+            out = candidate;
+            return true;
+        }
+        if (std::fabs((a + b * SQRT2) / DENOMINATOR - value) <= tolerance) {
+            ++matchCount;
+            out = candidate;
+        }
+    }
+
+    return matchCount == 1;
+}
+
+int LatticeProduct::Sign() const {
+    return SignOf(a, b);
+}
+
+double LatticeProduct::ToDouble() const {
+    return (a + b * SQRT2) / DENOMINATOR;
+}
+
+LatticeProduct operator*(const LatticeScalar& lhs, const LatticeScalar& rhs) {
+    // (a1 + b1*r)(a2 + b2*r) with r*r = 2; the denominators multiply to 16
+    int64_t a = (int64_t)lhs.a * rhs.a + 2 * (int64_t)lhs.b * rhs.b;
+    int64_t b = (int64_t)lhs.a * rhs.b + (int64_t)lhs.b * rhs.a;
+    return LatticeProduct(a, b);
+}
+
+bool LatticePoint::Rotated(int steps, LatticePoint& out) const {
+    steps = ((steps % 8) + 8) % 8;
+    LatticePoint result = *this;
+
+    if (steps % 2 == 1) {
+        // 45 degrees: ((x - y), (x + y)) scaled by sqrt(2)/2
+        if (!(x - y).MulHalfSqrt2(result.x) || !(x + y).MulHalfSqrt2(result.y)) {
+            return false;
+        }
+    }
+
+    for (int i = 0; i < steps / 2; ++i) {
+        result = LatticePoint(-result.y, result.x);
+    }
+
+    out = result;
+    return true;
+}
+
+bool LatticePoint::FromVec2(const glm::vec2& value, float tolerance, LatticePoint& out) {
+    return LatticeScalar::FromFloat(value.x, tolerance, out.x) &&
+           LatticeScalar::FromFloat(value.y, tolerance, out.y);
+}
+
+LatticeProduct Cross(const LatticePoint& a, const LatticePoint& b, const LatticePoint& c) {
+    LatticePoint ab = b - a;
+    LatticePoint ac = c - a;
+    return ab.x * ac.y - ab.y * ac.x;
+}
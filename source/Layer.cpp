@@ -5,12 +5,17 @@
 #include "Rectangle.h"
 #include <GLFW/glfw3.h>
 #include "Triangle.h"
-#include <iostream>
+#include "Log.h"
 #include <algorithm>
+#include <cmath>
+#include <random>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
-Layer::Layer(const char* vertPath, const char* fragPath, Application* windowContext) : m_Shader(vertPath, fragPath), m_CurrentMode(0), m_CurrentDrawingShape(nullptr), m_WindowContext(windowContext), m_IsFilled(true),m_ViewMatrix(glm::mat4(1.0f)), m_IsTranslating(false), m_IsPanning(false), m_LastMouseX(0.0), m_LastMouseY(0.0), m_LastPanMouseX(0.0), m_LastPanMouseY(0.0), m_ZoomLevel(1.0f), m_PanOffset(0.0f, 0.0f, 0.0f){
+//Undo entries kept; older edits are forgotten
+static const size_t EDIT_LOG_CAPACITY = 4096;
+
+Layer::Layer(const char* vertPath, const char* fragPath, Application* windowContext) : m_Shader(vertPath, fragPath), m_CurrentMode(0), m_CurrentDrawingShape(nullptr), m_WindowContext(windowContext), m_IsFilled(true),m_ViewMatrix(glm::mat4(1.0f)), m_IsTranslating(false), m_IsPanning(false), m_CursorX(0.0), m_CursorY(0.0), m_LastMouseX(0.0), m_LastMouseY(0.0), m_LastPanMouseX(0.0), m_LastPanMouseY(0.0), m_ZoomLevel(1.0f), m_PanOffset(0.0f, 0.0f, 0.0f), m_MagnetGrid(MAGNET_CELL_SIZE), m_MagnetOffset(0.0f, 0.0f), m_IsMagnetEnabled(true), m_EditLog(EDIT_LOG_CAPACITY, [this](const ShapeEdit& edit, bool isUndone){ DiscardEdit(edit, isUndone); }), m_DragDelta(0.0f, 0.0f){
 	UpdateViewMatrix();
 };
 
@@ -24,7 +29,7 @@ void Layer::OnRender(){
 	m_Shader.SetUniformMat4f("u_Projection", proj);
 	m_Shader.SetUniformMat4f("u_View", view);
 
-	for(Shape* shape : m_Shape){
+	for(Shape* shape : m_Shapes.GetShapes()){
 		const glm::mat4& model = shape->GetModelMatrix();
 
 		m_Shader.SetUniformMat4f("u_Model", model);
@@ -63,41 +68,38 @@ void Layer::ConvertScreenToWorld(double mouseX, double mouseY, float& outX, floa
 	}
 }
 
-void Layer::OnUpdate(GLFWwindow* window){
+void Layer::OnUpdate(GLFWwindow* /*window*/){
 
 	if (m_CurrentDrawingShape != nullptr){
-		double mouseX, mouseY;
 		float outX, outY;
 
-		glfwGetCursorPos(window, &mouseX, &mouseY);
-		ConvertScreenToWorld(mouseX, mouseY, outX, outY);
+		ConvertScreenToWorld(m_CursorX, m_CursorY, outX, outY);
 		m_CurrentDrawingShape->UpdateVertices(outX, outY);
 		
 	}
 
 	if (m_IsTranslating && !m_SelectedShape.empty()) {
-		double mouseX, mouseY;
 		float outX, outY;
-		glfwGetCursorPos(window, &mouseX, &mouseY);
-		ConvertScreenToWorld(mouseX, mouseY, outX, outY);
+		ConvertScreenToWorld(m_CursorX, m_CursorY, outX, outY);
 
-		float dx = (float)(outX - m_LastMouseX);
-		float dy = (float)(outY - m_LastMouseY);
+		glm::vec2 delta((float)(outX - m_LastMouseX), (float)(outY - m_LastMouseY));
+		if (m_IsMagnetEnabled) {
+			delta = ApplyMagnet(delta);
+		}
 
-		for (Shape* shape : m_SelectedShape) {
-			shape->Translate(dx, dy);
+		for (ShapeHandle handle : m_SelectedShape) {
+			Shape* shape = m_Shapes.Get(handle);
+			shape->Translate(delta.x, delta.y);
 		}
+		m_DragDelta += delta;
 
 		m_LastMouseX = outX;
 		m_LastMouseY = outY;
 	}
 
 	if (m_IsPanning) {
-		double mouseX, mouseY;
-		glfwGetCursorPos(window, &mouseX, &mouseY);
-		
-		double dx = mouseX - m_LastPanMouseX;
-		double dy = mouseY - m_LastPanMouseY;
+		double dx = m_CursorX - m_LastPanMouseX;
+		double dy = m_CursorY - m_LastPanMouseY;
 		
 		float windowWidth = (float)m_WindowContext->GetWidth();
 		float windowHeight = (float)m_WindowContext->GetHeight();
@@ -117,8 +119,31 @@ void Layer::OnUpdate(GLFWwindow* window){
 		
 		UpdateViewMatrix();
 		
-		m_LastPanMouseX = mouseX;
-		m_LastPanMouseY = mouseY;
+		m_LastPanMouseX = m_CursorX;
+		m_LastPanMouseY = m_CursorY;
+	}
+}
+
+void Layer::OnInputEvents(const InputEvent* events, size_t count){
+	for (size_t i = 0; i < count; ++i) {
+		const InputEvent& event = events[i];
+		switch (event.type) {
+			case InputEventType::KEY:
+				OnKeyEvent(event.code, event.scancode, event.action, event.mods);
+				break;
+			case InputEventType::MOUSE_BUTTON:
+				m_CursorX = event.x;
+				m_CursorY = event.y;
+				OnMouseButtonEvent(event.code, event.action, event.mods, event.x, event.y);
+				break;
+			case InputEventType::CURSOR_MOVE:
+				//Drawing, drags and pans catch up with the cursor in OnUpdate
+				m_CursorX = event.x;
+				m_CursorY = event.y;
+				break;
+			case InputEventType::SCROLL:
+				break;
+		}
 	}
 }
 
@@ -132,7 +157,7 @@ void Layer::OnKeyEvent(int key, int /*scancode*/, int action, int mods){
 
 	if (key == GLFW_KEY_SPACE && action == GLFW_RELEASE) {
 		m_IsPanning = false;
-		std::cout << "Panning mode deactivated" << std::endl;
+		LOG_INFO(EDITOR, "Panning mode deactivated");
 		return;
 	}
 
@@ -145,10 +170,10 @@ void Layer::OnKeyEvent(int key, int /*scancode*/, int action, int mods){
 		case GLFW_KEY_F:{
 			m_IsFilled = !m_IsFilled;
 			if(!m_IsFilled){
-				std::cout << "Fill Mode: Deactivate" <<std::endl;
+				LOG_INFO(EDITOR, "Fill Mode: Deactivate");
 				return;
 			}
-			std::cout << "Fill Mode: Activated" <<std::endl;
+			LOG_INFO(EDITOR, "Fill Mode: Activated");
 			break;
 		}
 
@@ -157,10 +182,8 @@ void Layer::OnKeyEvent(int key, int /*scancode*/, int action, int mods){
 			if (m_SelectedShape.empty()){ 
 				break; 
 			}
-			for (Shape* shape : m_SelectedShape) {
-				shape->SetColor(0.0f, 0.0f, 0.0f); 
-			}
-			std::cout << "The color of the selected objects has been changed to BLACK." << std::endl;
+			SetSelectionColor(glm::vec3(0.0f, 0.0f, 0.0f));
+			LOG_INFO(EDITOR, "The color of the selected objects has been changed to BLACK.");
 			break;
 		}
 
@@ -169,10 +192,8 @@ void Layer::OnKeyEvent(int key, int /*scancode*/, int action, int mods){
 			if (m_SelectedShape.empty()){ 
 				break; 
 			}
-			for (Shape* shape : m_SelectedShape) {
-				shape->SetColor(1.0f, 0.0f, 0.0f); 
-			}
-			std::cout << "The color of the selected objects has been changed to RED." << std::endl;
+			SetSelectionColor(glm::vec3(1.0f, 0.0f, 0.0f));
+			LOG_INFO(EDITOR, "The color of the selected objects has been changed to RED.");
 			break;
 		}
 
@@ -181,10 +202,8 @@ void Layer::OnKeyEvent(int key, int /*scancode*/, int action, int mods){
 			if (m_SelectedShape.empty()){ 
 				break; 
 			}
-			for (Shape* shape : m_SelectedShape) {
-				shape->SetColor(0.0f, 1.0f, 0.0f); 
-			}
-			std::cout << "The color of the selected objects has been changed to GREEN." << std::endl;
+			SetSelectionColor(glm::vec3(0.0f, 1.0f, 0.0f));
+			LOG_INFO(EDITOR, "The color of the selected objects has been changed to GREEN.");
 			break;
 		}
 
@@ -193,30 +212,32 @@ void Layer::OnKeyEvent(int key, int /*scancode*/, int action, int mods){
 			if (m_SelectedShape.empty()){ 
 				break; 
 			}
-			for (Shape* shape : m_SelectedShape) {
-				shape->SetColor(0.0f, 0.0f, 1.0f); 
-			}
-			std::cout << "The color of the selected objects has been changed to BLUE." << std::endl;
+			SetSelectionColor(glm::vec3(0.0f, 0.0f, 1.0f));
+			LOG_INFO(EDITOR, "The color of the selected objects has been changed to BLUE.");
 			break;
 		}
 
 		case GLFW_KEY_BACKSPACE:{
 			if(!(m_SelectedShape.empty())){
-				for(Shape* shapeToDelete : m_SelectedShape){
-					m_Shape.erase(std::remove(m_Shape.begin(), m_Shape.end(), shapeToDelete), m_Shape.end());
-					delete shapeToDelete;
+				//Hidden rather than destroyed, so undo can bring them back
+				m_EditLog.BeginGroup();
+				for(ShapeHandle handle : m_SelectedShape){
+					m_MagnetGrid.Remove(m_Shapes.Get(handle));
+					m_Shapes.Hide(handle);
+					RecordEdit(ShapeEditType::DELETE, handle, glm::vec2(0.0f, 0.0f));
 				}
+				m_EditLog.EndGroup();
 				m_SelectedShape.clear();
-				std::cout << "Selected shapes erased" << std::endl;
+				LOG_INFO(EDITOR, "Selected shapes erased");
 			} else {
-				std::cout << "Nothing selected to be erased" << std::endl;
+				LOG_INFO(EDITOR, "Nothing selected to be erased");
 			}
 			break;
 		}
 
 		case GLFW_KEY_Q: {
 			if (mods & GLFW_MOD_CONTROL) {
-				std::cout << "Quitting application..." << std::endl;
+				LOG_INFO(EDITOR, "Quitting application...");
 				GLFWwindow* window = m_WindowContext->GetWindow();
 				glfwSetWindowShouldClose(window, GLFW_TRUE);
 			} else {
@@ -224,41 +245,46 @@ void Layer::OnKeyEvent(int key, int /*scancode*/, int action, int mods){
 					break;
 				}
 				float rotationAngle = 0.1f;
-				for (Shape* shape : m_SelectedShape) {
+				m_EditLog.BeginGroup();
+				for (ShapeHandle handle : m_SelectedShape) {
+					Shape* shape = m_Shapes.Get(handle);
 					shape->Rotate(rotationAngle);
+					RefreshMagnet(shape);
+					RecordEdit(ShapeEditType::ROTATE, handle, glm::vec2(rotationAngle, 0.0f));
 				}
-				std::cout << "Rotated selected shapes counter-clockwise" << std::endl;
+				m_EditLog.EndGroup();
+				LOG_INFO(EDITOR, "Rotated selected shapes counter-clockwise");
 			}
 			break;
 		}
 
 		case GLFW_KEY_0:{
             m_CurrentMode = 0;
-			std::cout << "Mode 0: Select Mode Active" <<std::endl;
+			LOG_INFO(EDITOR, "Mode 0: Select Mode Active");
             break;
 		}
 
         case GLFW_KEY_1:{
             m_CurrentMode = 1;
-            std::cout << "Mode 1: Drawn Rectangle Active" <<std::endl;
+            LOG_INFO(EDITOR, "Mode 1: Drawn Rectangle Active");
             break;
         }
 
         case GLFW_KEY_2:{
             m_CurrentMode = 2;
-            std::cout << "Mode 2: Drawn Triangle Active" <<std::endl;
+            LOG_INFO(EDITOR, "Mode 2: Drawn Triangle Active");
             break;
         }
 
 		case GLFW_KEY_3: {
 			m_CurrentMode = 3;
-			std::cout << "Mode 3: Drawn Cirvle Active" <<std::endl;
+			LOG_INFO(EDITOR, "Mode 3: Drawn Cirvle Active");
 			break;
 		}
 
         case GLFW_KEY_4: {
             m_CurrentMode = 4;
-            std::cout << "Mode 4: Drawn Polygon Active" <<std::endl;
+            LOG_INFO(EDITOR, "Mode 4: Drawn Polygon Active");
             break;
         }
 
@@ -268,10 +294,15 @@ void Layer::OnKeyEvent(int key, int /*scancode*/, int action, int mods){
 				break;
 			}
 			float rotationAngle = -0.1f;
-			for (Shape* shape : m_SelectedShape) {
+			m_EditLog.BeginGroup();
+			for (ShapeHandle handle : m_SelectedShape) {
+				Shape* shape = m_Shapes.Get(handle);
 				shape->Rotate(rotationAngle);
+				RefreshMagnet(shape);
+				RecordEdit(ShapeEditType::ROTATE, handle, glm::vec2(rotationAngle, 0.0f));
 			}
-			std::cout << "Rotated selected shapes clockwise" << std::endl;
+			m_EditLog.EndGroup();
+			LOG_INFO(EDITOR, "Rotated selected shapes clockwise");
 			break;
 		}
 
@@ -281,10 +312,15 @@ void Layer::OnKeyEvent(int key, int /*scancode*/, int action, int mods){
 				break;
 			}
 			float scaleFactor = 1.1f;
-			for (Shape* shape : m_SelectedShape) {
+			m_EditLog.BeginGroup();
+			for (ShapeHandle handle : m_SelectedShape) {
+				Shape* shape = m_Shapes.Get(handle);
 				shape->Scale(scaleFactor, scaleFactor);
+				RefreshMagnet(shape);
+				RecordEdit(ShapeEditType::SCALE, handle, glm::vec2(scaleFactor, scaleFactor));
 			}
-			std::cout << "Scaled up selected shapes" << std::endl;
+			m_EditLog.EndGroup();
+			LOG_INFO(EDITOR, "Scaled up selected shapes");
 			break;
 		}
 
@@ -294,18 +330,31 @@ void Layer::OnKeyEvent(int key, int /*scancode*/, int action, int mods){
 				break;
 			}
 			float scaleFactor = 1.0f / 1.1f;
-			for (Shape* shape : m_SelectedShape) {
+			m_EditLog.BeginGroup();
+			for (ShapeHandle handle : m_SelectedShape) {
+				Shape* shape = m_Shapes.Get(handle);
 				shape->Scale(scaleFactor, scaleFactor);
+				RefreshMagnet(shape);
+				RecordEdit(ShapeEditType::SCALE, handle, glm::vec2(scaleFactor, scaleFactor));
 			}
-			std::cout << "Scaled down selected shapes" << std::endl;
+			m_EditLog.EndGroup();
+			LOG_INFO(EDITOR, "Scaled down selected shapes");
 			break;
 		}
 
 		case GLFW_KEY_Z: {
+			if (mods & GLFW_MOD_CONTROL) {
+				if (mods & GLFW_MOD_SHIFT) {
+					Redo();
+				} else {
+					Undo();
+				}
+				break;
+			}
 			m_ZoomLevel *= 1.2f;
 			if (m_ZoomLevel > 10.0f) m_ZoomLevel = 10.0f;
 			UpdateViewMatrix();
-			std::cout << "Zoomed in. Zoom level: " << m_ZoomLevel << std::endl;
+			LOG_INFO(EDITOR, "Zoomed in. Zoom level: " << m_ZoomLevel);
 			break;
 		}
 
@@ -313,34 +362,45 @@ void Layer::OnKeyEvent(int key, int /*scancode*/, int action, int mods){
 			m_ZoomLevel /= 1.2f;
 			if (m_ZoomLevel < 0.1f) m_ZoomLevel = 0.1f;
 			UpdateViewMatrix();
-			std::cout << "Zoomed out. Zoom level: " << m_ZoomLevel << std::endl;
+			LOG_INFO(EDITOR, "Zoomed out. Zoom level: " << m_ZoomLevel);
 			break;
 		}
 
 		case GLFW_KEY_SPACE: {
-			GLFWwindow* window = m_WindowContext->GetWindow();
-			double mouseX, mouseY;
-			glfwGetCursorPos(window, &mouseX, &mouseY);
 			m_IsPanning = true;
-			m_LastPanMouseX = mouseX;
-			m_LastPanMouseY = mouseY;
-			std::cout << "Panning mode activated (drag mouse)" << std::endl;
+			m_LastPanMouseX = m_CursorX;
+			m_LastPanMouseY = m_CursorY;
+			LOG_INFO(EDITOR, "Panning mode activated (drag mouse)");
+			break;
+		}
+
+		case GLFW_KEY_Y: {
+			if (mods & GLFW_MOD_CONTROL) {
+				Redo();
+			}
+			break;
+		}
+
+		case GLFW_KEY_M: {
+			m_IsMagnetEnabled = !m_IsMagnetEnabled;
+			LOG_INFO(EDITOR, "Magnetic snapping " << (m_IsMagnetEnabled ? "enabled" : "disabled"));
 			break;
 		}
 
 		case GLFW_KEY_A: {
 			if (m_SelectedShape.empty()) {
-				std::cout << "No shapes selected" << std::endl;
+				LOG_INFO(EDITOR, "No shapes selected");
 				break;
 			}
 			float totalArea = 0.0f;
 			float totalPerimeter = 0.0f;
-			for (Shape* shape : m_SelectedShape) {
+			for (ShapeHandle handle : m_SelectedShape) {
+				Shape* shape = m_Shapes.Get(handle);
 				totalArea += shape->GetArea();
 				totalPerimeter += shape->GetPerimeter();
 			}
-			std::cout << "Selected shapes - Total Area: " << totalArea 
-			          << ", Total Perimeter: " << totalPerimeter << std::endl;
+			LOG_INFO(EDITOR, "Selected shapes - Total Area: " << totalArea 
+			          << ", Total Perimeter: " << totalPerimeter);
 			break;
 		}
 	}
@@ -354,6 +414,19 @@ void Layer::OnMouseButtonEvent(int button, int action, int mods, double mouseX,
 	if (action == GLFW_RELEASE){
 		if(m_IsTranslating){
             m_IsTranslating = false;
+			m_MagnetOffset = glm::vec2(0.0f, 0.0f);
+			for (ShapeHandle handle : m_SelectedShape) {
+				Shape* shape = m_Shapes.Get(handle);
+				RefreshMagnet(shape);
+			}
+			//The whole drag is one edit
+			if (m_DragDelta != glm::vec2(0.0f, 0.0f)) {
+				m_EditLog.BeginGroup();
+				for (ShapeHandle handle : m_SelectedShape) {
+					RecordEdit(ShapeEditType::TRANSLATE, handle, m_DragDelta);
+				}
+				m_EditLog.EndGroup();
+			}
 		}
 		if (button == GLFW_MOUSE_BUTTON_MIDDLE && m_IsPanning) {
 			m_IsPanning = false;
@@ -362,9 +435,6 @@ void Layer::OnMouseButtonEvent(int button, int action, int mods, double mouseX,
 
 	if (button == GLFW_MOUSE_BUTTON_MIDDLE && action == GLFW_PRESS) {
 		m_IsPanning = true;
-		double mouseX, mouseY;
-		GLFWwindow* window = m_WindowContext->GetWindow();
-		glfwGetCursorPos(window, &mouseX, &mouseY);
 		m_LastPanMouseX = mouseX;
 		m_LastPanMouseY = mouseY;
 		return;
@@ -375,6 +445,7 @@ void Layer::OnMouseButtonEvent(int button, int action, int mods, double mouseX,
 			return;
 		}
 		if(button != GLFW_MOUSE_BUTTON_LEFT){
+			RefreshMagnet(m_CurrentDrawingShape);
 			m_CurrentDrawingShape = nullptr;
 			return;
 		}
@@ -382,14 +453,16 @@ void Layer::OnMouseButtonEvent(int button, int action, int mods, double mouseX,
 			m_CurrentDrawingShape->AddPoint(worldX, worldY);
 		}
 		else{
-			m_CurrentDrawingShape = new Polygon(worldX, worldY, m_IsFilled);
-			m_Shape.push_back(m_CurrentDrawingShape);
+			ShapeHandle handle = m_Shapes.CreatePolygon(worldX, worldY, m_IsFilled);
+			m_CurrentDrawingShape = m_Shapes.Get(handle);
+			RecordEdit(ShapeEditType::CREATE, handle, glm::vec2(0.0f, 0.0f));
 		}
 		return;
 	}
 
 
 	if (action != GLFW_PRESS){
+		RefreshMagnet(m_CurrentDrawingShape);
 		m_CurrentDrawingShape = nullptr;
 		return;
 	}
@@ -401,15 +474,15 @@ void Layer::OnMouseButtonEvent(int button, int action, int mods, double mouseX,
 					   m_SelectedShape.clear();
 				   }
 
-				   for(int i = m_Shape.size() - 1; i >= 0; i--){
-					   const glm::mat4& modelMatrix = m_Shape[i]->GetModelMatrix();
+				   for(int i = m_Shapes.GetCount() - 1; i >= 0; i--){
+					   const glm::mat4& modelMatrix = m_Shapes.GetShape(i)->GetModelMatrix();
 					   glm::mat4 invModel = glm::inverse(modelMatrix);
 					   glm::vec4 testPoint(worldX, worldY, 0.0f, 1.0f);
 					   glm::vec4 localPoint = invModel * testPoint;
 					   
-					   if(m_Shape[i]->IsInside(localPoint.x, localPoint.y)){
-						   m_SelectedShape.push_back(m_Shape[i]);
-						   std::cout << "The " << i<<"rd last form created has been selected" <<std::endl; 
+					   if(m_Shapes.GetShape(i)->IsInside(localPoint.x, localPoint.y)){
+						   m_SelectedShape.push_back(m_Shapes.GetHandle(i));
+						   LOG_INFO(EDITOR, "The " << i<<"rd last form created has been selected"); 
 						   break;
 					   }
 				   }
@@ -419,28 +492,33 @@ void Layer::OnMouseButtonEvent(int button, int action, int mods, double mouseX,
 
 					   m_LastMouseX = worldX; 
 					   m_LastMouseY = worldY;
+					   m_MagnetOffset = glm::vec2(0.0f, 0.0f);
+					   m_DragDelta = glm::vec2(0.0f, 0.0f);
 				   }
 
 				   break; 
 			   }
 
 		case 1:{
-				   m_CurrentDrawingShape = new Rectangle(worldX, worldY, worldX, worldY, m_IsFilled);
-				   m_Shape.push_back(m_CurrentDrawingShape);
+				   ShapeHandle handle = m_Shapes.CreateRectangle(worldX, worldY, worldX, worldY, m_IsFilled);
+				   m_CurrentDrawingShape = m_Shapes.Get(handle);
+				   RecordEdit(ShapeEditType::CREATE, handle, glm::vec2(0.0f, 0.0f));
 
 				   break;
 			   }
 
 		case 2:{
-				   m_CurrentDrawingShape = new Triangle(worldX, worldY, worldX, worldY, m_IsFilled);
-				   m_Shape.push_back(m_CurrentDrawingShape);
+				   ShapeHandle handle = m_Shapes.CreateTriangle(worldX, worldY, worldX, worldY, m_IsFilled);
+				   m_CurrentDrawingShape = m_Shapes.Get(handle);
+				   RecordEdit(ShapeEditType::CREATE, handle, glm::vec2(0.0f, 0.0f));
 
 				   break;
 			   }
 
 		case 3:{
-				   m_CurrentDrawingShape = new Circle(worldX, worldY, worldX, worldY, m_IsFilled);
-				   m_Shape.push_back(m_CurrentDrawingShape);
+				   ShapeHandle handle = m_Shapes.CreateCircle(worldX, worldY, worldX, worldY, m_IsFilled);
+				   m_CurrentDrawingShape = m_Shapes.Get(handle);
+				   RecordEdit(ShapeEditType::CREATE, handle, glm::vec2(0.0f, 0.0f));
 
 				   break;
 			   }
@@ -457,8 +535,188 @@ void Layer::OnMouseButtonEvent(int button, int action, int mods, double mouseX,
 	}
 }
 
-Layer::~Layer(){
-	for(Shape* shape : m_Shape){
-		delete shape;
+void Layer::RefreshMagnet(Shape* shape){
+	if (shape == nullptr) {
+		return;
+	}
+	GetWorldOutline(*shape, m_MagnetOutline);
+	m_MagnetGrid.Update(shape, m_MagnetOutline);
+}
+
+glm::vec2 Layer::ApplyMagnet(const glm::vec2& delta){
+	//The first selected shape leads; the rest of the selection follows it
+	glm::vec2 unpulled = delta - m_MagnetOffset;
+	GetWorldOutline(*m_Shapes.Get(m_SelectedShape.front()), m_MagnetOutline);
+	for (glm::vec2& vertex : m_MagnetOutline) {
+		vertex += unpulled;
+	}
+
+	std::vector<const Shape*> ignored;
+	for (ShapeHandle handle : m_SelectedShape) {
+		ignored.push_back(m_Shapes.Get(handle));
+	}
+	glm::vec2 offset(0.0f, 0.0f);
+	if (!m_MagnetGrid.FindSnap(m_MagnetOutline, ignored, MAGNET_RADIUS, offset)) {
+		offset = glm::vec2(0.0f, 0.0f);
+	}
+
+	m_MagnetOffset = offset;
+	return unpulled + offset;
+}
+
+void Layer::RecordEdit(ShapeEditType type, ShapeHandle handle, const glm::vec2& amount){
+	ShapeEdit edit;
+	edit.type = type;
+	edit.shape = handle;
+	edit.amount = amount;
+	edit.fromColor = glm::vec3(0.0f, 0.0f, 0.0f);
+	edit.toColor = glm::vec3(0.0f, 0.0f, 0.0f);
+	m_EditLog.Record(edit);
+}
+
+void Layer::SetSelectionColor(const glm::vec3& color){
+	m_EditLog.BeginGroup();
+	for (ShapeHandle handle : m_SelectedShape) {
+		Shape* shape = m_Shapes.Get(handle);
+		ShapeEdit edit;
+		edit.type = ShapeEditType::COLOR;
+		edit.shape = handle;
+		edit.amount = glm::vec2(0.0f, 0.0f);
+		edit.fromColor = shape->GetColor();
+		edit.toColor = color;
+		shape->SetColor(color.x, color.y, color.z);
+		m_EditLog.Record(edit);
+	}
+	m_EditLog.EndGroup();
+}
+
+void Layer::ApplyEdit(const ShapeEdit& edit, bool isUndo){
+	//Stale when the shape was destroyed along with an older entry
+	Shape* shape = m_Shapes.Get(edit.shape);
+	if (shape == nullptr) {
+		return;
 	}
+
+	switch (edit.type) {
+		case ShapeEditType::TRANSLATE: {
+			glm::vec2 offset = isUndo ? -edit.amount : edit.amount;
+			shape->Translate(offset.x, offset.y);
+			break;
+		}
+		case ShapeEditType::ROTATE: {
+			shape->Rotate(isUndo ? -edit.amount.x : edit.amount.x);
+			break;
+		}
+		case ShapeEditType::SCALE: {
+			if (isUndo) {
+				shape->Scale(1.0f / edit.amount.x, 1.0f / edit.amount.y);
+			} else {
+				shape->Scale(edit.amount.x, edit.amount.y);
+			}
+			break;
+		}
+		case ShapeEditType::COLOR: {
+			glm::vec3 color = isUndo ? edit.fromColor : edit.toColor;
+			shape->SetColor(color.x, color.y, color.z);
+			break;
+		}
+		case ShapeEditType::CREATE:
+		case ShapeEditType::DELETE: {
+			bool isShown = (edit.type == ShapeEditType::CREATE) != isUndo;
+			if (isShown) {
+				m_Shapes.Show(edit.shape);
+			} else {
+				m_Shapes.Hide(edit.shape);
+			}
+			break;
+		}
+	}
+
+	if (m_Shapes.IsHidden(edit.shape)) {
+		m_MagnetGrid.Remove(shape);
+		m_SelectedShape.erase(std::remove(m_SelectedShape.begin(), m_SelectedShape.end(), edit.shape), m_SelectedShape.end());
+	} else {
+		RefreshMagnet(shape);
+	}
+}
+
+void Layer::DiscardEdit(const ShapeEdit& edit, bool isUndone){
+	//A hidden shape is one whose deletion is in effect or whose creation was undone; its entry
+	//was the last way to bring it back
+	bool isHidden = (edit.type == ShapeEditType::DELETE && !isUndone) ||
+	                (edit.type == ShapeEditType::CREATE && isUndone);
+	if (isHidden) {
+		m_Shapes.Destroy(edit.shape);
+	}
+}
+
+void Layer::Undo(){
+	//Shapes being drawn or dragged are not in the history yet
+	if (m_CurrentDrawingShape != nullptr || m_IsTranslating) {
+		return;
+	}
+	if (m_EditLog.Undo([this](const ShapeEdit& edit){ ApplyEdit(edit, true); })) {
+		LOG_INFO(EDITOR, "Undone (" << m_EditLog.GetUndoCount() << " more to undo)");
+	} else {
+		LOG_INFO(EDITOR, "Nothing to undo");
+	}
+}
+
+void Layer::Redo(){
+	if (m_CurrentDrawingShape != nullptr || m_IsTranslating) {
+		return;
+	}
+	if (m_EditLog.Redo([this](const ShapeEdit& edit){ ApplyEdit(edit, false); })) {
+		LOG_INFO(EDITOR, "Redone (" << m_EditLog.GetRedoCount() << " more to redo)");
+	} else {
+		LOG_INFO(EDITOR, "Nothing to redo");
+	}
+}
+
+void Layer::GenerateStressScene(size_t count, uint32_t seed){
+	//The canvas seen at zoom 1 without panning
+	const glm::mat4& proj = m_WindowContext->GetProjectionMatrix();
+	float halfWidth = (proj[0][0] != 0.0f) ? (1.0f / proj[0][0]) : 5.0f;
+	float halfHeight = (proj[1][1] != 0.0f) ? (1.0f / proj[1][1]) : 5.0f;
+
+	std::mt19937 random(seed);
+	std::uniform_real_distribution<float> positionX(-halfWidth, halfWidth);
+	std::uniform_real_distribution<float> positionY(-halfHeight, halfHeight);
+	std::uniform_real_distribution<float> extent(0.05f, 0.3f);
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+	for (size_t i = 0; i < count; ++i) {
+		float x = positionX(random);
+		float y = positionY(random);
+		float size = extent(random);
+		ShapeHandle handle;
+		switch (i % 4) {
+			case 0:
+				handle = m_Shapes.CreateRectangle(x, y, x + size, y + size * unit(random), m_IsFilled);
+				break;
+			case 1:
+				handle = m_Shapes.CreateTriangle(x, y, x + size, y + size, m_IsFilled);
+				break;
+			case 2:
+				handle = m_Shapes.CreateCircle(x, y, x + size * 0.5f, y, m_IsFilled);
+				break;
+			default: {
+				//Convex, with the vertices in angle order
+				handle = m_Shapes.CreatePolygon(x + size, y, m_IsFilled);
+				Shape* polygon = m_Shapes.Get(handle);
+				int vertexCount = 3 + (int)(unit(random) * 6.0f);
+				for (int v = 1; v < vertexCount; ++v) {
+					float angle = 2.0f * (float)M_PI * v / vertexCount;
+					polygon->AddPoint(x + size * std::cos(angle), y + size * std::sin(angle));
+				}
+				polygon->FinalizeShape();
+				break;
+			}
+		}
+		RefreshMagnet(m_Shapes.Get(handle));
+	}
+}
+
+Layer::~Layer(){
+	//m_Shapes releases every shape it owns
 }
@@ -1,4 +1,7 @@
 #include "Level.h"
+#include "PieceGeometry.h"
+#include "Silhouette.h"
+#include <iostream>
 
 Level::Level(int levelNumber, const std::string& name,
              const std::vector<glm::vec2>& silhouetteVertices,
@@ -6,5 +9,98 @@ Level::Level(int levelNumber, const std::string& name,
     : m_LevelNumber(levelNumber)
     , m_Name(name)
     , m_SilhouetteVertices(silhouetteVertices)
-    , m_Solution(solution) {
+    , m_Solution(solution)
+    , m_IsOnLattice(false) {
+    QuantizeToLattice();
+}
+
+Level::Level(int levelNumber, const std::string& name,
+             const std::vector<LatticePoint>& silhouette,
+             const std::vector<int>& pieceIndices,
+             const std::vector<LatticePose>& solution,
+             const std::vector<std::vector<LatticePoint>>& holes)
+    : m_LevelNumber(levelNumber)
+    , m_Name(name)
+    , m_IsOnLattice(true)
+    , m_LatticeSilhouette(silhouette)
+    , m_LatticeSolution(solution)
+    , m_LatticeHoles(holes) {
+    UpdateSilhouetteVertices();
+    for (size_t i = 0; i < m_LatticeSolution.size(); ++i) {
+        int pieceIndex = pieceIndices[i];
+        m_Solution.push_back(ToPiecePosition(GetPieceTypeForIndex(pieceIndex), pieceIndex, m_LatticeSolution[i]));
+    }
+}
+
+bool Level::DeriveSilhouette() {
+    if (!m_IsOnLattice) {
+        return false;
+    }
+
+    std::vector<std::vector<LatticePoint>> outlines(m_LatticeSolution.size());
+    for (size_t i = 0; i < m_LatticeSolution.size(); ++i) {
+        GetPlacedOutline(GetPieceTypeForIndex(m_Solution[i].pieceIndex), m_LatticeSolution[i], outlines[i]);
+    }
+
+    std::vector<LatticePoint> outer;
+    std::vector<std::vector<LatticePoint>> holes;
+    if (!UnitePieces(outlines, outer, holes)) {
+        std::cerr << "Level " << m_LevelNumber << ": solution pieces overlap or are disconnected,"
+                  << " keeping the stored silhouette" << std::endl;
+        return false;
+    }
+
+    m_LatticeSilhouette.swap(outer);
+    m_LatticeHoles.swap(holes);
+    UpdateSilhouetteVertices();
+    return true;
+}
+
+void Level::UpdateSilhouetteVertices() {
+    m_SilhouetteVertices.clear();
+    for (const LatticePoint& vertex : m_LatticeSilhouette) {
+        m_SilhouetteVertices.push_back(vertex.ToVec2());
+    }
+    m_SilhouetteHoles.clear();
+    for (const std::vector<LatticePoint>& hole : m_LatticeHoles) {
+        std::vector<glm::vec2> vertices;
+        for (const LatticePoint& vertex : hole) {
+            vertices.push_back(vertex.ToVec2());
+        }
+        m_SilhouetteHoles.push_back(vertices);
+    }
+}
+
+void Level::QuantizeToLattice() {
+    m_LatticeSilhouette.clear();
+    m_LatticeSolution.clear();
+
+    for (const glm::vec2& vertex : m_SilhouetteVertices) {
+        LatticePoint point;
+        if (!LatticePoint::FromVec2(vertex, LATTICE_TOLERANCE, point)) {
+            std::cerr << "Level " << m_LevelNumber << ": silhouette vertex (" << vertex.x << ", " << vertex.y
+                      << ") is not on the tangram lattice" << std::endl;
+            return;
+        }
+        m_LatticeSilhouette.push_back(point);
+    }
+
+    for (const PiecePosition& target : m_Solution) {
+        LatticePose pose;
+        if (!ToLatticePose(GetPieceTypeForIndex(target.pieceIndex), target, LATTICE_TOLERANCE, pose)) {
+            std::cerr << "Level " << m_LevelNumber << ": piece " << target.pieceIndex
+                      << " is not on the tangram lattice" << std::endl;
+            return;
+        }
+        m_LatticeSolution.push_back(pose);
+    }
+
+    // The exact data is the reference from now on; the float copies are only views of it
+    UpdateSilhouetteVertices();
+    for (size_t i = 0; i < m_Solution.size(); ++i) {
+        int pieceIndex = m_Solution[i].pieceIndex;
+        m_Solution[i] = ToPiecePosition(GetPieceTypeForIndex(pieceIndex), pieceIndex, m_LatticeSolution[i]);
+    }
+
+    m_IsOnLattice = true;
 }
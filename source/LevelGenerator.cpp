@@ -0,0 +1,184 @@
+#include "LevelGenerator.h"
+#include "PieceGeometry.h"
+#include "Silhouette.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <unordered_map>
+
+static const int PIECE_COUNT = 7;
+static const int ORIENTATION_COUNT = 16;  // 8 rotations x 2 flip states
+
+// Placements tried for each piece before the arrangement is abandoned
+static const int PLACEMENT_ATTEMPTS = 64;
+
+// Busier outlines make poor puzzles
+static const size_t MAX_SILHOUETTE_VERTICES = 20;
+
+// Generation gives up after this many arrangements per requested level
+static const int ATTEMPTS_PER_LEVEL = 1000;
+
+// Attempts run between two merges, and attempts per pool task. Both are fixed, so the output
+// for a seed is the same on any number of threads
+static const int ATTEMPTS_PER_BATCH = 256;
+static const int ATTEMPTS_PER_TASK = 8;
+
+// Whether two pieces touch along a stretch of edge, not just at a point
+static bool SharesEdge(const std::vector<LatticePoint>& a, const std::vector<LatticePoint>& b) {
+    for (size_t i = 0; i < a.size(); ++i) {
+        const LatticePoint& p0 = a[i];
+        const LatticePoint& p1 = a[(i + 1) % a.size()];
+        for (size_t j = 0; j < b.size(); ++j) {
+            const LatticePoint& q0 = b[j];
+            const LatticePoint& q1 = b[(j + 1) % b.size()];
+            if (Cross(p0, p1, q0).Sign() != 0 || Cross(p0, p1, q1).Sign() != 0) {
+                continue;
+            }
+            bool isSameEdge = (p0 == q0 && p1 == q1) || (p0 == q1 && p1 == q0);
+            if (isSameEdge || IsInsideSegment(p0, p1, q0) || IsInsideSegment(p0, p1, q1)
+                || IsInsideSegment(q0, q1, p0) || IsInsideSegment(q0, q1, p1)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+static bool CanPlace(const std::vector<std::vector<LatticePoint>>& placed, const std::vector<LatticePoint>& outline) {
+    bool isTouching = false;
+    for (const std::vector<LatticePoint>& other : placed) {
+        if (DoInteriorsOverlap(outline, other)) {
+            return false;
+        }
+        isTouching = isTouching || SharesEdge(outline, other);
+    }
+    return isTouching;
+}
+
+LevelGenerator::LevelGenerator(ThreadPool& pool)
+    : m_Pool(pool) {
+}
+
+bool LevelGenerator::TryGenerate(std::mt19937& random, GeneratedLevel& outLevel) {
+    int order[PIECE_COUNT] = {0, 1, 2, 3, 4, 5, 6};
+    std::shuffle(order, order + PIECE_COUNT, random);
+
+    std::vector<std::vector<LatticePoint>> placed;
+    std::vector<LatticePose> poses(PIECE_COUNT);
+    std::vector<LatticePoint> outline;
+    std::vector<LatticePoint> offsets;
+
+    for (int n = 0; n < PIECE_COUNT; ++n) {
+        int pieceIndex = order[n];
+        PieceType type = GetPieceTypeForIndex(pieceIndex);
+
+        bool isPlaced = false;
+        for (int attempt = 0; attempt < PLACEMENT_ATTEMPTS && !isPlaced; ++attempt) {
+            int orientation = random() % ORIENTATION_COUNT;
+            LatticePose pose(LatticePoint(), orientation % 8, orientation >= 8);
+            GetPlacedOutline(type, pose, offsets);
+
+            if (!placed.empty()) {
+                // Put a random corner of the new piece on a random corner already down
+                const std::vector<LatticePoint>& target = placed[random() % placed.size()];
+                pose.anchor = target[random() % target.size()] - offsets[random() % offsets.size()];
+            }
+            GetPlacedOutline(type, pose, outline);
+
+            if (placed.empty() || CanPlace(placed, outline)) {
+                placed.push_back(outline);
+                poses[pieceIndex] = pose;
+                isPlaced = true;
+            }
+        }
+        if (!isPlaced) {
+            return false;
+        }
+    }
+
+    std::vector<std::vector<LatticePoint>> contours;
+    if (!TraceSilhouette(placed, contours) || contours.size() != 1 || contours[0].size() > MAX_SILHOUETTE_VERTICES) {
+        return false;
+    }
+
+    // Center on the origin, in quarter units so everything stays on the lattice
+    glm::vec2 minimum = contours[0][0].ToVec2();
+    glm::vec2 maximum = minimum;
+    for (const LatticePoint& vertex : contours[0]) {
+        minimum = glm::min(minimum, vertex.ToVec2());
+        maximum = glm::max(maximum, vertex.ToVec2());
+    }
+    glm::vec2 center = (minimum + maximum) * 0.5f;
+    LatticePoint shift(LatticeScalar((int)std::lround(center.x * LatticeScalar::DENOMINATOR), 0),
+                       LatticeScalar((int)std::lround(center.y * LatticeScalar::DENOMINATOR), 0));
+
+    outLevel.silhouette.clear();
+    for (const LatticePoint& vertex : contours[0]) {
+        outLevel.silhouette.push_back(vertex - shift);
+    }
+    for (LatticePose& pose : poses) {
+        pose.anchor = pose.anchor - shift;
+    }
+    outLevel.poses = poses;
+    outLevel.hash = 0;
+    return true;
+}
+
+std::vector<GeneratedLevel> LevelGenerator::Generate(int count, uint32_t seed) const {
+    struct Attempt {
+        bool isValid = false;
+        GeneratedLevel level;
+        std::vector<LatticePoint> canonical;
+    };
+
+    std::vector<GeneratedLevel> levels;
+    std::unordered_multimap<uint64_t, std::vector<LatticePoint>> seen;
+    std::vector<Attempt> attempts(ATTEMPTS_PER_BATCH);
+
+    int attemptCount = std::max(0, count) * ATTEMPTS_PER_LEVEL;
+    for (int batchStart = 0; batchStart < attemptCount && (int)levels.size() < count;
+         batchStart += ATTEMPTS_PER_BATCH) {
+        int batchSize = std::min(ATTEMPTS_PER_BATCH, attemptCount - batchStart);
+
+        // Every attempt draws from a stream of its own, so its result does not depend on
+        // the thread that runs it; the canonical form is also computed in parallel
+        int taskCount = (batchSize + ATTEMPTS_PER_TASK - 1) / ATTEMPTS_PER_TASK;
+        std::atomic<int> pending(taskCount);
+        for (int task = 0; task < taskCount; ++task) {
+            m_Pool.Submit([&, task]() {
+                int end = std::min(batchSize, (task + 1) * ATTEMPTS_PER_TASK);
+                for (int i = task * ATTEMPTS_PER_TASK; i < end; ++i) {
+                    Attempt& attempt = attempts[i];
+                    std::seed_seq sequence{seed, (uint32_t)(batchStart + i)};
+                    std::mt19937 random(sequence);
+                    attempt.isValid = TryGenerate(random, attempt.level);
+                    if (attempt.isValid) {
+                        attempt.canonical = GetCanonicalContour(attempt.level.silhouette);
+                        attempt.level.hash = HashCanonicalContour(attempt.canonical);
+                    }
+                }
+                pending.fetch_sub(1);
+            });
+        }
+        m_Pool.WaitFor(pending);
+
+        // Merged in attempt order: the first attempt to reach a shape keeps it
+        for (int i = 0; i < batchSize && (int)levels.size() < count; ++i) {
+            Attempt& attempt = attempts[i];
+            if (!attempt.isValid) {
+                continue;
+            }
+            auto range = seen.equal_range(attempt.level.hash);
+            bool isDuplicate = std::any_of(range.first, range.second, [&](const auto& entry) {
+                return entry.second == attempt.canonical;
+            });
+            if (isDuplicate) {
+                continue;
+            }
+            seen.emplace(attempt.level.hash, std::move(attempt.canonical));
+            levels.push_back(attempt.level);
+        }
+    }
+
+    return levels;
+}
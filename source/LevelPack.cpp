@@ -0,0 +1,310 @@
+#include "LevelPack.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char LEVEL_PACK_MAGIC[4] = {'T', 'G', 'P', 'K'};
+
+// Pieces of the standard set a solution can refer to, and 45 degree steps in a turn
+static const int32_t PACK_PIECE_COUNT = 7;
+static const int32_t PACK_ROTATION_STEPS = 8;
+
+static PackedLatticePoint Pack(const LatticePoint& point) {
+    return {point.x.a, point.x.b, point.y.a, point.y.b};
+}
+
+static LatticePoint Unpack(const PackedLatticePoint& point) {
+    return LatticePoint(LatticeScalar(point.xRational, point.xIrrational), LatticeScalar(point.yRational, point.yIrrational));
+}
+
+uint64_t HashLevelBytes(const void* data, size_t size, uint64_t hash) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+uint64_t LevelView::GetContentHash() const {
+    size_t vertexBytes = IsExact() ? GetVertexCount() * sizeof(PackedLatticePoint) + GetHoleCount() * sizeof(uint32_t)
+                                   : GetVertexCount() * sizeof(PackedVertex);
+    size_t pieceBytes = GetPieceCount() * (IsExact() ? sizeof(PackedLatticePiece) : sizeof(PackedPiece));
+    uint64_t hash = HashLevelBytes(&m_Entry->vertexCount, sizeof(m_Entry->vertexCount));
+    hash = HashLevelBytes(&m_Entry->flags, sizeof(m_Entry->flags) + sizeof(m_Entry->holeCount), hash);
+    hash = HashLevelBytes(m_Base + m_Entry->vertexOffset, vertexBytes, hash);
+    return HashLevelBytes(m_Base + m_Entry->pieceOffset, pieceBytes, hash);
+}
+
+Level* LevelView::CreateLevel() const {
+    if (IsExact()) {
+        const PackedLatticePoint* vertices = GetLatticeSilhouette();
+        const uint32_t* holeSizes = GetHoleSizes();
+        int outerCount = GetVertexCount();
+        for (int i = 0; i < GetHoleCount(); ++i) {
+            outerCount -= holeSizes[i];
+        }
+
+        std::vector<LatticePoint> silhouette;
+        silhouette.reserve(outerCount);
+        for (int i = 0; i < outerCount; ++i) {
+            silhouette.push_back(Unpack(vertices[i]));
+        }
+        std::vector<std::vector<LatticePoint>> holes(GetHoleCount());
+        int next = outerCount;
+        for (int i = 0; i < GetHoleCount(); ++i) {
+            holes[i].reserve(holeSizes[i]);
+            for (uint32_t j = 0; j < holeSizes[i]; ++j) {
+                holes[i].push_back(Unpack(vertices[next++]));
+            }
+        }
+
+        std::vector<int> pieceIndices;
+        std::vector<LatticePose> solution;
+        pieceIndices.reserve(GetPieceCount());
+        solution.reserve(GetPieceCount());
+        const PackedLatticePiece* pieces = GetLatticeSolution();
+        for (int i = 0; i < GetPieceCount(); ++i) {
+            const PackedLatticePiece& piece = pieces[i];
+            pieceIndices.push_back(piece.pieceIndex);
+            solution.push_back(LatticePose(Unpack(piece.anchor), piece.rotation, piece.isFlipped != 0));
+        }
+
+        return new Level(GetLevelNumber(), std::string(GetName()), silhouette, pieceIndices, solution, holes);
+    }
+
+    std::vector<glm::vec2> silhouette;
+    silhouette.reserve(GetVertexCount());
+    const PackedVertex* vertices = GetSilhouette();
+    for (int i = 0; i < GetVertexCount(); ++i) {
+        silhouette.push_back(glm::vec2(vertices[i].x, vertices[i].y));
+    }
+
+    std::vector<PiecePosition> solution;
+    solution.reserve(GetPieceCount());
+    const PackedPiece* pieces = GetSolution();
+    for (int i = 0; i < GetPieceCount(); ++i) {
+        const PackedPiece& piece = pieces[i];
+        solution.push_back({piece.pieceIndex, glm::vec2(piece.x, piece.y), piece.rotation, piece.isFlipped != 0});
+    }
+
+    return new Level(GetLevelNumber(), std::string(GetName()), silhouette, solution);
+}
+
+LevelPack::LevelPack()
+    : m_Data(nullptr)
+    , m_Size(0)
+    , m_Header(nullptr)
+    , m_Entries(nullptr) {
+}
+
+LevelPack::~LevelPack() {
+    Close();
+}
+
+bool LevelPack::Open(const std::string& path) {
+    Close();
+
+    int file = open(path.c_str(), O_RDONLY);
+    if (file < 0) {
+        std::cerr << "Level pack: cannot open " << path << std::endl;
+        return false;
+    }
+    struct stat info;
+    if (fstat(file, &info) != 0 || (size_t)info.st_size < sizeof(LevelPackHeader)) {
+        std::cerr << "Level pack: " << path << " is too small" << std::endl;
+        close(file);
+        return false;
+    }
+
+    size_t size = info.st_size;
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if (mapping == MAP_FAILED) {
+        std::cerr << "Level pack: cannot map " << path << std::endl;
+        return false;
+    }
+    m_Data = (const uint8_t*)mapping;
+    m_Size = size;
+
+    const LevelPackHeader* header = (const LevelPackHeader*)m_Data;
+    uint64_t indexEnd = (uint64_t)header->indexOffset + (uint64_t)header->levelCount * sizeof(LevelPackEntry);
+    if (std::memcmp(header->magic, LEVEL_PACK_MAGIC, sizeof(LEVEL_PACK_MAGIC)) != 0) {
+        std::cerr << "Level pack: " << path << " is not a level pack" << std::endl;
+    } else if (header->version != LEVEL_PACK_VERSION) {
+        std::cerr << "Level pack: " << path << " has version " << header->version
+                  << ", expected " << LEVEL_PACK_VERSION << std::endl;
+    } else if (header->fileSize != m_Size || header->indexOffset % 4 != 0 || indexEnd > m_Size) {
+        std::cerr << "Level pack: " << path << " is truncated or corrupt" << std::endl;
+    } else {
+        m_Header = header;
+        m_Entries = (const LevelPackEntry*)(m_Data + header->indexOffset);
+        return true;
+    }
+
+    Close();
+    return false;
+}
+
+void LevelPack::Close() {
+    if (m_Data != nullptr) {
+        munmap((void*)m_Data, m_Size);
+    }
+    m_Data = nullptr;
+    m_Size = 0;
+    m_Header = nullptr;
+    m_Entries = nullptr;
+}
+
+LevelView LevelPack::GetLevel(int index) const {
+    if (index < 0 || index >= GetLevelCount()) {
+        return LevelView();
+    }
+
+    const LevelPackEntry& entry = m_Entries[index];
+    bool isExact = (entry.flags & LEVEL_PACK_EXACT) != 0;
+    uint64_t vertexSize = isExact ? sizeof(PackedLatticePoint) : sizeof(PackedVertex);
+    uint64_t pieceSize = isExact ? sizeof(PackedLatticePiece) : sizeof(PackedPiece);
+    uint64_t holeSizesEnd = entry.vertexOffset + entry.vertexCount * vertexSize + entry.holeCount * sizeof(uint32_t);
+    bool isInside = (uint64_t)entry.nameOffset + entry.nameLength <= m_Size
+                 && entry.vertexOffset % 4 == 0
+                 && holeSizesEnd <= m_Size
+                 && entry.pieceOffset % 4 == 0
+                 && (uint64_t)entry.pieceOffset + entry.pieceCount * pieceSize <= m_Size
+                 && (isExact || entry.holeCount == 0);
+    if (!isInside) {
+        return LevelView();
+    }
+
+    // Holes must account for part of the vertex block, leaving at least a triangle outside
+    LevelView view(m_Data, &entry);
+    uint64_t holeVertexCount = 0;
+    for (int i = 0; i < view.GetHoleCount(); ++i) {
+        holeVertexCount += view.GetHoleSizes()[i];
+    }
+    if (entry.holeCount != 0 && holeVertexCount + 3 > entry.vertexCount) {
+        return LevelView();
+    }
+
+    // Piece indices and rotations index fixed arrays once decoded
+    for (int i = 0; i < view.GetPieceCount(); ++i) {
+        bool isInRange;
+        if (isExact) {
+            const PackedLatticePiece& piece = view.GetLatticeSolution()[i];
+            isInRange = piece.pieceIndex >= 0 && piece.pieceIndex < PACK_PIECE_COUNT
+                     && piece.rotation >= 0 && piece.rotation < PACK_ROTATION_STEPS;
+        } else {
+            const PackedPiece& piece = view.GetSolution()[i];
+            isInRange = piece.pieceIndex >= 0 && piece.pieceIndex < PACK_PIECE_COUNT;
+        }
+        if (!isInRange) {
+            return LevelView();
+        }
+    }
+    return view;
+}
+
+template <typename T>
+static uint32_t AppendBlob(std::vector<uint8_t>& blob, const T* data, size_t count) {
+    // Keep every section 4-byte aligned so the mapped data can be read in place
+    while (blob.size() % 4 != 0) {
+        blob.push_back(0);
+    }
+    uint32_t offset = blob.size();
+    const uint8_t* bytes = (const uint8_t*)data;
+    blob.insert(blob.end(), bytes, bytes + count * sizeof(T));
+    return offset;
+}
+
+void LevelPackWriter::AddLevel(const Level& level) {
+    const std::string& name = level.GetName();
+
+    LevelPackEntry entry = {};
+    entry.levelNumber = level.GetLevelNumber();
+    entry.nameLength = name.size();
+    entry.nameOffset = AppendBlob(m_Blob, name.data(), name.size());
+
+    if (level.IsOnLattice()) {
+        std::vector<PackedLatticePoint> vertices;
+        for (const LatticePoint& vertex : level.GetLatticeSilhouette()) {
+            vertices.push_back(Pack(vertex));
+        }
+        std::vector<uint32_t> holeSizes;
+        for (const std::vector<LatticePoint>& hole : level.GetLatticeHoles()) {
+            for (const LatticePoint& vertex : hole) {
+                vertices.push_back(Pack(vertex));
+            }
+            holeSizes.push_back(hole.size());
+        }
+        std::vector<PackedLatticePiece> pieces;
+        const std::vector<LatticePose>& poses = level.GetLatticeSolution();
+        for (size_t i = 0; i < poses.size(); ++i) {
+            pieces.push_back({level.GetSolution()[i].pieceIndex, Pack(poses[i].anchor), poses[i].rotation, poses[i].isFlipped ? 1u : 0u});
+        }
+
+        entry.flags = LEVEL_PACK_EXACT;
+        entry.holeCount = holeSizes.size();
+        entry.vertexCount = vertices.size();
+        entry.vertexOffset = AppendBlob(m_Blob, vertices.data(), vertices.size());
+        AppendBlob(m_Blob, holeSizes.data(), holeSizes.size());
+        entry.pieceCount = pieces.size();
+        entry.pieceOffset = AppendBlob(m_Blob, pieces.data(), pieces.size());
+    } else {
+        std::vector<PackedVertex> vertices;
+        for (const glm::vec2& vertex : level.GetSilhouetteVertices()) {
+            vertices.push_back({vertex.x, vertex.y});
+        }
+        std::vector<PackedPiece> pieces;
+        for (const PiecePosition& target : level.GetSolution()) {
+            pieces.push_back({target.pieceIndex, target.position.x, target.position.y, target.rotation, target.isFlipped ? 1u : 0u});
+        }
+
+        entry.vertexCount = vertices.size();
+        entry.vertexOffset = AppendBlob(m_Blob, vertices.data(), vertices.size());
+        entry.pieceCount = pieces.size();
+        entry.pieceOffset = AppendBlob(m_Blob, pieces.data(), pieces.size());
+    }
+    m_Entries.push_back(entry);
+}
+
+bool LevelPackWriter::Write(const std::string& path) const {
+    uint64_t blobStart = sizeof(LevelPackHeader) + (uint64_t)m_Entries.size() * sizeof(LevelPackEntry);
+    uint64_t fileSize = blobStart + m_Blob.size();
+    if (fileSize > UINT32_MAX) {
+        std::cerr << "Level pack: " << m_Entries.size() << " levels do not fit in a 4 GiB pack" << std::endl;
+        return false;
+    }
+
+    LevelPackHeader header = {};
+    std::memcpy(header.magic, LEVEL_PACK_MAGIC, sizeof(LEVEL_PACK_MAGIC));
+    header.version = LEVEL_PACK_VERSION;
+    header.levelCount = m_Entries.size();
+    header.indexOffset = sizeof(LevelPackHeader);
+    header.fileSize = fileSize;
+
+    // Entry offsets become absolute once the header and index are in front of the blob
+    std::vector<LevelPackEntry> entries = m_Entries;
+    for (LevelPackEntry& entry : entries) {
+        entry.nameOffset += blobStart;
+        entry.vertexOffset += blobStart;
+        entry.pieceOffset += blobStart;
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "Level pack: cannot write " << path << std::endl;
+        return false;
+    }
+    file.write((const char*)&header, sizeof(header));
+    file.write((const char*)entries.data(), entries.size() * sizeof(LevelPackEntry));
+    file.write((const char*)m_Blob.data(), m_Blob.size());
+    if (!file) {
+        std::cerr << "Level pack: failed writing " << path << std::endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,228 @@
+#include "Log.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+// Records in the queue; a power of two
+static const size_t QUEUE_CAPACITY = 1024;
+// The writer re-checks the queue at least this often, in case a wake-up raced with it going idle
+static const std::chrono::milliseconds WRITER_IDLE_WAIT(10);
+
+struct LogRecord {
+    // Bounded MPMC ring (Vyukov): a slot is free to write when its sequence equals the write
+    // position, and holds a message when it equals the position plus one
+    std::atomic<size_t> sequence;
+    LogLevel level;
+    LogCategory category;
+    size_t length;
+    char text[Log::MAX_MESSAGE_LENGTH];
+};
+
+struct LogState {
+    LogRecord records[QUEUE_CAPACITY];
+    std::atomic<size_t> writePosition;
+    size_t readPosition;        // Writer thread only
+
+    std::atomic<uint64_t> acceptedCount;
+    std::atomic<uint64_t> writtenCount;
+    std::atomic<uint64_t> droppedCount;
+    std::atomic<int> level;
+
+    std::atomic<bool> isRunning;
+    std::atomic<bool> isWriterIdle;
+    std::thread writer;
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+
+    LogState()
+        : writePosition(0)
+        , readPosition(0)
+        , acceptedCount(0)
+        , writtenCount(0)
+        , droppedCount(0)
+        , level((int)LogLevel::DEBUG)
+        , isRunning(false)
+        , isWriterIdle(false) {
+        for (size_t i = 0; i < QUEUE_CAPACITY; ++i) {
+            records[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    // Also covers std::exit, which skips the Stop at the end of main
+    ~LogState() {
+        Log::Stop();
+    }
+};
+
+static LogState s_Log;
+
+static const char* GetLevelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::DEBUG: return "debug";
+        case LogLevel::INFO: return "info";
+        case LogLevel::WARNING: return "warning";
+        case LogLevel::ERROR: return "error";
+    }
+    return "";
+}
+
+static const char* GetCategoryName(LogCategory category) {
+    switch (category) {
+        case LogCategory::APP: return "app";
+        case LogCategory::EDITOR: return "editor";
+        case LogCategory::GAME: return "game";
+        case LogCategory::MENU: return "menu";
+        case LogCategory::RENDER: return "render";
+    }
+    return "";
+}
+
+// Writes one message without flushing; returns the stream it went to
+static std::ostream& Print(LogLevel level, LogCategory category, const char* text, size_t length) {
+    std::ostream& out = (level >= LogLevel::WARNING) ? std::cerr : std::cout;
+    if (level != LogLevel::INFO) {
+        out << '[' << GetLevelName(level) << ':' << GetCategoryName(category) << "] ";
+    }
+    out.write(text, length);
+    if (length == 0 || text[length - 1] != '\n') {
+        out << '\n';
+    }
+    return out;
+}
+
+static bool Enqueue(LogLevel level, LogCategory category, const char* text, size_t length) {
+    size_t position = s_Log.writePosition.load(std::memory_order_relaxed);
+    for (;;) {
+        LogRecord& record = s_Log.records[position & (QUEUE_CAPACITY - 1)];
+        size_t sequence = record.sequence.load(std::memory_order_acquire);
+        intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+        if (difference == 0) {
+            if (s_Log.writePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                record.level = level;
+                record.category = category;
+                record.length = length;
+                std::memcpy(record.text, text, length);
+                record.sequence.store(position + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (difference < 0) {
+            return false;       // Full
+        } else {
+            position = s_Log.writePosition.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+// Writes out every queued record; returns how many there were
+static size_t Drain() {
+    size_t count = 0;
+    bool isErrorWritten = false;
+    for (;;) {
+        LogRecord& record = s_Log.records[s_Log.readPosition & (QUEUE_CAPACITY - 1)];
+        if (record.sequence.load(std::memory_order_acquire) != s_Log.readPosition + 1) {
+            break;
+        }
+        Print(record.level, record.category, record.text, record.length);
+        isErrorWritten = isErrorWritten || record.level >= LogLevel::WARNING;
+        record.sequence.store(s_Log.readPosition + QUEUE_CAPACITY, std::memory_order_release);
+        ++s_Log.readPosition;
+        ++count;
+    }
+    if (count > 0) {
+        std::cout.flush();
+        if (isErrorWritten) {
+            std::cerr.flush();
+        }
+        s_Log.writtenCount.fetch_add(count, std::memory_order_release);
+    }
+    return count;
+}
+
+static void RunWriter() {
+    while (s_Log.isRunning.load(std::memory_order_acquire)) {
+        if (Drain() > 0) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(s_Log.wakeMutex);
+        s_Log.isWriterIdle.store(true);
+        s_Log.wake.wait_for(lock, WRITER_IDLE_WAIT);
+        s_Log.isWriterIdle.store(false);
+    }
+    Drain();
+}
+
+void Log::Start() {
+    if (s_Log.isRunning.load()) {
+        return;
+    }
+    s_Log.isRunning.store(true);
+    s_Log.writer = std::thread(RunWriter);
+}
+
+void Log::Stop() {
+    if (!s_Log.isRunning.load()) {
+        return;
+    }
+    s_Log.isRunning.store(false);
+    s_Log.wake.notify_one();
+    s_Log.writer.join();
+
+    uint64_t dropped = s_Log.droppedCount.exchange(0);
+    if (dropped > 0) {
+        std::cerr << "Log: " << dropped << " messages dropped, the queue was full" << std::endl;
+    }
+}
+
+void Log::Flush() {
+    if (!s_Log.isRunning.load()) {
+        return;
+    }
+    uint64_t target = s_Log.acceptedCount.load(std::memory_order_acquire);
+    while (s_Log.writtenCount.load(std::memory_order_acquire) < target) {
+        s_Log.wake.notify_one();
+        std::this_thread::yield();
+    }
+}
+
+void Log::SetLevel(LogLevel level) {
+    s_Log.level.store((int)level, std::memory_order_relaxed);
+}
+
+bool Log::IsEnabled(LogLevel level) {
+    return (int)level >= s_Log.level.load(std::memory_order_relaxed);
+}
+
+void Log::Write(LogLevel level, LogCategory category, const char* text, size_t length) {
+    length = std::min(length, MAX_MESSAGE_LENGTH);
+    if (!s_Log.isRunning.load(std::memory_order_acquire)) {
+        Print(level, category, text, length).flush();
+        return;
+    }
+
+    if (!Enqueue(level, category, text, length)) {
+        s_Log.droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    s_Log.acceptedCount.fetch_add(1, std::memory_order_release);
+    // Never takes the lock: a missed wake-up only delays the message by the idle wait
+    if (s_Log.isWriterIdle.load(std::memory_order_relaxed)) {
+        s_Log.wake.notify_one();
+    }
+}
+
+LogMessage::LogMessage(LogLevel level, LogCategory category)
+    : m_Level(level)
+    , m_Category(category)
+    , m_Buffer(m_Text, sizeof(m_Text))
+    , m_Stream(&m_Buffer) {
+}
+
+LogMessage::~LogMessage() {
+    Log::Write(m_Level, m_Category, m_Text, m_Buffer.GetLength());
+}
@@ -0,0 +1,192 @@
+#include "MagnetGrid.h"
+#include "Shape.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+// Edges count as parallel when the sine of the angle between them is below this
+static const float PARALLEL_TOLERANCE = 0.02f;
+
+void GetWorldOutline(const Shape& shape, std::vector<glm::vec2>& outVertices) {
+    shape.GetOutline(outVertices);
+    const glm::mat4& model = shape.GetModelMatrix();
+    for (glm::vec2& vertex : outVertices) {
+        glm::vec4 world = model * glm::vec4(vertex.x, vertex.y, 0.0f, 1.0f);
+        vertex = glm::vec2(world.x, world.y);
+    }
+}
+
+MagnetGrid::MagnetGrid(float cellSize)
+    : m_CellSize(cellSize) {
+}
+
+int64_t MagnetGrid::CellKey(int cellX, int cellY) const {
+    // Shifting the unsigned bit pattern; a negative int64_t must not be shifted left
+    return (int64_t)(((uint64_t)(uint32_t)cellX << 32) | (uint32_t)cellY);
+}
+
+int64_t MagnetGrid::CellKey(const glm::vec2& point) const {
+    return CellKey((int)std::floor(point.x / m_CellSize), (int)std::floor(point.y / m_CellSize));
+}
+
+void MagnetGrid::Insert(int64_t key, const CellEntry& entry, OwnerFeatures& features) {
+    m_Cells[key].push_back(entry);
+    if (std::find(features.cells.begin(), features.cells.end(), key) == features.cells.end()) {
+        features.cells.push_back(key);
+    }
+}
+
+void MagnetGrid::Update(const Shape* owner, const std::vector<glm::vec2>& outline) {
+    Remove(owner);
+
+    OwnerFeatures& features = m_Owners[owner];
+    features.vertices = outline;
+
+    size_t count = outline.size();
+    for (size_t i = 0; i < count; ++i) {
+        Insert(CellKey(outline[i]), {owner, (int)i, false}, features);
+    }
+
+    for (size_t i = 0; i < count && count > 1; ++i) {
+        const glm::vec2& start = outline[i];
+        const glm::vec2& end = outline[(i + 1) % count];
+        float length = glm::distance(start, end);
+        if (length <= 0.0f) {
+            continue;
+        }
+
+        int edgeIndex = features.edges.size();
+        features.edges.push_back({start, end, (end - start) / length});
+
+        // Register the edge in every cell it crosses by walking it in half-cell steps
+        int steps = (int)std::ceil(length / (m_CellSize * 0.5f));
+        int64_t lastKey = 0;
+        for (int step = 0; step <= steps; ++step) {
+            int64_t key = CellKey(glm::mix(start, end, (float)step / steps));
+            if (step == 0 || key != lastKey) {
+                Insert(key, {owner, edgeIndex, true}, features);
+                lastKey = key;
+            }
+        }
+    }
+}
+
+void MagnetGrid::Remove(const Shape* owner) {
+    auto found = m_Owners.find(owner);
+    if (found == m_Owners.end()) {
+        return;
+    }
+
+    for (int64_t key : found->second.cells) {
+        auto cell = m_Cells.find(key);
+        if (cell == m_Cells.end()) {
+            continue;
+        }
+        std::vector<CellEntry>& entries = cell->second;
+        entries.erase(std::remove_if(entries.begin(), entries.end(),
+                          [owner](const CellEntry& entry) { return entry.owner == owner; }),
+                      entries.end());
+        if (entries.empty()) {
+            m_Cells.erase(cell);
+        }
+    }
+
+    m_Owners.erase(found);
+}
+
+void MagnetGrid::Clear() {
+    m_Cells.clear();
+    m_Owners.clear();
+}
+
+template <typename Visitor>
+void MagnetGrid::VisitNeighbourhood(const glm::vec2& point, const std::vector<const Shape*>& ignoredOwners, Visitor visitor) const {
+    int cellX = (int)std::floor(point.x / m_CellSize);
+    int cellY = (int)std::floor(point.y / m_CellSize);
+
+    // The snap radius never exceeds a cell, so the 3x3 block around the point is enough
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            auto cell = m_Cells.find(CellKey(cellX + dx, cellY + dy));
+            if (cell == m_Cells.end()) {
+                continue;
+            }
+            for (const CellEntry& entry : cell->second) {
+                if (std::find(ignoredOwners.begin(), ignoredOwners.end(), entry.owner) != ignoredOwners.end()) {
+                    continue;
+                }
+                visitor(m_Owners.at(entry.owner), entry);
+            }
+        }
+    }
+}
+
+bool MagnetGrid::FindSnap(const std::vector<glm::vec2>& outline, const std::vector<const Shape*>& ignoredOwners,
+                          float radius, glm::vec2& outOffset) const {
+    radius = std::min(radius, m_CellSize);
+
+    // Vertex on vertex is the strongest snap: it fixes both axes
+    float bestDistance = radius;
+    bool found = false;
+    for (const glm::vec2& vertex : outline) {
+        VisitNeighbourhood(vertex, ignoredOwners, [&](const OwnerFeatures& features, const CellEntry& entry) {
+            if (entry.isEdge) {
+                return;
+            }
+            glm::vec2 offset = features.vertices[entry.feature] - vertex;
+            float distance = glm::length(offset);
+            if (distance < bestDistance) {
+                bestDistance = distance;
+                outOffset = offset;
+                found = true;
+            }
+        });
+    }
+    if (found) {
+        return true;
+    }
+
+    // Otherwise lay a moving edge flush against a nearby parallel edge
+    size_t count = outline.size();
+    for (size_t i = 0; i < count && count > 1; ++i) {
+        const glm::vec2& start = outline[i];
+        const glm::vec2& end = outline[(i + 1) % count];
+        float length = glm::distance(start, end);
+        if (length <= 0.0f) {
+            continue;
+        }
+        glm::vec2 direction = (end - start) / length;
+
+        glm::vec2 probes[3] = {start, (start + end) * 0.5f, end};
+        for (const glm::vec2& probe : probes) {
+            VisitNeighbourhood(probe, ignoredOwners, [&](const OwnerFeatures& features, const CellEntry& entry) {
+                if (!entry.isEdge) {
+                    return;
+                }
+                const Edge& edge = features.edges[entry.feature];
+                float sine = direction.x * edge.direction.y - direction.y * edge.direction.x;
+                if (std::fabs(sine) > PARALLEL_TOLERANCE) {
+                    return;
+                }
+
+                // The edges must overlap along their common direction
+                float startAlong = glm::dot(start - edge.start, edge.direction);
+                float endAlong = glm::dot(end - edge.start, edge.direction);
+                float edgeLength = glm::distance(edge.start, edge.end);
+                if (std::max(startAlong, endAlong) <= 0.0f || std::min(startAlong, endAlong) >= edgeLength) {
+                    return;
+                }
+
+                glm::vec2 normal(-edge.direction.y, edge.direction.x);
+                float gap = glm::dot(probe - edge.start, normal);
+                if (std::fabs(gap) < bestDistance) {
+                    bestDistance = std::fabs(gap);
+                    outOffset = -normal * gap;
+                    found = true;
+                }
+            });
+        }
+    }
+
+    return found;
+}
@@ -1,107 +1,284 @@
 #include "MenuLayer.h"
 #include "Application.h"
+#include "Log.h"
 #include <GLFW/glfw3.h>
-#include <iostream>
+#include <algorithm>
+#include <cmath>
 #include <glm/gtc/matrix_transform.hpp>
 
+// Instanced button shader, next to the shaders main.cpp hands in
+static const char* MENU_VERTEX_SHADER = "shaders/menu_vertex.glsl";
+static const char* MENU_FRAGMENT_SHADER = "shaders/menu_fragment.glsl";
+
+// Thumbnails are baked once and reused on later launches
+static const char* THUMBNAIL_CACHE_PATH = "thumbnails.cache";
+
+// Button size in world units; thumbnails are baked at this many pixels per unit
+static const float BUTTON_WIDTH = 1.5f;
+static const float BUTTON_HEIGHT = 0.8f;
+static const float THUMBNAIL_PIXELS_PER_UNIT = 100.0f;
+
+// Resident thumbnails, several screens' worth so scrolling back rarely reloads
+static const int THUMBNAIL_SLOTS = 512;
+
+// Grid pitch and the empty border around it, in world units
+static const float SPACING_X = 2.0f;
+static const float SPACING_Y = 1.2f;
+static const float GRID_MARGIN = 0.5f;
+
+// Kinetic scrolling: a wheel notch adds WHEEL_IMPULSE to the speed, which decays as
+// exp(-SCROLL_FRICTION * t), so a notch glides WHEEL_IMPULSE / SCROLL_FRICTION units in total
+static const float WHEEL_IMPULSE = 12.0f;
+static const float SCROLL_FRICTION = 6.0f;
+static const float MIN_SCROLL_VELOCITY = 0.01f;
+// Cursor travel in pixels before a press becomes a drag instead of a click
+static const double DRAG_THRESHOLD = 5.0;
+// A drag released after the cursor rested this long (seconds) does not glide on
+static const double FLICK_TIMEOUT = 0.1;
+
+static const glm::vec4 BUTTON_COLOR(0.7f, 0.7f, 0.7f, 1.0f);        // Light gray
+static const glm::vec4 BUTTON_HOVER_COLOR(0.9f, 0.9f, 0.5f, 1.0f);  // Yellow highlight
+static const glm::vec4 THUMBNAIL_COLOR(0.25f, 0.25f, 0.3f, 1.0f);
+
 MenuLayer::MenuLayer(const char* vertPath, const char* fragPath, Application* windowContext, LevelManager* levelManager)
     : m_Shader(vertPath, fragPath)
+    , m_ButtonShader(MENU_VERTEX_SHADER, MENU_FRAGMENT_SHADER)
+    , m_InstanceCapacity(0)
+    , m_ButtonVAO(nullptr)
+    , m_ButtonIBO(nullptr)
+    , m_Thumbnails((int)(BUTTON_WIDTH * THUMBNAIL_PIXELS_PER_UNIT), (int)(BUTTON_HEIGHT * THUMBNAIL_PIXELS_PER_UNIT), THUMBNAIL_SLOTS)
     , m_LevelManager(levelManager)
     , m_WindowContext(windowContext)
     , m_SelectedLevel(-1)
     , m_HoveredButton(-1)
+    , m_Columns(1)
+    , m_GridLeft(0.0f)
+    , m_GridTop(0.0f)
+    , m_VisibleTop(0.0f)
+    , m_VisibleBottom(0.0f)
+    , m_FirstVisibleRow(0)
+    , m_LastVisibleRow(-1)
+    , m_IsDirty(true)
+    , m_ScrollOffset(0.0f)
+    , m_PreviousScrollOffset(0.0f)
+    , m_ScrollVelocity(0.0f)
+    , m_MaxScrollOffset(0.0f)
+    , m_CursorX(0.0)
+    , m_CursorY(0.0)
+    , m_IsPressed(false)
+    , m_IsDragging(false)
+    , m_PressX(0.0)
+    , m_PressY(0.0)
+    , m_LastDragY(0.0)
+    , m_LastDragTime(0.0)
     , m_ViewMatrix(glm::mat4(1.0f)) {
-    
-    CreateLevelButtons();
+
+    m_Thumbnails.Open(m_LevelManager, &m_Shader, THUMBNAIL_CACHE_PATH);
+    CreateButtonQuad();
+    UpdateLayout();
 }
 
 MenuLayer::~MenuLayer() {
-    for (Rectangle* button : m_LevelButtons) {
-        delete button;
+    delete m_ButtonVAO;
+    delete m_ButtonIBO;
+}
+
+void MenuLayer::CreateButtonQuad() {
+    // Unit quad shared by every button
+    float corners[] = {
+        0.0f, 0.0f,
+        1.0f, 0.0f,
+        1.0f, 1.0f,
+        0.0f, 1.0f
+    };
+    unsigned int indices[] = {0, 1, 2, 2, 3, 0};
+
+    BufferLayout quadLayout;
+    quadLayout.PushFloat(2);  // Corner
+
+    m_ButtonVAO = new VertexArray();
+    m_ButtonVAO->SetData(corners, sizeof(corners), &quadLayout);
+    m_ButtonIBO = new IndexBuffer(indices, 6);
+}
+
+void MenuLayer::UpdateLayout() {
+    // Visible world rectangle without scrolling
+    glm::mat4 invProj = glm::inverse(m_WindowContext->GetProjectionMatrix());
+    glm::vec4 bottomLeft = invProj * glm::vec4(-1.0f, -1.0f, 0.0f, 1.0f);
+    glm::vec4 topRight = invProj * glm::vec4(1.0f, 1.0f, 0.0f, 1.0f);
+
+    int columns = std::max(1, (int)((topRight.x - bottomLeft.x - 2.0f * GRID_MARGIN - BUTTON_WIDTH) / SPACING_X) + 1);
+    float gridLeft = (bottomLeft.x + topRight.x) * 0.5f - (columns - 1) * SPACING_X * 0.5f;
+    float gridTop = topRight.y - GRID_MARGIN - BUTTON_HEIGHT * 0.5f;
+    if (gridLeft != m_GridLeft || gridTop != m_GridTop) {
+        m_GridLeft = gridLeft;
+        m_GridTop = gridTop;
+        m_IsDirty = true;
     }
+    m_VisibleTop = topRight.y;
+    m_VisibleBottom = bottomLeft.y;
+
+    int rows = (m_LevelManager->GetLevelCount() + columns - 1) / columns;
+    float gridBottom = m_GridTop - (rows - 1) * SPACING_Y - BUTTON_HEIGHT * 0.5f;
+    m_MaxScrollOffset = std::max(0.0f, m_VisibleBottom + GRID_MARGIN - gridBottom);
+
+    if (columns != m_Columns) {
+        // Keep the first visible level on screen when the window is resized
+        int firstLevel = (int)((m_ScrollOffset / SPACING_Y)) * m_Columns;
+        m_Columns = columns;
+        m_ScrollOffset = (firstLevel / columns) * SPACING_Y;
+        m_PreviousScrollOffset = m_ScrollOffset;
+    }
+    m_ScrollOffset = std::min(std::max(m_ScrollOffset, 0.0f), m_MaxScrollOffset);
+}
+
+glm::vec2 MenuLayer::GetButtonCenter(int index) const {
+    return GetButtonCenter(m_Columns, m_GridLeft, m_GridTop, index);
+}
+
+glm::vec2 MenuLayer::GetButtonCenter(int columns, float gridLeft, float gridTop, int index) {
+    return glm::vec2(gridLeft + (index % columns) * SPACING_X, gridTop - (index / columns) * SPACING_Y);
 }
 
-void MenuLayer::CreateLevelButtons() {
-    // Create a grid of level buttons (2 columns, 5 rows for 10 levels)
+int MenuLayer::FindButton(float worldX, float worldY) const {
+    // Nearest grid cell, then whether the point is on its button rather than in the gap
+    int col = (int)std::floor((worldX - m_GridLeft) / SPACING_X + 0.5f);
+    int row = (int)std::floor((m_GridTop - worldY) / SPACING_Y + 0.5f);
+    if (col < 0 || col >= m_Columns || row < 0) {
+        return -1;
+    }
+    int index = row * m_Columns + col;
+    if (index >= m_LevelManager->GetLevelCount()) {
+        return -1;
+    }
+    glm::vec2 center = GetButtonCenter(index);
+    if (std::abs(worldX - center.x) > BUTTON_WIDTH * 0.5f || std::abs(worldY - center.y) > BUTTON_HEIGHT * 0.5f) {
+        return -1;
+    }
+    return index;
+}
+
+void MenuLayer::UpdateScroll(float deltaTime) {
+    // A held grid follows the cursor events instead
+    if (!m_IsPressed) {
+        m_ScrollOffset += m_ScrollVelocity * deltaTime;
+        m_ScrollVelocity *= std::exp(-SCROLL_FRICTION * deltaTime);
+        if (std::abs(m_ScrollVelocity) < MIN_SCROLL_VELOCITY) {
+            m_ScrollVelocity = 0.0f;
+        }
+    }
+
+    if (m_ScrollOffset < 0.0f || m_ScrollOffset > m_MaxScrollOffset) {
+        m_ScrollOffset = std::min(std::max(m_ScrollOffset, 0.0f), m_MaxScrollOffset);
+        m_ScrollVelocity = 0.0f;
+    }
+    m_ViewMatrix = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, m_ScrollOffset, 0.0f));
+}
+
+void MenuLayer::UpdateVisibleRows() {
     int levelCount = m_LevelManager->GetLevelCount();
-    int columns = 2;
-    int rows = (levelCount + columns - 1) / columns;
-    
-    float buttonWidth = 1.5f;
-    float buttonHeight = 0.8f;
-    float spacingX = 2.0f;
-    float spacingY = 1.2f;
-    
-    float startX = -1.5f;
-    float startY = 2.5f;
-    
-    for (int i = 0; i < levelCount; ++i) {
-        int col = i % columns;
-        int row = i / columns;
-        
-        float x = startX + col * spacingX;
-        float y = startY - row * spacingY;
-        
-        // Create button as a rectangle
-        // Color: light gray for unselected, will change on hover
-        Rectangle* button = new Rectangle(
-            x - buttonWidth / 2, y + buttonHeight / 2,
-            x + buttonWidth / 2, y - buttonHeight / 2,
-            true
-        );
-        button->SetColor(0.7f, 0.7f, 0.7f);  // Light gray
-        
-        m_LevelButtons.push_back(button);
-    }
-}
-
-void MenuLayer::OnRender() {
-    m_Shader.Bind();
-    
-    const glm::mat4& proj = m_WindowContext->GetProjectionMatrix();
-    const glm::mat4& view = m_ViewMatrix;
-    
-    m_Shader.SetUniformMat4f("u_Projection", proj);
-    m_Shader.SetUniformMat4f("u_View", view);
-    
-    // Render all level buttons
-    for (size_t i = 0; i < m_LevelButtons.size(); ++i) {
-        Rectangle* button = m_LevelButtons[i];
-        
-        // Highlight hovered button
-        if ((int)i == m_HoveredButton) {
-            button->SetColor(0.9f, 0.9f, 0.5f);  // Yellow highlight
-        } else {
-            button->SetColor(0.7f, 0.7f, 0.7f);  // Normal gray
+    int rows = (levelCount + m_Columns - 1) / m_Columns;
+
+    // Rows overlapping the visible range, in grid coordinates, anywhere between the last two
+    // steps since rendering interpolates between them
+    float top = m_VisibleTop - std::min(m_ScrollOffset, m_PreviousScrollOffset);
+    float bottom = m_VisibleBottom - std::max(m_ScrollOffset, m_PreviousScrollOffset);
+    int firstRow = std::max(0, (int)std::floor((m_GridTop - top - BUTTON_HEIGHT * 0.5f) / SPACING_Y));
+    int lastRow = std::min(rows - 1, (int)std::floor((m_GridTop - bottom + BUTTON_HEIGHT * 0.5f) / SPACING_Y));
+    if (firstRow != m_FirstVisibleRow || lastRow != m_LastVisibleRow) {
+        m_FirstVisibleRow = firstRow;
+        m_LastVisibleRow = lastRow;
+        m_IsDirty = true;
+    }
+}
+
+void MenuLayer::RenderButtons(const MenuFrame& frame) {
+    m_Thumbnails.BeginFrame();
+    for (int i = frame.firstLevel; i < frame.endLevel; ++i) {
+        m_Thumbnails.Request(i);
+    }
+    bool isDirty = m_Thumbnails.Update() || frame.isDirty;
+
+    if (isDirty) {
+        m_VisibleButtons.clear();
+        for (int i = frame.firstLevel; i < frame.endLevel; ++i) {
+            glm::vec2 center = GetButtonCenter(frame.columns, frame.gridLeft, frame.gridTop, i);
+            ButtonInstance button;
+            button.rect = glm::vec4(center.x - BUTTON_WIDTH / 2, center.y - BUTTON_HEIGHT / 2,
+                                    center.x + BUTTON_WIDTH / 2, center.y + BUTTON_HEIGHT / 2);
+            button.uv = m_Thumbnails.GetCellUV(i);
+            button.color = i == frame.hoveredButton ? BUTTON_HOVER_COLOR : BUTTON_COLOR;
+            m_VisibleButtons.push_back(button);
+        }
+    }
+    if (m_VisibleButtons.empty()) {
+        return;
+    }
+
+    if (isDirty) {
+        // The instance buffer only grows, when a larger window shows more rows
+        if ((int)m_VisibleButtons.size() > m_InstanceCapacity) {
+            m_InstanceCapacity = m_VisibleButtons.size() * 2;
+
+            BufferLayout instanceLayout;
+            instanceLayout.PushFloat(4);  // Rect
+            instanceLayout.PushFloat(4);  // Thumbnail UV
+            instanceLayout.PushFloat(4);  // Color
+            m_ButtonVAO->SetInstanceData(nullptr, m_InstanceCapacity * sizeof(ButtonInstance), &instanceLayout);
         }
-        
-        const glm::mat4& model = button->GetModelMatrix();
-        m_Shader.SetUniformMat4f("u_Model", model);
-        m_Renderer.Draw(button->GetVAO(), button->GetIBO(), button->GetDrawnMode());
+        m_ButtonVAO->UpdateInstanceData(0, m_VisibleButtons.data(), m_VisibleButtons.size() * sizeof(ButtonInstance));
     }
+
+    m_ButtonShader.Bind();
+    m_ButtonShader.SetUniformMat4f("u_Projection", frame.projection);
+    m_ButtonShader.SetUniformMat4f("u_View", frame.view);
+    m_ButtonShader.SetUniform1i("u_Atlas", 0);
+    m_ButtonShader.SetUniform4f("u_ShapeColor", THUMBNAIL_COLOR.x, THUMBNAIL_COLOR.y, THUMBNAIL_COLOR.z, THUMBNAIL_COLOR.w);
+    m_Thumbnails.Bind(0);
+
+    // Render the visible level buttons and their thumbnails at once
+    m_Renderer.DrawInstanced(*m_ButtonVAO, *m_ButtonIBO, GL_TRIANGLES, m_VisibleButtons.size());
 }
 
-void MenuLayer::OnUpdate(GLFWwindow* window) {
-    // Check for mouse hover
-    double mouseX, mouseY;
-    glfwGetCursorPos(window, &mouseX, &mouseY);
-    
+void MenuLayer::OnRender(CommandList& commands, float alpha) {
+    MenuFrame frame;
+    frame.firstLevel = m_FirstVisibleRow * m_Columns;
+    frame.endLevel = std::min(m_LevelManager->GetLevelCount(), (m_LastVisibleRow + 1) * m_Columns);
+    frame.hoveredButton = m_HoveredButton;
+    frame.columns = m_Columns;
+    frame.gridLeft = m_GridLeft;
+    frame.gridTop = m_GridTop;
+    frame.isDirty = m_IsDirty;
+    frame.projection = m_WindowContext->GetProjectionMatrix();
+    float scrollOffset = m_PreviousScrollOffset + (m_ScrollOffset - m_PreviousScrollOffset) * alpha;
+    frame.view = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, scrollOffset, 0.0f));
+    m_IsDirty = false;
+
+    commands.AddTask([this, frame]() { RenderButtons(frame); });
+}
+
+void MenuLayer::OnUpdate(GLFWwindow* /*window*/, float deltaTime) {
+    m_PreviousScrollOffset = m_ScrollOffset;
+    UpdateLayout();
+    UpdateScroll(deltaTime);
+
+    // Check for mouse hover; nothing is highlighted while the grid is dragged
     float worldX, worldY;
-    ConvertScreenToWorld(mouseX, mouseY, worldX, worldY);
-    
-    m_HoveredButton = -1;
-    for (size_t i = 0; i < m_LevelButtons.size(); ++i) {
-        if (m_LevelButtons[i]->IsInside(worldX, worldY)) {
-            m_HoveredButton = i;
-            break;
-        }
+    ConvertScreenToWorld(m_CursorX, m_CursorY, worldX, worldY);
+
+    int hoveredButton = m_IsDragging ? -1 : FindButton(worldX, worldY);
+    if (hoveredButton != m_HoveredButton) {
+        m_HoveredButton = hoveredButton;
+        m_IsDirty = true;
     }
+
+    UpdateVisibleRows();
 }
 
 void MenuLayer::ConvertScreenToNDC(double mouseX, double mouseY, float& outX, float& outY) {
-    int windowWidth, windowHeight;
-    glfwGetWindowSize(m_WindowContext->GetWindow(), &windowWidth, &windowHeight);
-    
+    int windowWidth = m_WindowContext->GetWindowWidth();
+    int windowHeight = m_WindowContext->GetWindowHeight();
+
     outX = (mouseX / (float)windowWidth) * 2.0f - 1.0f;
     outY = 1.0f - (mouseY / (float)windowHeight) * 2.0f;
 }
@@ -109,43 +286,129 @@ void MenuLayer::ConvertScreenToNDC(double mouseX, double mouseY, float& outX, fl
 void MenuLayer::ConvertScreenToWorld(double mouseX, double mouseY, float& outX, float& outY) {
     float ndcX, ndcY;
     ConvertScreenToNDC(mouseX, mouseY, ndcX, ndcY);
-    
+
     glm::mat4 proj = m_WindowContext->GetProjectionMatrix();
     glm::mat4 view = m_ViewMatrix;
     glm::mat4 invVP = glm::inverse(proj * view);
-    
+
     glm::vec4 worldPos = invVP * glm::vec4(ndcX, ndcY, 0.0f, 1.0f);
     outX = worldPos.x;
     outY = worldPos.y;
 }
 
 void MenuLayer::OnKeyEvent(int key, int /*scancode*/, int action, int mods) {
-    if (!(action == GLFW_PRESS)) {
+    if (!(action == GLFW_PRESS || action == GLFW_REPEAT)) {
         return;
     }
-    
-    if (key == GLFW_KEY_Q && (mods & GLFW_MOD_CONTROL)) {
-        std::cout << "Quitting application..." << std::endl;
+
+    // A page glides by one screen: the speed that friction brings to rest after that distance
+    float page = m_VisibleTop - m_VisibleBottom - 2.0f * GRID_MARGIN;
+    if (key == GLFW_KEY_PAGE_DOWN) {
+        m_ScrollVelocity = page * SCROLL_FRICTION;
+    } else if (key == GLFW_KEY_PAGE_UP) {
+        m_ScrollVelocity = -page * SCROLL_FRICTION;
+    } else if (key == GLFW_KEY_HOME) {
+        m_ScrollOffset = 0.0f;
+        m_PreviousScrollOffset = m_ScrollOffset;
+        m_ScrollVelocity = 0.0f;
+    } else if (key == GLFW_KEY_END) {
+        m_ScrollOffset = m_MaxScrollOffset;
+        m_PreviousScrollOffset = m_ScrollOffset;
+        m_ScrollVelocity = 0.0f;
+    }
+
+    if (key == GLFW_KEY_Q && (mods & GLFW_MOD_CONTROL) && action == GLFW_PRESS) {
+        LOG_INFO(MENU, "Quitting application...");
         GLFWwindow* window = m_WindowContext->GetWindow();
         glfwSetWindowShouldClose(window, GLFW_TRUE);
     }
 }
 
-void MenuLayer::OnMouseButtonEvent(int button, int action, int /*mods*/, double mouseX, double mouseY) {
-    if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_PRESS) {
+void MenuLayer::OnInputEvents(const InputEvent* events, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const InputEvent& event = events[i];
+        switch (event.type) {
+            case InputEventType::KEY:
+                OnKeyEvent(event.code, event.scancode, event.action, event.mods);
+                break;
+            case InputEventType::MOUSE_BUTTON:
+                m_CursorX = event.x;
+                m_CursorY = event.y;
+                OnMouseButtonEvent(event.code, event.action, event.mods, event.x, event.y, event.time);
+                break;
+            case InputEventType::CURSOR_MOVE:
+                OnCursorMoveEvent(event.x, event.y, event.time);
+                break;
+            case InputEventType::SCROLL:
+                OnScrollEvent(event.x, event.y);
+                break;
+        }
+    }
+}
+
+void MenuLayer::OnCursorMoveEvent(double mouseX, double mouseY, double time) {
+    m_CursorX = mouseX;
+    m_CursorY = mouseY;
+    if (!m_IsPressed) {
+        return;
+    }
+
+    if (!m_IsDragging && std::abs(mouseY - m_PressY) + std::abs(mouseX - m_PressX) > DRAG_THRESHOLD) {
+        m_IsDragging = true;
+    }
+    if (m_IsDragging) {
+        // The grid follows the cursor, and the speed it is released with carries on. The event
+        // times give that speed, however many simulation steps the frames happen to take.
+        // Cursor positions are in window coordinates, not framebuffer pixels
+        float unitsPerPixel = (m_VisibleTop - m_VisibleBottom) / std::max(m_WindowContext->GetWindowHeight(), 1);
+        float delta = (float)(m_LastDragY - mouseY) * unitsPerPixel;
+        m_ScrollOffset += delta;
+        if (time > m_LastDragTime) {
+            m_ScrollVelocity = delta / (float)(time - m_LastDragTime);
+        }
+    }
+    m_LastDragY = mouseY;
+    m_LastDragTime = time;
+}
+
+void MenuLayer::OnScrollEvent(double /*offsetX*/, double offsetY) {
+    // Wheel up moves towards the first level
+    m_ScrollVelocity -= (float)offsetY * WHEEL_IMPULSE;
+}
+
+void MenuLayer::OnMouseButtonEvent(int button, int action, int /*mods*/, double mouseX, double mouseY, double time) {
+    if (button != GLFW_MOUSE_BUTTON_LEFT) {
+        return;
+    }
+
+    if (action == GLFW_PRESS) {
+        // Grabbing the grid stops it
+        m_IsPressed = true;
+        m_IsDragging = false;
+        m_PressX = mouseX;
+        m_PressY = mouseY;
+        m_LastDragY = mouseY;
+        m_LastDragTime = time;
+        m_ScrollVelocity = 0.0f;
+    } else if (action == GLFW_RELEASE && m_IsPressed) {
+        bool isClick = !m_IsDragging;
+        if (time - m_LastDragTime > FLICK_TIMEOUT) {
+            m_ScrollVelocity = 0.0f;
+        }
+        m_IsPressed = false;
+        m_IsDragging = false;
+        if (!isClick) {
+            return;
+        }
+
         float worldX, worldY;
         ConvertScreenToWorld(mouseX, mouseY, worldX, worldY);
-        
+
         // Check which button was clicked
-        for (size_t i = 0; i < m_LevelButtons.size(); ++i) {
-            if (m_LevelButtons[i]->IsInside(worldX, worldY)) {
-                m_SelectedLevel = i;
-                Level* level = m_LevelManager->GetLevel(i);
-                if (level) {
-                    std::cout << "Selected Level " << (i + 1) << ": " << level->GetName() << std::endl;
-                }
-                break;
-            }
+        int clickedButton = FindButton(worldX, worldY);
+        if (clickedButton >= 0) {
+            m_SelectedLevel = clickedButton;
+            LOG_INFO(MENU, "Selected Level " << (clickedButton + 1) << ": " << m_LevelManager->GetLevelName(clickedButton));
         }
     }
 }
@@ -0,0 +1,281 @@
+#include "PieceGeometry.h"
+#include <algorithm>
+#include <cmath>
+
+static const int PIECE_TYPE_COUNT = 5;
+static const int ORIENTATION_COUNT = 16;  // 8 rotations x 2 flip states
+
+static const float ROTATION_STEP = (float)M_PI / 4.0f;
+
+// Rotation must be within this many radians of a multiple of 45 degrees
+static const float ROTATION_TOLERANCE = 0.05f;
+
+PieceType GetPieceTypeForIndex(int pieceIndex) {
+    switch (pieceIndex) {
+        case 0:
+        case 1:
+            return PieceType::LARGE_TRIANGLE;
+        case 2:
+            return PieceType::MEDIUM_TRIANGLE;
+        case 3:
+        case 4:
+            return PieceType::SMALL_TRIANGLE;
+        case 5:
+            return PieceType::SQUARE;
+        default:
+            return PieceType::PARALLELOGRAM;
+    }
+}
+
+static std::vector<LatticePoint> MakeTriangle(const LatticeScalar& size) {
+    // Right angle at the anchor: top, bottom-left, bottom-right (see TangramTriangle)
+    LatticeScalar zero;
+    return {
+        LatticePoint(zero, size),
+        LatticePoint(zero, zero),
+        LatticePoint(size, zero)
+    };
+}
+
+static std::vector<LatticePoint> MakeSquare() {
+    // Side sqrt(2)/2 centered on the anchor (see TangramSquare)
+    LatticeScalar half(0, 1);
+    return {
+        LatticePoint(-half, half),
+        LatticePoint(-half, -half),
+        LatticePoint(half, -half),
+        LatticePoint(half, half)
+    };
+}
+
+static std::vector<LatticePoint> MakeParallelogram() {
+    // Width 1, height 1/2, 45 degree slant (see TangramParallelogram)
+    LatticeScalar zero;
+    LatticeScalar half(2, 0);
+    LatticeScalar one(4, 0);
+    return {
+        LatticePoint(zero, half),
+        LatticePoint(-half, zero),
+        LatticePoint(half, zero),
+        LatticePoint(one, half)
+    };
+}
+
+const std::vector<LatticePoint>& GetPieceOutline(PieceType type) {
+    static const std::vector<LatticePoint> outlines[PIECE_TYPE_COUNT] = {
+        MakeTriangle(LatticeScalar(0, 4)),   // Large: legs sqrt(2)
+        MakeTriangle(LatticeScalar(4, 0)),   // Medium: legs 1
+        MakeTriangle(LatticeScalar(0, 2)),   // Small: legs sqrt(2)/2
+        MakeSquare(),
+        MakeParallelogram()
+    };
+    return outlines[(int)type];
+}
+
+glm::vec2 GetPieceCenterOffset(PieceType type) {
+    switch (type) {
+        case PieceType::LARGE_TRIANGLE:
+            return glm::vec2(1.41421356f / 3.0f);
+        case PieceType::MEDIUM_TRIANGLE:
+            return glm::vec2(1.0f / 3.0f);
+        case PieceType::SMALL_TRIANGLE:
+            return glm::vec2(0.70710678f / 3.0f);
+        case PieceType::SQUARE:
+            return glm::vec2(0.0f);
+        case PieceType::PARALLELOGRAM:
+            return glm::vec2(0.25f);
+    }
+    return glm::vec2(0.0f);
+}
+
+struct OrientationTable {
+    std::vector<LatticePoint> outlines[PIECE_TYPE_COUNT][ORIENTATION_COUNT];
+};
+
+static OrientationTable BuildOrientationTable() {
+    OrientationTable table;
+    for (int t = 0; t < PIECE_TYPE_COUNT; ++t) {
+        const std::vector<LatticePoint>& outline = GetPieceOutline((PieceType)t);
+        for (int orientation = 0; orientation < ORIENTATION_COUNT; ++orientation) {
+            bool isFlipped = orientation >= 8;
+            for (const LatticePoint& vertex : outline) {
+                LatticePoint local = isFlipped ? vertex.Flipped() : vertex;
+                // Always exact: the outlines are laid out around their anchor for it
+                LatticePoint rotated;
+                local.Rotated(orientation % 8, rotated);
+                table.outlines[t][orientation].push_back(rotated);
+            }
+        }
+    }
+    return table;
+}
+
+// Outline offsets for every orientation, computed once so placing a piece is only additions
+static const std::vector<LatticePoint>& GetOrientedOutline(PieceType type, int rotation, bool flipped) {
+    static const OrientationTable table = BuildOrientationTable();
+
+    int steps = ((rotation % 8) + 8) % 8;
+    return table.outlines[(int)type][steps + (flipped ? 8 : 0)];
+}
+
+void GetPlacedOutline(PieceType type, const LatticePose& pose, std::vector<LatticePoint>& outVertices) {
+    const std::vector<LatticePoint>& offsets = GetOrientedOutline(type, pose.rotation, pose.isFlipped);
+
+    outVertices.clear();
+    for (const LatticePoint& offset : offsets) {
+        outVertices.push_back(pose.anchor + offset);
+    }
+}
+
+bool IsSamePlacement(PieceType type, const LatticePose& a, const LatticePose& b) {
+    std::vector<LatticePoint> outlineA;
+    std::vector<LatticePoint> outlineB;
+    GetPlacedOutline(type, a, outlineA);
+    GetPlacedOutline(type, b, outlineB);
+
+    std::sort(outlineA.begin(), outlineA.end());
+    std::sort(outlineB.begin(), outlineB.end());
+    return outlineA == outlineB;
+}
+
+bool ToLatticePose(PieceType type, const PiecePosition& position, float tolerance, LatticePose& outPose) {
+    float steps = position.rotation / ROTATION_STEP;
+    float roundedSteps = std::round(steps);
+    if (std::fabs(steps - roundedSteps) * ROTATION_STEP > ROTATION_TOLERANCE) {
+        return false;
+    }
+
+    // Anchor = center - R * F * centerOffset, the inverse of the ghost piece transform
+    glm::vec2 offset = GetPieceCenterOffset(type);
+    if (position.isFlipped) {
+        offset.x = -offset.x;
+    }
+    float c = std::cos(position.rotation);
+    float s = std::sin(position.rotation);
+    glm::vec2 rotated(c * offset.x - s * offset.y, s * offset.x + c * offset.y);
+
+    if (!LatticePoint::FromVec2(position.position - rotated, tolerance, outPose.anchor)) {
+        return false;
+    }
+
+    outPose.rotation = (((int)roundedSteps % 8) + 8) % 8;
+    outPose.isFlipped = position.isFlipped;
+    return true;
+}
+
+PiecePosition ToPiecePosition(PieceType type, int pieceIndex, const LatticePose& pose) {
+    float rotation = pose.rotation * ROTATION_STEP;
+
+    glm::vec2 offset = GetPieceCenterOffset(type);
+    if (pose.isFlipped) {
+        offset.x = -offset.x;
+    }
+    float c = std::cos(rotation);
+    float s = std::sin(rotation);
+    glm::vec2 rotated(c * offset.x - s * offset.y, s * offset.x + c * offset.y);
+
+    PiecePosition position;
+    position.pieceIndex = pieceIndex;
+    position.position = pose.anchor.ToVec2() + rotated;
+    position.rotation = rotation;
+    position.isFlipped = pose.isFlipped;
+    return position;
+}
+
+LatticeProduct GetDoubleArea(const std::vector<LatticePoint>& polygon) {
+    LatticeProduct area;
+    size_t count = polygon.size();
+    for (size_t i = 0; i < count; ++i) {
+        const LatticePoint& current = polygon[i];
+        const LatticePoint& next = polygon[(i + 1) % count];
+        area = area + (current.x * next.y - next.x * current.y);
+    }
+    return area;
+}
+
+static int CompareProducts(const LatticeProduct& lhs, const LatticeProduct& rhs) {
+    return (lhs - rhs).Sign();
+}
+
+bool IsInsideSegment(const LatticePoint& a, const LatticePoint& b, const LatticePoint& p) {
+    if (Cross(a, b, p).Sign() != 0 || p == a || p == b) {
+        return false;
+    }
+    bool insideX = (std::min(a.x, b.x) < p.x || p.x == std::min(a.x, b.x)) && (p.x < std::max(a.x, b.x) || p.x == std::max(a.x, b.x));
+    bool insideY = (std::min(a.y, b.y) < p.y || p.y == std::min(a.y, b.y)) && (p.y < std::max(a.y, b.y) || p.y == std::max(a.y, b.y));
+    return insideX && insideY;
+}
+
+bool IsStrictlyInsidePolygon(const std::vector<LatticePoint>& polygon, const LatticePoint& p) {
+    bool isInside = false;
+    size_t count = polygon.size();
+    for (size_t i = 0, j = count - 1; i < count; j = i++) {
+        const LatticePoint& a = polygon[j];
+        const LatticePoint& b = polygon[i];
+        bool aBelow = a.y < p.y || a.y == p.y;
+        bool bBelow = b.y < p.y || b.y == p.y;
+        if (aBelow == bBelow) {
+            continue;
+        }
+        // Upward edges count when p is on their left, downward ones when it is on their right
+        int side = Cross(a, b, p).Sign();
+        if ((bBelow ? -side : side) > 0) {
+            isInside = !isInside;
+        }
+    }
+    return isInside;
+}
+
+bool IsOnPolygonBoundary(const std::vector<LatticePoint>& polygon, const LatticePoint& p) {
+    size_t count = polygon.size();
+    for (size_t i = 0; i < count; ++i) {
+        if (polygon[i] == p || IsInsideSegment(polygon[i], polygon[(i + 1) % count], p)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool DoInteriorsOverlap(const std::vector<LatticePoint>& a, const std::vector<LatticePoint>& b) {
+    const std::vector<LatticePoint>* shapes[2] = {&a, &b};
+    for (const std::vector<LatticePoint>* shape : shapes) {
+        size_t count = shape->size();
+        for (size_t i = 0; i < count; ++i) {
+            const LatticePoint& start = (*shape)[i];
+            const LatticePoint& end = (*shape)[(i + 1) % count];
+            LatticeScalar normalX = -(end.y - start.y);
+            LatticeScalar normalY = end.x - start.x;
+
+            LatticeProduct minA, maxA, minB, maxB;
+            for (size_t k = 0; k < a.size(); ++k) {
+                LatticeProduct projection = a[k].x * normalX + a[k].y * normalY;
+                if (k == 0 || CompareProducts(projection, minA) < 0) minA = projection;
+                if (k == 0 || CompareProducts(projection, maxA) > 0) maxA = projection;
+            }
+            for (size_t k = 0; k < b.size(); ++k) {
+                LatticeProduct projection = b[k].x * normalX + b[k].y * normalY;
+                if (k == 0 || CompareProducts(projection, minB) < 0) minB = projection;
+                if (k == 0 || CompareProducts(projection, maxB) > 0) maxB = projection;
+            }
+
+            if (CompareProducts(maxA, minB) <= 0 || CompareProducts(maxB, minA) <= 0) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+int GetLatticeDirection(const LatticePoint& from, const LatticePoint& to) {
+    LatticeScalar dx = to.x - from.x;
+    LatticeScalar dy = to.y - from.y;
+    int sx = dx.Sign();
+    int sy = dy.Sign();
+
+    if (sx == 0 && sy == 0) return -1;
+    if (sy == 0) return (sx > 0) ? 0 : 4;
+    if (sx == 0) return (sy > 0) ? 2 : 6;
+    if (dx == dy) return (sx > 0) ? 1 : 5;
+    if (dx == -dy) return (sx < 0) ? 3 : 7;
+    return -1;
+}
@@ -2,11 +2,11 @@
 #include "BufferLayout.h"
 #include "IndexBuffer.h"
 #include "VertexArray.h"
+#include "Log.h"
 #include <ostream>
 #include <glad.h> 
 #include <GLFW/glfw3.h> 
 #include <GL/glu.h>
-#include <iostream>
 #include <cmath>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -159,6 +159,14 @@ void Polygon::SetColor(float r, float g, float b){
 	m_VertexArray->SetData(m_Vertices.data(), m_Vertices.size()*sizeof(float) , &m_BufferLayout);
 }
 
+glm::vec3 Polygon::GetColor() const{
+	//Every vertex carries the same color
+	if (m_Vertices.size() < 6){
+		return glm::vec3(1.0f, 1.0f, 1.0f);
+	}
+	return glm::vec3(m_Vertices[2], m_Vertices[3], m_Vertices[4]);
+}
+
 bool Polygon::IsInside(float ndcX, float ndcY) const{
 	int numVertices = m_Vertices.size() / 6;
 
@@ -204,7 +212,7 @@ void Polygon::AddTessVertex(void* vertex_data){
 // Tesselator callbacks (GLU)
 // ------------------------------------------------------------
 static void  tess_begin_callback(GLenum type, void* polygon_data){
-    std::cout << "Tesselator: Starting mode" << type << std::endl;
+    LOG_DEBUG(RENDER, "Tesselator: Starting mode" << type);
 }
 
 static void  tess_vertex_callback(void* vertex_data, void* polygon_data){
@@ -213,11 +221,11 @@ static void  tess_vertex_callback(void* vertex_data, void* polygon_data){
 }
 
 static void  tess_end_callback(void* polygon_data){
-    std::cout << "Tesselator: End of outline" << std::endl;
+    LOG_DEBUG(RENDER, "Tesselator: End of outline");
 }
 
 static void  tess_error_callback(GLenum errorCode, void* polygon_data){
-    std::cerr << "Erro on Tesselator: " << gluErrorString(errorCode) << std::endl;
+    LOG_ERROR(RENDER, "Erro on Tesselator: " << gluErrorString(errorCode));
 }
 
 void Polygon::FinalizeShape(){
@@ -226,7 +234,7 @@ void Polygon::FinalizeShape(){
 
     GLUtesselator* tess = gluNewTess();
     if (!tess) {
-        std::cerr << "Failed to create the GLU Tesselator" << std::endl;
+        LOG_ERROR(RENDER, "Failed to create the GLU Tesselator");
         return;
     }
 
@@ -252,6 +260,7 @@ void Polygon::FinalizeShape(){
     gluTessEndContour(tess);
     gluTessEndPolygon(tess);
 
+    GetOutline(m_Outline);
     m_Vertices = m_TessVertices;
     m_Indices = m_TessIndices;
 
@@ -262,3 +271,15 @@ void Polygon::FinalizeShape(){
 
     m_IsFinalized = true;
 }
+
+void Polygon::GetOutline(std::vector<glm::vec2>& outVertices) const {
+    if (m_IsFinalized) {
+        outVertices = m_Outline;
+        return;
+    }
+
+    outVertices.clear();
+    for (size_t i = 0; i < m_Vertices.size(); i += 6) {
+        outVertices.push_back(glm::vec2(m_Vertices[i], m_Vertices[i + 1]));
+    }
+}
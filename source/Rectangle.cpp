@@ -70,6 +70,14 @@ void Rectangle::SetColor(float r, float g, float b){
 	m_VertexArray->SetData(m_Vertices.data(), m_Vertices.size()*sizeof(float) , &m_BufferLayout);
 }
 
+glm::vec3 Rectangle::GetColor() const{
+	//Every vertex carries the same color
+	if (m_Vertices.size() < 6){
+		return glm::vec3(1.0f, 1.0f, 1.0f);
+	}
+	return glm::vec3(m_Vertices[2], m_Vertices[3], m_Vertices[4]);
+}
+
 bool Rectangle::IsInside(float ndcX, float ndcY) const{
 	float leftX   = std::min(m_AnchorX, m_CurrentX);
     float rightX  = std::max(m_AnchorX, m_CurrentX);
@@ -144,3 +152,10 @@ Rectangle::~Rectangle(){
 
 void Rectangle::AddPoint(double x, double y){}
 void Rectangle::FinalizeShape(){}
+
+void Rectangle::GetOutline(std::vector<glm::vec2>& outVertices) const {
+    outVertices.clear();
+    for (size_t i = 0; i < m_Vertices.size(); i += 6) {
+        outVertices.push_back(glm::vec2(m_Vertices[i], m_Vertices[i + 1]));
+    }
+}
@@ -0,0 +1,112 @@
+#include "RenderThread.h"
+#include "Application.h"
+#include <glad.h>
+#include <GLFW/glfw3.h>
+
+RenderThread::RenderThread(Application* window, bool isThreaded)
+    : m_Window(window)
+    , m_IsThreaded(isThreaded)
+    , m_IsRunning(false)
+    , m_IsListBusy{false, false}
+    , m_RecordIndex(0)
+    , m_PendingIndex(-1)
+    , m_Work(nullptr)
+    , m_IsStopping(false) {
+}
+
+RenderThread::~RenderThread() {
+    Stop();
+}
+
+void RenderThread::Start() {
+    if (!m_IsThreaded || m_IsRunning) {
+        return;
+    }
+    // A context is current on one thread at a time
+    glfwMakeContextCurrent(nullptr);
+    m_IsStopping = false;
+    m_IsRunning = true;
+    m_Thread = std::thread(&RenderThread::Run, this);
+}
+
+void RenderThread::Stop() {
+    if (!m_IsRunning) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_IsStopping = true;
+    }
+    m_Condition.notify_all();
+    m_Thread.join();
+    m_IsRunning = false;
+    glfwMakeContextCurrent(m_Window->GetWindow());
+}
+
+void RenderThread::Invoke(const std::function<void()>& work) {
+    if (!m_IsRunning) {
+        work();
+        return;
+    }
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_Work = &work;
+    m_Condition.notify_all();
+    m_Condition.wait(lock, [this]() { return m_Work == nullptr; });
+}
+
+CommandList& RenderThread::BeginFrame() {
+    if (m_IsRunning) {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_Condition.wait(lock, [this]() { return !m_IsListBusy[m_RecordIndex]; });
+    }
+    return m_Lists[m_RecordIndex];
+}
+
+void RenderThread::Submit() {
+    if (!m_IsRunning) {
+        Present(m_Lists[m_RecordIndex]);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_IsListBusy[m_RecordIndex] = true;
+        m_PendingIndex = m_RecordIndex;
+    }
+    m_Condition.notify_all();
+    m_RecordIndex ^= 1;
+}
+
+void RenderThread::Present(CommandList& list) {
+    list.Execute(m_Renderer);
+    glfwSwapBuffers(m_Window->GetWindow());
+    list.SetPresentTime(glfwGetTime());
+}
+
+void RenderThread::Run() {
+    glfwMakeContextCurrent(m_Window->GetWindow());
+
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    for (;;) {
+        m_Condition.wait(lock, [this]() { return m_PendingIndex != -1 || m_Work != nullptr || m_IsStopping; });
+
+        // Lists first: work handed to Invoke may destroy what they draw
+        if (m_PendingIndex != -1) {
+            int index = m_PendingIndex;
+            m_PendingIndex = -1;
+            lock.unlock();
+            Present(m_Lists[index]);
+            lock.lock();
+            m_IsListBusy[index] = false;
+            m_Condition.notify_all();
+        } else if (m_Work != nullptr) {
+            (*m_Work)();
+            m_Work = nullptr;
+            m_Condition.notify_all();
+        } else {
+            break;
+        }
+    }
+    lock.unlock();
+
+    glfwMakeContextCurrent(nullptr);
+}
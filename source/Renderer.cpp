@@ -11,7 +11,16 @@ void Renderer::Draw(const VertexArray& vertexarray, const IndexBuffer& indexBuff
 
 	indexBuffer.Bind();
 
-	glDrawElements(DrawnMode,indexBuffer.GetCount(),GL_UNSIGNED_INT, (void*)0);
+	glDrawElements(DrawnMode,indexBuffer.GetCount(),indexBuffer.GetIndexType(), (void*)0);
+}
+
+void Renderer::DrawInstanced(const VertexArray& vertexarray, const IndexBuffer& indexBuffer, GLenum DrawnMode, unsigned int instanceCount){
+
+	vertexarray.Bind();
+
+	indexBuffer.Bind();
+
+	glDrawElementsInstanced(DrawnMode, indexBuffer.GetCount(), indexBuffer.GetIndexType(), (void*)0, instanceCount);
 }
 
 void Renderer::Unbind(const VertexArray& vertexarray, const IndexBuffer& indexBuffer, const Shader& shader){
@@ -0,0 +1,134 @@
+#include "ShapeArena.h"
+
+ShapeArena::ShapeArena()
+    : m_FreeSlot(UINT32_MAX) {
+}
+
+ShapeArena::~ShapeArena() {
+    Clear();
+}
+
+ShapeHandle ShapeArena::Register(Shape* shape, ShapeKind kind) {
+    uint32_t index;
+    if (m_FreeSlot != UINT32_MAX) {
+        index = m_FreeSlot;
+        m_FreeSlot = m_Slots[index].livePosition;
+    } else {
+        index = m_Slots.size();
+        m_Slots.push_back({nullptr, 0, 0, kind, false});
+    }
+
+    HandleSlot& slot = m_Slots[index];
+    slot.shape = shape;
+    slot.kind = kind;
+    slot.isHidden = false;
+    slot.livePosition = m_Live.size();
+
+    m_Live.push_back(shape);
+    m_LiveSlots.push_back(index);
+
+    return ShapeHandle(index, slot.generation);
+}
+
+ShapeHandle ShapeArena::CreateRectangle(float x1, float y1, float x2, float y2, bool isFilled) {
+    return Register(m_Rectangles.Create(x1, y1, x2, y2, isFilled), ShapeKind::RECTANGLE);
+}
+
+ShapeHandle ShapeArena::CreateTriangle(float x1, float y1, float x2, float y2, bool isFilled) {
+    return Register(m_Triangles.Create(x1, y1, x2, y2, isFilled), ShapeKind::TRIANGLE);
+}
+
+ShapeHandle ShapeArena::CreateCircle(float x1, float y1, float x2, float y2, bool isFilled) {
+    return Register(m_Circles.Create(x1, y1, x2, y2, isFilled), ShapeKind::CIRCLE);
+}
+
+ShapeHandle ShapeArena::CreatePolygon(float x1, float y1, bool isFilled) {
+    return Register(m_Polygons.Create(x1, y1, isFilled), ShapeKind::POLYGON);
+}
+
+Shape* ShapeArena::Get(ShapeHandle handle) const {
+    if (handle.index >= m_Slots.size()) {
+        return nullptr;
+    }
+    const HandleSlot& slot = m_Slots[handle.index];
+    if (slot.generation != handle.generation) {
+        return nullptr;
+    }
+    return slot.shape;
+}
+
+ShapeHandle ShapeArena::GetHandle(size_t position) const {
+    uint32_t index = m_LiveSlots[position];
+    return ShapeHandle(index, m_Slots[index].generation);
+}
+
+void ShapeArena::Destroy(ShapeHandle handle) {
+    Shape* shape = Get(handle);
+    if (shape == nullptr) {
+        return;
+    }
+
+    HandleSlot& slot = m_Slots[handle.index];
+    if (!slot.isHidden) {
+        RemoveFromLive(slot);
+    }
+
+    switch (slot.kind) {
+        case ShapeKind::RECTANGLE: m_Rectangles.Destroy(static_cast<Rectangle*>(shape)); break;
+        case ShapeKind::TRIANGLE: m_Triangles.Destroy(static_cast<Triangle*>(shape)); break;
+        case ShapeKind::CIRCLE: m_Circles.Destroy(static_cast<Circle*>(shape)); break;
+        case ShapeKind::POLYGON: m_Polygons.Destroy(static_cast<Polygon*>(shape)); break;
+    }
+
+    slot.shape = nullptr;
+    slot.generation++;
+    slot.livePosition = m_FreeSlot;
+    m_FreeSlot = handle.index;
+}
+
+void ShapeArena::RemoveFromLive(HandleSlot& slot) {
+    // Swap-remove from the live list and patch the moved shape's position
+    uint32_t position = slot.livePosition;
+    uint32_t lastSlot = m_LiveSlots.back();
+    m_Live[position] = m_Live.back();
+    m_LiveSlots[position] = lastSlot;
+    m_Slots[lastSlot].livePosition = position;
+    m_Live.pop_back();
+    m_LiveSlots.pop_back();
+}
+
+void ShapeArena::Hide(ShapeHandle handle) {
+    if (Get(handle) == nullptr || m_Slots[handle.index].isHidden) {
+        return;
+    }
+    HandleSlot& slot = m_Slots[handle.index];
+    RemoveFromLive(slot);
+    slot.isHidden = true;
+}
+
+void ShapeArena::Show(ShapeHandle handle) {
+    if (Get(handle) == nullptr || !m_Slots[handle.index].isHidden) {
+        return;
+    }
+    HandleSlot& slot = m_Slots[handle.index];
+    slot.isHidden = false;
+    slot.livePosition = m_Live.size();
+    m_Live.push_back(slot.shape);
+    m_LiveSlots.push_back(handle.index);
+}
+
+bool ShapeArena::IsHidden(ShapeHandle handle) const {
+    return Get(handle) != nullptr && m_Slots[handle.index].isHidden;
+}
+
+void ShapeArena::Clear() {
+    while (!m_Live.empty()) {
+        Destroy(GetHandle(m_Live.size() - 1));
+    }
+    // Hidden shapes are not in the live list
+    for (uint32_t i = 0; i < m_Slots.size(); ++i) {
+        if (m_Slots[i].shape != nullptr) {
+            Destroy(ShapeHandle(i, m_Slots[i].generation));
+        }
+    }
+}
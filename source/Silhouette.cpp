@@ -0,0 +1,225 @@
+#include "Silhouette.h"
+#include "PieceGeometry.h"
+#include <algorithm>
+
+static const int DIRECTION_COUNT = 8;
+
+struct Segment {
+    LatticePoint start;
+    LatticePoint end;
+
+    bool operator<(const Segment& other) const {
+        if (start != other.start) return start < other.start;
+        return end < other.end;
+    }
+    bool operator==(const Segment& other) const { return start == other.start && end == other.end; }
+};
+
+// Position of p along the segment from a, for sorting points on it
+static LatticeProduct GetProjection(const LatticePoint& a, const LatticePoint& b, const LatticePoint& p) {
+    return (p.x - a.x) * (b.x - a.x) + (p.y - a.y) * (b.y - a.y);
+}
+
+// Splits every counter-clockwise piece edge at the vertices lying on it
+static void CollectSegments(const std::vector<std::vector<LatticePoint>>& pieces, std::vector<Segment>& outSegments) {
+    std::vector<LatticePoint> vertices;
+    for (const std::vector<LatticePoint>& piece : pieces) {
+        vertices.insert(vertices.end(), piece.begin(), piece.end());
+    }
+    std::sort(vertices.begin(), vertices.end());
+    vertices.erase(std::unique(vertices.begin(), vertices.end()), vertices.end());
+
+    std::vector<LatticePoint> outline;
+    std::vector<LatticePoint> splits;
+    for (const std::vector<LatticePoint>& piece : pieces) {
+        outline = piece;
+        if (GetDoubleArea(outline).Sign() < 0) {
+            std::reverse(outline.begin(), outline.end());
+        }
+
+        size_t count = outline.size();
+        for (size_t i = 0; i < count; ++i) {
+            const LatticePoint& a = outline[i];
+            const LatticePoint& b = outline[(i + 1) % count];
+
+            splits.clear();
+            for (const LatticePoint& vertex : vertices) {
+                if (IsInsideSegment(a, b, vertex)) {
+                    splits.push_back(vertex);
+                }
+            }
+            std::sort(splits.begin(), splits.end(), [&](const LatticePoint& lhs, const LatticePoint& rhs) {
+                return (GetProjection(a, b, lhs) - GetProjection(a, b, rhs)).Sign() < 0;
+            });
+
+            LatticePoint start = a;
+            for (const LatticePoint& split : splits) {
+                outSegments.push_back({start, split});
+                start = split;
+            }
+            outSegments.push_back({start, b});
+        }
+    }
+}
+
+bool TraceSilhouette(const std::vector<std::vector<LatticePoint>>& pieces,
+                     std::vector<std::vector<LatticePoint>>& outContours) {
+    outContours.clear();
+
+    std::vector<Segment> segments;
+    CollectSegments(pieces, segments);
+    std::sort(segments.begin(), segments.end());
+    if (std::adjacent_find(segments.begin(), segments.end()) != segments.end()) {
+        return false;
+    }
+
+    // Shared edges cancel: keep a segment only when its reverse is absent
+    std::vector<Segment> boundary;
+    for (const Segment& segment : segments) {
+        if (!std::binary_search(segments.begin(), segments.end(), Segment{segment.end, segment.start})) {
+            boundary.push_back(segment);
+        }
+    }
+    // Still sorted by start point, so the segments leaving a vertex form one run
+    std::vector<bool> isUsed(boundary.size(), false);
+
+    auto findOutgoing = [&](const LatticePoint& vertex, int direction) -> int {
+        auto first = std::lower_bound(boundary.begin(), boundary.end(), vertex,
+                                      [](const Segment& segment, const LatticePoint& point) { return segment.start < point; });
+        for (auto it = first; it != boundary.end() && it->start == vertex; ++it) {
+            size_t index = it - boundary.begin();
+            if (!isUsed[index] && GetLatticeDirection(it->start, it->end) == direction) {
+                return (int)index;
+            }
+        }
+        return -1;
+    };
+
+    for (size_t first = 0; first < boundary.size(); ++first) {
+        if (isUsed[first]) {
+            continue;
+        }
+
+        std::vector<LatticePoint> contour;
+        int current = (int)first;
+        while (current >= 0 && !isUsed[current]) {
+            isUsed[current] = true;
+            const Segment& segment = boundary[current];
+            contour.push_back(segment.start);
+
+            // Sharpest left turn: sweep clockwise from the reversed incoming direction
+            int incoming = GetLatticeDirection(segment.start, segment.end);
+            int back = (incoming + DIRECTION_COUNT / 2) % DIRECTION_COUNT;
+            int next = -1;
+            for (int step = 1; step < DIRECTION_COUNT && next < 0; ++step) {
+                next = findOutgoing(segment.end, (back - step + DIRECTION_COUNT) % DIRECTION_COUNT);
+            }
+            current = next;
+        }
+
+        // Drop vertices where the outline runs straight on
+        std::vector<LatticePoint> simplified;
+        size_t count = contour.size();
+        for (size_t i = 0; i < count; ++i) {
+            const LatticePoint& previous = contour[(i + count - 1) % count];
+            const LatticePoint& next = contour[(i + 1) % count];
+            if (Cross(previous, contour[i], next).Sign() != 0) {
+                simplified.push_back(contour[i]);
+            }
+        }
+        if (simplified.size() >= 3) {
+            outContours.push_back(simplified);
+        }
+    }
+    return true;
+}
+
+bool UnitePieces(const std::vector<std::vector<LatticePoint>>& pieces,
+                 std::vector<LatticePoint>& outOuter,
+                 std::vector<std::vector<LatticePoint>>& outHoles) {
+    outOuter.clear();
+    outHoles.clear();
+
+    // Edge cancellation only yields the union when interiors are disjoint
+    for (size_t i = 0; i < pieces.size(); ++i) {
+        for (size_t j = 0; j < i; ++j) {
+            if (DoInteriorsOverlap(pieces[i], pieces[j])) {
+                return false;
+            }
+        }
+    }
+
+    std::vector<std::vector<LatticePoint>> contours;
+    if (!TraceSilhouette(pieces, contours)) {
+        return false;
+    }
+
+    int outerCount = 0;
+    for (std::vector<LatticePoint>& contour : contours) {
+        if (GetDoubleArea(contour).Sign() > 0) {
+            outOuter.swap(contour);
+            ++outerCount;
+        } else {
+            outHoles.push_back(contour);
+        }
+    }
+    return outerCount == 1;
+}
+
+std::vector<LatticePoint> GetCanonicalContour(const std::vector<LatticePoint>& contour) {
+    std::vector<LatticePoint> best;
+    std::vector<LatticePoint> candidate;
+
+    for (int flip = 0; flip < 2; ++flip) {
+        for (int rotation = 0; rotation < DIRECTION_COUNT; ++rotation) {
+            // Relative to a vertex first: differences of arrangement vertices are sums of piece
+            // edges, which rotate exactly, while absolute positions need not
+            candidate.clear();
+            bool isExact = true;
+            for (const LatticePoint& vertex : contour) {
+                LatticePoint offset = vertex - contour.front();
+                LatticePoint rotated;
+                if (!(flip ? offset.Flipped() : offset).Rotated(rotation, rotated)) {
+                    isExact = false;
+                    break;
+                }
+                candidate.push_back(rotated);
+            }
+            // An outline that is not a tangram arrangement may leave the lattice at 45 degrees
+            if (!isExact) {
+                continue;
+            }
+            // Mirroring reverses the winding; restore counter-clockwise order
+            if (GetDoubleArea(candidate).Sign() < 0) {
+                std::reverse(candidate.begin(), candidate.end());
+            }
+
+            auto lowest = std::min_element(candidate.begin(), candidate.end());
+            std::rotate(candidate.begin(), lowest, candidate.end());
+            LatticePoint origin = candidate.front();
+            for (LatticePoint& vertex : candidate) {
+                vertex = vertex - origin;
+            }
+
+            if (best.empty() || std::lexicographical_compare(candidate.begin(), candidate.end(), best.begin(), best.end())) {
+                best = candidate;
+            }
+        }
+    }
+    return best;
+}
+
+uint64_t HashCanonicalContour(const std::vector<LatticePoint>& canonical) {
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](int value) {
+        hash ^= (uint32_t)value;
+        hash *= 1099511628211ull;
+    };
+    for (const LatticePoint& vertex : canonical) {
+        mix(vertex.x.a);
+        mix(vertex.x.b);
+        mix(vertex.y.a);
+        mix(vertex.y.b);
+    }
+    return hash;
+}
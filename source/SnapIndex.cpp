@@ -0,0 +1,155 @@
+#include "SnapIndex.h"
+#include <algorithm>
+#include <cmath>
+
+PieceSymmetry GetPieceSymmetry(PieceType type) {
+    const float fullTurn = 2.0f * (float)M_PI;
+
+    switch (type) {
+        case PieceType::LARGE_TRIANGLE:
+        case PieceType::MEDIUM_TRIANGLE:
+        case PieceType::SMALL_TRIANGLE:
+            // Isosceles right triangle: mirrored about the axis through the right angle,
+            // so a flipped triangle equals the unflipped one rotated by 90 degrees
+            return {fullTurn, true, (float)M_PI / 2.0f};
+        case PieceType::SQUARE:
+            return {(float)M_PI / 2.0f, true, 0.0f};
+        case PieceType::PARALLELOGRAM:
+            // Half-turn symmetric, but flipping changes its handedness
+            return {(float)M_PI, false, 0.0f};
+    }
+    return {fullTurn, false, 0.0f};
+}
+
+SnapIndex::SnapIndex() {
+    for (int i = 0; i < PIECE_TYPE_COUNT; ++i) {
+        m_Roots[i] = -1;
+    }
+}
+
+void SnapIndex::Build(const std::vector<PiecePosition>& solution, const BoardState& board) {
+    m_Slots.clear();
+    m_Nodes.clear();
+
+    std::vector<int> slotsByType[PIECE_TYPE_COUNT];
+
+    for (const PiecePosition& target : solution) {
+        if (target.pieceIndex < 0 || target.pieceIndex >= board.count) {
+            continue;
+        }
+
+        SnapSlot slot;
+        slot.targetPieceIndex = target.pieceIndex;
+        slot.type = board.type[target.pieceIndex];
+        slot.position = target.position;
+        slot.rotation = target.rotation;
+        slot.isFlipped = target.isFlipped;
+        slot.occupant = -1;
+
+        slotsByType[(int)slot.type].push_back(m_Slots.size());
+        m_Slots.push_back(slot);
+    }
+
+    m_Nodes.reserve(m_Slots.size());
+    for (int type = 0; type < PIECE_TYPE_COUNT; ++type) {
+        m_Roots[type] = BuildTree(slotsByType[type], 0, slotsByType[type].size(), 0);
+    }
+}
+
+int SnapIndex::BuildTree(std::vector<int>& slots, int begin, int end, int depth) {
+    if (begin >= end) {
+        return -1;
+    }
+
+    int axis = depth % 2;
+    int middle = (begin + end) / 2;
+
+    // Median split along the current axis keeps the tree balanced
+    std::nth_element(slots.begin() + begin, slots.begin() + middle, slots.begin() + end,
+        [this, axis](int a, int b) {
+            return m_Slots[a].position[axis] < m_Slots[b].position[axis];
+        });
+
+    int node = m_Nodes.size();
+    m_Nodes.push_back({slots[middle], axis, -1, -1});
+
+    int left = BuildTree(slots, begin, middle, depth + 1);
+    int right = BuildTree(slots, middle + 1, end, depth + 1);
+    m_Nodes[node].left = left;
+    m_Nodes[node].right = right;
+
+    return node;
+}
+
+void SnapIndex::SearchTree(int node, const glm::vec2& position, int& bestSlot, float& bestDistanceSq) const {
+    if (node < 0) {
+        return;
+    }
+
+    const KdNode& current = m_Nodes[node];
+    const SnapSlot& slot = m_Slots[current.slot];
+
+    if (slot.occupant == -1) {
+        glm::vec2 delta = slot.position - position;
+        float distanceSq = glm::dot(delta, delta);
+        if (distanceSq < bestDistanceSq) {
+            bestDistanceSq = distanceSq;
+            bestSlot = current.slot;
+        }
+    }
+
+    float split = position[current.axis] - slot.position[current.axis];
+    int nearChild = (split < 0.0f) ? current.left : current.right;
+    int farChild = (split < 0.0f) ? current.right : current.left;
+
+    SearchTree(nearChild, position, bestSlot, bestDistanceSq);
+
+    // Only cross the splitting plane if it is closer than the best match so far
+    if (split * split < bestDistanceSq) {
+        SearchTree(farChild, position, bestSlot, bestDistanceSq);
+    }
+}
+
+int SnapIndex::FindNearestFreeSlot(PieceType type, const glm::vec2& position, float maxDistance) const {
+    int bestSlot = -1;
+    float bestDistanceSq = maxDistance * maxDistance;
+
+    SearchTree(m_Roots[(int)type], position, bestSlot, bestDistanceSq);
+
+    return bestSlot;
+}
+
+bool SnapIndex::GetEquivalentRotation(int slotIndex, bool pieceFlipped, float currentRotation, float& outRotation) const {
+    if (slotIndex < 0 || slotIndex >= (int)m_Slots.size()) {
+        return false;
+    }
+
+    const SnapSlot& slot = m_Slots[slotIndex];
+    PieceSymmetry symmetry = GetPieceSymmetry(slot.type);
+
+    float baseRotation = slot.rotation;
+    if (pieceFlipped != slot.isFlipped) {
+        if (!symmetry.isMirrorSymmetric) {
+            return false;
+        }
+        // A flipped pose at angle a covers the same area as the unflipped pose at a + mirrorRotation
+        baseRotation += slot.isFlipped ? symmetry.mirrorRotation : -symmetry.mirrorRotation;
+    }
+
+    // Pick the symmetric copy of the target rotation nearest to where the player left the piece
+    float turns = std::round((currentRotation - baseRotation) / symmetry.rotationPeriod);
+    outRotation = baseRotation + turns * symmetry.rotationPeriod;
+    return true;
+}
+
+void SnapIndex::Occupy(int slotIndex, int pieceIndex) {
+    if (slotIndex >= 0 && slotIndex < (int)m_Slots.size()) {
+        m_Slots[slotIndex].occupant = pieceIndex;
+    }
+}
+
+void SnapIndex::ClearOccupancy() {
+    for (SnapSlot& slot : m_Slots) {
+        slot.occupant = -1;
+    }
+}
@@ -189,9 +189,7 @@ void TangramParallelogram::ResetToOriginal() {
     m_IsFlipped = false;
     m_IsLocked = false;
     m_CurrentRotation = 0.0f;
-    
-    // Restore original color
-    SetColor(m_OriginalR, m_OriginalG, m_OriginalB);
+    // The vertex buffer is left alone, as in TangramTriangle::ResetToOriginal
 }
 
 PieceType TangramParallelogram::GetPieceType() const {
@@ -0,0 +1,574 @@
+#include "TangramSolver.h"
+#include "PieceGeometry.h"
+#include <algorithm>
+#include <mutex>
+
+static const int PIECE_TYPE_COUNT = 5;
+static const int SECTOR_COUNT = 8;
+static const uint8_t ALL_SECTORS = 0xFF;
+
+// Levels of the search tree expanded before handing subtrees to the pool
+static const int SPLIT_DEPTH = 2;
+
+// Pieces of each type in a standard set, and the piece index the first of them gets
+static const int PIECE_COUNTS[PIECE_TYPE_COUNT] = {2, 1, 2, 1, 1};
+static const int FIRST_PIECE_INDEX[PIECE_TYPE_COUNT] = {0, 2, 3, 5, 6};
+
+// Total area of the seven pieces, doubled and in LatticeProduct units (1/16)
+static const int64_t SET_DOUBLE_AREA = 8 * LatticeProduct::DENOMINATOR;
+
+// One distinct way to lay a piece down, up to translation
+struct Orientation {
+    PieceType type;
+    int rotation;
+    bool isFlipped;
+    std::vector<LatticePoint> outline;     // Relative to the anchor, counter-clockwise
+    std::vector<int> cornerStart;          // Per vertex: first sector the piece covers
+    std::vector<int> cornerSize;           // Per vertex: number of sectors covered
+};
+
+struct Candidate {
+    int orientation;
+    LatticePoint anchor;
+    int cornerSize;
+};
+
+struct SearchState {
+    std::vector<LatticePoint> silhouette;          // Counter-clockwise
+    std::vector<LatticePoint> scaledSilhouette;    // Times 3, for centroid tests
+    std::vector<std::vector<LatticePoint>> placed;
+    std::vector<int> placedOrientations;
+    std::vector<LatticePoint> placedAnchors;
+    int remaining[PIECE_TYPE_COUNT];
+};
+
+// Sectors from 'from' counter-clockwise up to, not including, 'to'
+static uint8_t GetSectorRange(int from, int to) {
+    uint8_t mask = 0;
+    int sector = from;
+    do {
+        mask |= (uint8_t)(1 << sector);
+        sector = (sector + 1) % SECTOR_COUNT;
+    } while (sector != to);
+    return mask;
+}
+
+// Sectors around p covered by a counter-clockwise polygon
+static uint8_t GetCoveredSectors(const std::vector<LatticePoint>& polygon, const LatticePoint& p) {
+    size_t count = polygon.size();
+    for (size_t i = 0; i < count; ++i) {
+        const LatticePoint& current = polygon[i];
+        const LatticePoint& next = polygon[(i + 1) % count];
+        if (current == p) {
+            const LatticePoint& previous = polygon[(i + count - 1) % count];
+            return GetSectorRange(GetLatticeDirection(p, next), GetLatticeDirection(p, previous));
+        }
+        if (IsInsideSegment(current, next, p)) {
+            // Interior is the half-plane left of the edge
+            int direction = GetLatticeDirection(current, next);
+            return GetSectorRange(direction, (direction + 4) % SECTOR_COUNT);
+        }
+    }
+    return IsStrictlyInsidePolygon(polygon, p) ? ALL_SECTORS : 0;
+}
+
+// Whether the convex piece lies inside the (possibly concave) silhouette
+static bool IsInsideSilhouette(const SearchState& state, const std::vector<LatticePoint>& piece) {
+    const std::vector<LatticePoint>& silhouette = state.silhouette;
+
+    for (const LatticePoint& vertex : piece) {
+        if (!IsOnPolygonBoundary(silhouette, vertex) && !IsStrictlyInsidePolygon(silhouette, vertex)) {
+            return false;
+        }
+    }
+
+    // No silhouette edge may cut through the piece
+    std::vector<LatticePoint> edge(2);
+    size_t count = silhouette.size();
+    for (size_t i = 0; i < count; ++i) {
+        edge[0] = silhouette[i];
+        edge[1] = silhouette[(i + 1) % count];
+        if (DoInteriorsOverlap(piece, edge)) {
+            return false;
+        }
+    }
+
+    // The piece is now wholly inside or wholly outside; its centroid tells which.
+    // Everything is scaled by 3 so the centroid stays on the lattice
+    LatticePoint centroid = piece[0] + piece[1] + piece[2];
+    return IsStrictlyInsidePolygon(state.scaledSilhouette, centroid);
+}
+
+static std::vector<Orientation> BuildOrientations() {
+    std::vector<Orientation> orientations;
+
+    for (int t = 0; t < PIECE_TYPE_COUNT; ++t) {
+        PieceType type = (PieceType)t;
+        std::vector<std::vector<LatticePoint>> seen;
+
+        for (int flip = 0; flip < 2; ++flip) {
+            for (int rotation = 0; rotation < 8; ++rotation) {
+                Orientation orientation;
+                orientation.type = type;
+                orientation.rotation = rotation;
+                orientation.isFlipped = flip == 1;
+                GetPlacedOutline(type, LatticePose(LatticePoint(), rotation, orientation.isFlipped), orientation.outline);
+
+                // Skip poses that cover the same area as an earlier one (symmetric pieces)
+                std::vector<LatticePoint> key = orientation.outline;
+                std::sort(key.begin(), key.end());
+                if (std::find(seen.begin(), seen.end(), key) != seen.end()) {
+                    continue;
+                }
+                seen.push_back(key);
+
+                if (GetDoubleArea(orientation.outline).Sign() < 0) {
+                    std::reverse(orientation.outline.begin(), orientation.outline.end());
+                }
+
+                size_t count = orientation.outline.size();
+                for (size_t i = 0; i < count; ++i) {
+                    const LatticePoint& vertex = orientation.outline[i];
+                    int start = GetLatticeDirection(vertex, orientation.outline[(i + 1) % count]);
+                    int end = GetLatticeDirection(vertex, orientation.outline[(i + count - 1) % count]);
+                    orientation.cornerStart.push_back(start);
+                    orientation.cornerSize.push_back((end - start + SECTOR_COUNT) % SECTOR_COUNT);
+                }
+
+                orientations.push_back(orientation);
+            }
+        }
+    }
+
+    return orientations;
+}
+
+static const std::vector<Orientation>& GetOrientations() {
+    static const std::vector<Orientation> orientations = BuildOrientations();
+    return orientations;
+}
+
+// Free sectors at p: inside the silhouette and not under any placed piece
+static uint8_t GetFreeSectors(const SearchState& state, const LatticePoint& p) {
+    uint8_t free = GetCoveredSectors(state.silhouette, p);
+    for (size_t i = 0; i < state.placed.size() && free != 0; ++i) {
+        free &= (uint8_t)~GetCoveredSectors(state.placed[i], p);
+    }
+    return free;
+}
+
+// Narrowest run of free sectors over every silhouette and piece vertex.
+// Returns false when no free corner is left
+static bool FindTightestCorner(const SearchState& state, LatticePoint& outPoint, int& outStart, int& outLength) {
+    int bestLength = SECTOR_COUNT + 1;
+
+    auto visit = [&](const LatticePoint& p) {
+        uint8_t free = GetFreeSectors(state, p);
+        if (free == 0 || free == ALL_SECTORS) {
+            return;
+        }
+        for (int start = 0; start < SECTOR_COUNT; ++start) {
+            bool isFree = (free >> start) & 1;
+            bool previousFree = (free >> ((start + SECTOR_COUNT - 1) % SECTOR_COUNT)) & 1;
+            if (!isFree || previousFree) {
+                continue;
+            }
+            int length = 0;
+            while ((free >> ((start + length) % SECTOR_COUNT)) & 1) {
+                ++length;
+            }
+            if (length < bestLength) {
+                bestLength = length;
+                outPoint = p;
+                outStart = start;
+                outLength = length;
+            }
+        }
+    };
+
+    for (const LatticePoint& vertex : state.silhouette) {
+        visit(vertex);
+    }
+    for (const std::vector<LatticePoint>& piece : state.placed) {
+        for (const LatticePoint& vertex : piece) {
+            visit(vertex);
+        }
+    }
+
+    // Only a corner narrower than a half-plane forces a piece vertex onto the point
+    return bestLength < SECTOR_COUNT / 2;
+}
+
+static void CollectCandidates(const SearchState& state, std::vector<Candidate>& outCandidates) {
+    outCandidates.clear();
+
+    LatticePoint point;
+    int start = 0;
+    int length = 0;
+    if (!FindTightestCorner(state, point, start, length)) {
+        return;
+    }
+
+    const std::vector<Orientation>& orientations = GetOrientations();
+    std::vector<LatticePoint> outline;
+
+    for (size_t o = 0; o < orientations.size(); ++o) {
+        const Orientation& orientation = orientations[o];
+        if (state.remaining[(int)orientation.type] == 0) {
+            continue;
+        }
+
+        for (size_t v = 0; v < orientation.outline.size(); ++v) {
+            if (orientation.cornerStart[v] != start || orientation.cornerSize[v] > length) {
+                continue;
+            }
+
+            LatticePoint anchor = point - orientation.outline[v];
+            outline.clear();
+            for (const LatticePoint& offset : orientation.outline) {
+                outline.push_back(anchor + offset);
+            }
+
+            if (!IsInsideSilhouette(state, outline)) {
+                continue;
+            }
+            bool overlaps = false;
+            for (const std::vector<LatticePoint>& other : state.placed) {
+                if (DoInteriorsOverlap(outline, other)) {
+                    overlaps = true;
+                    break;
+                }
+            }
+            if (!overlaps) {
+                outCandidates.push_back({(int)o, anchor, orientation.cornerSize[v]});
+            }
+        }
+    }
+
+    // Pieces that close the corner completely leave the simplest region behind
+    std::stable_sort(outCandidates.begin(), outCandidates.end(),
+        [](const Candidate& a, const Candidate& b) { return a.cornerSize > b.cornerSize; });
+}
+
+static void ApplyCandidate(SearchState& state, const Candidate& candidate) {
+    const Orientation& orientation = GetOrientations()[candidate.orientation];
+    std::vector<LatticePoint> outline;
+    for (const LatticePoint& offset : orientation.outline) {
+        outline.push_back(candidate.anchor + offset);
+    }
+    state.placed.push_back(outline);
+    state.placedOrientations.push_back(candidate.orientation);
+    state.placedAnchors.push_back(candidate.anchor);
+    state.remaining[(int)orientation.type]--;
+}
+
+static void UndoCandidate(SearchState& state) {
+    const Orientation& orientation = GetOrientations()[state.placedOrientations.back()];
+    state.remaining[(int)orientation.type]++;
+    state.placed.pop_back();
+    state.placedOrientations.pop_back();
+    state.placedAnchors.pop_back();
+}
+
+static bool IsComplete(const SearchState& state) {
+    for (int t = 0; t < PIECE_TYPE_COUNT; ++t) {
+        if (state.remaining[t] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool Search(SearchState& state, uint64_t& nodes, const std::atomic<bool>* cancel) {
+    ++nodes;
+    if (IsComplete(state)) {
+        return true;
+    }
+    if (cancel != nullptr && cancel->load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    std::vector<Candidate> candidates;
+    CollectCandidates(state, candidates);
+    for (const Candidate& candidate : candidates) {
+        ApplyCandidate(state, candidate);
+        if (Search(state, nodes, cancel)) {
+            return true;
+        }
+        UndoCandidate(state);
+    }
+    return false;
+}
+
+// Normalizes the silhouette; fails when it cannot be tiled by one tangram set
+static bool InitializeState(const std::vector<LatticePoint>& silhouette, SearchState& outState) {
+    outState.silhouette.clear();
+    for (const LatticePoint& vertex : silhouette) {
+        if (outState.silhouette.empty() || !(outState.silhouette.back() == vertex)) {
+            outState.silhouette.push_back(vertex);
+        }
+    }
+    while (outState.silhouette.size() > 1 && outState.silhouette.front() == outState.silhouette.back()) {
+        outState.silhouette.pop_back();
+    }
+    if (outState.silhouette.size() < 3) {
+        return false;
+    }
+
+    LatticeProduct doubleArea = GetDoubleArea(outState.silhouette);
+    if (doubleArea.Sign() < 0) {
+        std::reverse(outState.silhouette.begin(), outState.silhouette.end());
+        doubleArea = LatticeProduct(-doubleArea.a, -doubleArea.b);
+    }
+    if (doubleArea != LatticeProduct(SET_DOUBLE_AREA, 0)) {
+        return false;
+    }
+
+    size_t count = outState.silhouette.size();
+    for (size_t i = 0; i < count; ++i) {
+        if (GetLatticeDirection(outState.silhouette[i], outState.silhouette[(i + 1) % count]) < 0) {
+            return false;
+        }
+    }
+
+    outState.scaledSilhouette.clear();
+    for (const LatticePoint& vertex : outState.silhouette) {
+        outState.scaledSilhouette.push_back(vertex + vertex + vertex);
+    }
+    for (int t = 0; t < PIECE_TYPE_COUNT; ++t) {
+        outState.remaining[t] = PIECE_COUNTS[t];
+    }
+    return true;
+}
+
+static void FillResult(const SearchState& state, SolverResult& outResult) {
+    const std::vector<Orientation>& orientations = GetOrientations();
+    int nextIndex[PIECE_TYPE_COUNT];
+    for (int t = 0; t < PIECE_TYPE_COUNT; ++t) {
+        nextIndex[t] = FIRST_PIECE_INDEX[t];
+    }
+
+    outResult.isSolved = true;
+    outResult.solution.assign(7, PiecePosition());
+    outResult.poses.assign(7, LatticePose());
+    for (size_t i = 0; i < state.placed.size(); ++i) {
+        const Orientation& orientation = orientations[state.placedOrientations[i]];
+        int pieceIndex = nextIndex[(int)orientation.type]++;
+        LatticePose pose(state.placedAnchors[i], orientation.rotation, orientation.isFlipped);
+        outResult.poses[pieceIndex] = pose;
+        outResult.solution[pieceIndex] = ToPiecePosition(orientation.type, pieceIndex, pose);
+    }
+}
+
+TangramSolver::TangramSolver(ThreadPool& pool)
+    : m_Pool(pool) {
+}
+
+SolverResult TangramSolver::SolveSequential(const std::vector<LatticePoint>& silhouette) {
+    SolverResult result;
+    SearchState state;
+    if (!InitializeState(silhouette, state)) {
+        return result;
+    }
+
+    if (Search(state, result.nodesVisited, nullptr)) {
+        FillResult(state, result);
+    }
+    return result;
+}
+
+SolverResult TangramSolver::Solve(const std::vector<LatticePoint>& silhouette) const {
+    SolverResult result;
+    SearchState root;
+    if (!InitializeState(silhouette, root)) {
+        return result;
+    }
+
+    // Expand the first levels breadth first; each frontier state becomes one task
+    std::vector<SearchState> frontier(1, root);
+    std::vector<Candidate> candidates;
+    for (int depth = 0; depth < SPLIT_DEPTH; ++depth) {
+        std::vector<SearchState> next;
+        for (SearchState& state : frontier) {
+            ++result.nodesVisited;
+            if (IsComplete(state)) {
+                FillResult(state, result);
+                return result;
+            }
+            CollectCandidates(state, candidates);
+            for (const Candidate& candidate : candidates) {
+                next.push_back(state);
+                ApplyCandidate(next.back(), candidate);
+            }
+        }
+        frontier.swap(next);
+    }
+
+    std::atomic<bool> isFound(false);
+    std::atomic<uint64_t> nodes(0);
+    std::atomic<int> pending((int)frontier.size());
+    std::mutex resultMutex;
+
+    for (SearchState& state : frontier) {
+        m_Pool.Submit([&, state]() mutable {
+            uint64_t localNodes = 0;
+            if (!isFound.load() && Search(state, localNodes, &isFound)) {
+                std::lock_guard<std::mutex> lock(resultMutex);
+                if (!isFound.exchange(true)) {
+                    FillResult(state, result);
+                }
+            }
+            nodes.fetch_add(localNodes);
+            pending.fetch_sub(1);
+        });
+    }
+    m_Pool.WaitFor(pending);
+
+    result.nodesVisited += nodes.load();
+    return result;
+}
+
+std::vector<SolverResult> TangramSolver::SolveBatch(const std::vector<std::vector<LatticePoint>>& silhouettes) const {
+    std::vector<SolverResult> results(silhouettes.size());
+    std::atomic<int> pending((int)silhouettes.size());
+
+    for (size_t i = 0; i < silhouettes.size(); ++i) {
+        m_Pool.Submit([&, i]() {
+            results[i] = SolveSequential(silhouettes[i]);
+            pending.fetch_sub(1);
+        });
+    }
+    m_Pool.WaitFor(pending);
+
+    return results;
+}
+
+struct IncrementalSolver::Search {
+    struct Frame {
+        std::vector<Candidate> candidates;
+        size_t next = 0;
+        bool isApplied = false;       // candidates[next - 1] is on the board
+    };
+
+    SearchState state;
+    size_t fixedCount = 0;
+    std::vector<LatticePlacement> preferred;
+    std::vector<Frame> stack;
+
+    bool IsPreferred(const Candidate& candidate) const {
+        const Orientation& orientation = GetOrientations()[candidate.orientation];
+        LatticePose pose(candidate.anchor, orientation.rotation, orientation.isFlipped);
+        for (const LatticePlacement& placement : preferred) {
+            if (placement.type == orientation.type && IsSamePlacement(orientation.type, placement.pose, pose)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void PushFrame() {
+        stack.emplace_back();
+        Frame& frame = stack.back();
+        CollectCandidates(state, frame.candidates);
+        std::stable_partition(frame.candidates.begin(), frame.candidates.end(),
+            [this](const Candidate& candidate) { return IsPreferred(candidate); });
+    }
+};
+
+IncrementalSolver::IncrementalSolver()
+    : m_Search(new Search())
+    , m_Status(SearchStatus::FAILED)
+    , m_NodesVisited(0) {
+}
+
+IncrementalSolver::~IncrementalSolver() {
+}
+
+bool IncrementalSolver::Start(const std::vector<LatticePoint>& silhouette,
+                              const std::vector<LatticePlacement>& fixed,
+                              const std::vector<LatticePlacement>& preferred) {
+    m_Search.reset(new Search());
+    m_Status = SearchStatus::FAILED;
+    m_NodesVisited = 0;
+
+    SearchState& state = m_Search->state;
+    if (!InitializeState(silhouette, state)) {
+        return false;
+    }
+
+    for (const LatticePlacement& placement : fixed) {
+        if (--state.remaining[(int)placement.type] < 0) {
+            return false;
+        }
+        std::vector<LatticePoint> outline;
+        GetPlacedOutline(placement.type, placement.pose, outline);
+        if (GetDoubleArea(outline).Sign() < 0) {
+            std::reverse(outline.begin(), outline.end());
+        }
+        // Never undone, so no orientation is needed to restore the piece count
+        state.placed.push_back(outline);
+        state.placedOrientations.push_back(-1);
+        state.placedAnchors.push_back(placement.pose.anchor);
+    }
+    m_Search->fixedCount = fixed.size();
+    m_Search->preferred = preferred;
+
+    m_Status = SearchStatus::RUNNING;
+    return true;
+}
+
+SearchStatus IncrementalSolver::Step(std::chrono::steady_clock::duration budget) {
+    if (m_Status != SearchStatus::RUNNING) {
+        return m_Status;
+    }
+
+    Search& search = *m_Search;
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + budget;
+
+    if (search.stack.empty()) {
+        ++m_NodesVisited;
+        if (IsComplete(search.state)) {
+            m_Status = SearchStatus::SOLVED;
+            return m_Status;
+        }
+        search.PushFrame();
+    }
+
+    while (std::chrono::steady_clock::now() < deadline) {
+        Search::Frame& frame = search.stack.back();
+        if (frame.isApplied) {
+            UndoCandidate(search.state);
+            frame.isApplied = false;
+        }
+        if (frame.next == frame.candidates.size()) {
+            search.stack.pop_back();
+            if (search.stack.empty()) {
+                m_Status = SearchStatus::FAILED;
+                return m_Status;
+            }
+            continue;
+        }
+
+        ApplyCandidate(search.state, frame.candidates[frame.next++]);
+        frame.isApplied = true;
+        ++m_NodesVisited;
+        if (IsComplete(search.state)) {
+            m_Status = SearchStatus::SOLVED;
+            return m_Status;
+        }
+        search.PushFrame();
+    }
+    return m_Status;
+}
+
+std::vector<LatticePlacement> IncrementalSolver::GetPlacements() const {
+    const std::vector<Orientation>& orientations = GetOrientations();
+    const SearchState& state = m_Search->state;
+
+    std::vector<LatticePlacement> placements;
+    for (size_t i = m_Search->fixedCount; i < state.placed.size(); ++i) {
+        const Orientation& orientation = orientations[state.placedOrientations[i]];
+        placements.push_back({orientation.type, LatticePose(state.placedAnchors[i], orientation.rotation, orientation.isFlipped)});
+    }
+    return placements;
+}
@@ -197,9 +197,8 @@ void TangramTriangle::ResetToOriginal() {
     m_IsFlipped = false;
     m_IsLocked = false;
     m_CurrentRotation = 0.0f;
-    
-    // Restore original color
-    SetColor(m_OriginalR, m_OriginalG, m_OriginalB);
+    // The vertex buffer keeps its original data: poses live in the model matrix, and the game
+    // draws pieces in a uniform color, so resetting needs no upload and no GL context
 }
 
 PieceType TangramTriangle::GetPieceType() const {
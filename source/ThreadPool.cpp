@@ -0,0 +1,127 @@
+#include "ThreadPool.h"
+
+// Worker identity of the calling thread, so Submit() from inside a task stays local
+static thread_local const ThreadPool* t_Pool = nullptr;
+static thread_local int t_WorkerIndex = -1;
+
+ThreadPool::ThreadPool(unsigned threadCount)
+    : m_QueuedTasks(0)
+    , m_NextQueue(0)
+    , m_IsStopping(false) {
+    if (threadCount == 0) {
+        threadCount = std::thread::hardware_concurrency();
+    }
+    if (threadCount == 0) {
+        threadCount = 1;
+    }
+
+    for (unsigned i = 0; i < threadCount; ++i) {
+        m_Queues.emplace_back(new WorkerQueue());
+    }
+    for (unsigned i = 0; i < threadCount; ++i) {
+        m_Threads.emplace_back(&ThreadPool::WorkerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_WakeMutex);
+        m_IsStopping = true;
+    }
+    m_WakeCondition.notify_all();
+
+    for (std::thread& thread : m_Threads) {
+        thread.join();
+    }
+}
+
+int ThreadPool::GetCurrentWorker() const {
+    return (t_Pool == this) ? t_WorkerIndex : -1;
+}
+
+void ThreadPool::Submit(std::function<void()> task) {
+    int queue = GetCurrentWorker();
+    if (queue < 0) {
+        queue = m_NextQueue.fetch_add(1) % m_Queues.size();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_Queues[queue]->mutex);
+        m_Queues[queue]->tasks.push_back(std::move(task));
+    }
+
+    {
+        // Taking the wake mutex orders the increment against a worker about to sleep
+        std::lock_guard<std::mutex> lock(m_WakeMutex);
+        m_QueuedTasks.fetch_add(1);
+    }
+    m_WakeCondition.notify_one();
+}
+
+bool ThreadPool::PopTask(int preferredQueue, std::function<void()>& outTask) {
+    size_t queueCount = m_Queues.size();
+
+    // Own queue first, newest task first
+    if (preferredQueue >= 0) {
+        WorkerQueue& own = *m_Queues[preferredQueue];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            outTask = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            m_QueuedTasks.fetch_sub(1);
+            return true;
+        }
+    }
+
+    // Steal the oldest task of another queue: it is usually the largest piece of work
+    size_t start = (preferredQueue >= 0) ? preferredQueue + 1 : 0;
+    for (size_t offset = 0; offset < queueCount; ++offset) {
+        size_t victim = (start + offset) % queueCount;
+        if ((int)victim == preferredQueue) {
+            continue;
+        }
+        WorkerQueue& other = *m_Queues[victim];
+        std::lock_guard<std::mutex> lock(other.mutex);
+        if (!other.tasks.empty()) {
+            outTask = std::move(other.tasks.front());
+            other.tasks.pop_front();
+            m_QueuedTasks.fetch_sub(1);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ThreadPool::WorkerLoop(unsigned index) {
+    t_Pool = this;
+    t_WorkerIndex = index;
+
+    std::function<void()> task;
+    while (true) {
+        if (PopTask(index, task)) {
+            task();
+            task = nullptr;
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_WakeMutex);
+        m_WakeCondition.wait(lock, [this]() { return m_IsStopping || m_QueuedTasks.load() > 0; });
+        if (m_IsStopping && m_QueuedTasks.load() == 0) {
+            return;
+        }
+    }
+}
+
+void ThreadPool::WaitFor(const std::atomic<int>& counter) {
+    int worker = GetCurrentWorker();
+    std::function<void()> task;
+    while (counter.load() > 0) {
+        if (PopTask(worker, task)) {
+            task();
+            task = nullptr;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
@@ -0,0 +1,421 @@
+#include "ThumbnailAtlas.h"
+#include "BufferLayout.h"
+#include "VertexArray.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <glm/gtc/matrix_transform.hpp>
+
+static const char THUMBNAIL_CACHE_MAGIC[4] = {'T', 'G', 'T', 'H'};
+static const uint32_t THUMBNAIL_CACHE_VERSION = 2;
+
+// More columns only make the texture wider than any menu needs
+static const int MAX_COLUMNS = 16;
+
+// Empty border around every silhouette, in pixels
+static const float CELL_MARGIN = 4.0f;
+
+// Work per Update, so scrolling onto a page of uncached levels does not stall a frame;
+// the rest is requested again next frame if still on screen
+static const int MAX_UPLOADS_PER_FRAME = 256;
+static const int MAX_BAKES_PER_FRAME = 32;
+
+struct ThumbnailCacheHeader {
+    char magic[4];             // "TGTH"
+    uint32_t version;
+    uint32_t cellWidth;
+    uint32_t cellHeight;       // Followed by records of (uint64_t hash, cellWidth * cellHeight bytes)
+};
+
+ThumbnailAtlas::ThumbnailAtlas(int cellWidth, int cellHeight, int slotCount)
+    : m_CellWidth(cellWidth)
+    , m_CellHeight(cellHeight)
+    , m_SlotCount(slotCount)
+    , m_Columns(1)
+    , m_Rows(1)
+    , m_TextureID(0)
+    , m_Framebuffer(0)
+    , m_StencilBuffer(0)
+    , m_LevelManager(nullptr)
+    , m_Shader(nullptr)
+    , m_CanBake(true)
+    , m_Frame(0)
+    , m_CacheFile(-1)
+    , m_CacheSize(0)
+    , m_CachedCount(0)
+    , m_BakedCount(0) {
+}
+
+ThumbnailAtlas::~ThumbnailAtlas() {
+    if (m_TextureID != 0) {
+        glDeleteTextures(1, &m_TextureID);
+    }
+    ReleaseFramebuffer();
+    CloseCache();
+}
+
+void ThumbnailAtlas::Open(LevelManager* levelManager, Shader* shader, const std::string& cachePath) {
+    m_LevelManager = levelManager;
+    m_Shader = shader;
+
+    int maxTextureSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+    m_Columns = std::max(1, std::min(MAX_COLUMNS, maxTextureSize / m_CellWidth));
+    m_Rows = std::max(1, std::min(maxTextureSize / m_CellHeight, (m_SlotCount + m_Columns - 1) / m_Columns));
+    m_SlotCount = std::min(m_SlotCount, m_Columns * m_Rows);
+
+    // The stencil buffer matches the texture size
+    ReleaseFramebuffer();
+    if (m_TextureID == 0) {
+        glGenTextures(1, &m_TextureID);
+    }
+    glBindTexture(GL_TEXTURE_2D, m_TextureID);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, m_Columns * m_CellWidth, m_Rows * m_CellHeight, 0, GL_RED, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    m_SlotLevels.assign(m_SlotCount, -1);
+    m_SlotLastUsed.assign(m_SlotCount, 0);
+    m_LevelSlots.clear();
+    m_Pending.clear();
+
+    CloseCache();
+    if (!cachePath.empty()) {
+        OpenCache(cachePath);
+    }
+}
+
+void ThumbnailAtlas::Request(int index) {
+    auto found = m_LevelSlots.find(index);
+    if (found != m_LevelSlots.end()) {
+        m_SlotLastUsed[found->second] = m_Frame;
+    } else {
+        m_Pending.push_back(index);
+    }
+}
+
+bool ThumbnailAtlas::Update() {
+    if (m_Pending.empty()) {
+        return false;
+    }
+
+    std::vector<BakeJob> jobs;
+    std::vector<uint8_t> pixels;
+    int uploadCount = 0;
+    bool isChanged = false;
+
+    glBindTexture(GL_TEXTURE_2D, m_TextureID);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    for (int index : m_Pending) {
+        if (m_LevelSlots.count(index) > 0) {
+            continue;
+        }
+        uint64_t hash = m_LevelManager->GetLevelHash(index);
+        if (hash == 0) {
+            continue;
+        }
+
+        // Only levels missing from the cache are decoded
+        bool isCached = uploadCount < MAX_UPLOADS_PER_FRAME && ReadCell(hash, pixels);
+        std::shared_ptr<Level> level;
+        if (!isCached) {
+            if (!m_CanBake || (int)jobs.size() >= MAX_BAKES_PER_FRAME || m_CacheIndex.count(hash) > 0) {
+                continue;
+            }
+            level = m_LevelManager->GetLevel(index);
+            if (level == nullptr) {
+                continue;
+            }
+        }
+
+        int slot = AcquireSlot(index);
+        if (slot < 0) {
+            break;
+        }
+        if (isCached) {
+            glm::ivec2 origin = GetSlotOrigin(slot);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, origin.x, origin.y, m_CellWidth, m_CellHeight,
+                            GL_RED, GL_UNSIGNED_BYTE, pixels.data());
+            ++uploadCount;
+            ++m_CachedCount;
+        } else {
+            jobs.push_back({slot, hash, level});
+        }
+        isChanged = true;
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    m_Pending.clear();
+
+    if (!jobs.empty()) {
+        Bake(jobs);
+    }
+    return isChanged;
+}
+
+int ThumbnailAtlas::AcquireSlot(int index) {
+    // Least recently used slot not needed this frame; free slots were last used at frame 0
+    int best = -1;
+    for (int slot = 0; slot < m_SlotCount; ++slot) {
+        if (m_SlotLastUsed[slot] < m_Frame && (best < 0 || m_SlotLastUsed[slot] < m_SlotLastUsed[best])) {
+            best = slot;
+        }
+    }
+    if (best < 0) {
+        return -1;
+    }
+    if (m_SlotLevels[best] >= 0) {
+        m_LevelSlots.erase(m_SlotLevels[best]);
+    }
+    m_SlotLevels[best] = index;
+    m_SlotLastUsed[best] = m_Frame;
+    m_LevelSlots[index] = best;
+    return best;
+}
+
+void ThumbnailAtlas::Bind(unsigned int slot) const {
+    glActiveTexture(GL_TEXTURE0 + slot);
+    glBindTexture(GL_TEXTURE_2D, m_TextureID);
+}
+
+glm::vec4 ThumbnailAtlas::GetCellUV(int index) const {
+    auto found = m_LevelSlots.find(index);
+    if (found == m_LevelSlots.end()) {
+        return glm::vec4(0.0f);
+    }
+    float width = m_Columns * m_CellWidth;
+    float height = m_Rows * m_CellHeight;
+    glm::ivec2 origin = GetSlotOrigin(found->second);
+    return glm::vec4(origin.x / width, origin.y / height,
+                     (origin.x + m_CellWidth) / width, (origin.y + m_CellHeight) / height);
+}
+
+glm::ivec2 ThumbnailAtlas::GetSlotOrigin(int slot) const {
+    return glm::ivec2((slot % m_Columns) * m_CellWidth, (slot / m_Columns) * m_CellHeight);
+}
+
+void ThumbnailAtlas::AppendSilhouette(const Level& level, int slot, std::vector<float>& vertices) const {
+    const std::vector<glm::vec2>& outline = level.GetSilhouetteVertices();
+    if (outline.size() < 3) {
+        return;
+    }
+
+    // Fit the outline into the cell; holes lie inside it
+    glm::vec2 minimum = outline[0];
+    glm::vec2 maximum = outline[0];
+    for (const glm::vec2& vertex : outline) {
+        minimum = glm::min(minimum, vertex);
+        maximum = glm::max(maximum, vertex);
+    }
+    glm::vec2 size = glm::max(maximum - minimum, glm::vec2(1e-6f));
+    float scale = std::min((m_CellWidth - 2.0f * CELL_MARGIN) / size.x, (m_CellHeight - 2.0f * CELL_MARGIN) / size.y);
+    glm::vec2 cellCenter = glm::vec2(GetSlotOrigin(slot)) + glm::vec2(m_CellWidth, m_CellHeight) * 0.5f;
+    glm::vec2 shapeCenter = (minimum + maximum) * 0.5f;
+
+    auto appendContour = [&](const std::vector<glm::vec2>& contour) {
+        for (size_t i = 1; i + 1 < contour.size(); ++i) {
+            const glm::vec2* corners[3] = {&contour[0], &contour[i], &contour[i + 1]};
+            for (const glm::vec2* corner : corners) {
+                glm::vec2 pixel = cellCenter + (*corner - shapeCenter) * scale;
+                vertices.insert(vertices.end(), {pixel.x, pixel.y, 1.0f, 1.0f, 1.0f, 1.0f});
+            }
+        }
+    };
+    appendContour(outline);
+    for (const std::vector<glm::vec2>& hole : level.GetSilhouetteHoles()) {
+        appendContour(hole);
+    }
+}
+
+void ThumbnailAtlas::Bake(const std::vector<BakeJob>& jobs) {
+    int width = m_Columns * m_CellWidth;
+    int height = m_Rows * m_CellHeight;
+
+    std::vector<float> vertices;
+    for (const BakeJob& job : jobs) {
+        AppendSilhouette(*job.level, job.slot, vertices);
+    }
+    int fanVertexCount = vertices.size() / 6;
+    // Cover quads over the baked slots for the fill pass
+    for (const BakeJob& job : jobs) {
+        glm::vec2 lo = glm::vec2(GetSlotOrigin(job.slot));
+        glm::vec2 hi = lo + glm::vec2(m_CellWidth, m_CellHeight);
+        float cover[] = {
+            lo.x, lo.y,    1.0f, 1.0f, 1.0f, 1.0f,
+            hi.x, lo.y,    1.0f, 1.0f, 1.0f, 1.0f,
+            hi.x, hi.y,    1.0f, 1.0f, 1.0f, 1.0f,
+            lo.x, lo.y,    1.0f, 1.0f, 1.0f, 1.0f,
+            hi.x, hi.y,    1.0f, 1.0f, 1.0f, 1.0f,
+            lo.x, hi.y,    1.0f, 1.0f, 1.0f, 1.0f
+        };
+        vertices.insert(vertices.end(), std::begin(cover), std::end(cover));
+    }
+
+    BufferLayout layout;
+    layout.PushFloat(2);  // Position in texture pixels
+    layout.PushFloat(4);  // Color
+    VertexArray vertexArray;
+    vertexArray.SetData(vertices.data(), vertices.size() * sizeof(float), &layout);
+
+    // Created on the first bake, so sessions served from the cache never allocate the stencil
+    if (m_Framebuffer == 0) {
+        glGenFramebuffers(1, &m_Framebuffer);
+        glBindFramebuffer(GL_FRAMEBUFFER, m_Framebuffer);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_TextureID, 0);
+        glGenRenderbuffers(1, &m_StencilBuffer);
+        glBindRenderbuffer(GL_RENDERBUFFER, m_StencilBuffer);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_StencilBuffer);
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, m_Framebuffer);
+
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "Thumbnails: offscreen framebuffer is incomplete, uncached thumbnails stay blank" << std::endl;
+        m_CanBake = false;
+        for (const BakeJob& job : jobs) {
+            m_LevelSlots.erase(m_SlotLevels[job.slot]);
+            m_SlotLevels[job.slot] = -1;
+            m_SlotLastUsed[job.slot] = 0;
+        }
+    } else {
+        GLint viewport[4];
+        GLfloat clearColor[4];
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        glGetFloatv(GL_COLOR_CLEAR_VALUE, clearColor);
+
+        glViewport(0, 0, width, height);
+        // Other slots hold resident thumbnails, so only the baked ones are cleared
+        glClearStencil(0);
+        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        glEnable(GL_SCISSOR_TEST);
+        for (const BakeJob& job : jobs) {
+            glm::ivec2 origin = GetSlotOrigin(job.slot);
+            glScissor(origin.x, origin.y, m_CellWidth, m_CellHeight);
+            glClear(GL_COLOR_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+        }
+        glDisable(GL_SCISSOR_TEST);
+
+        m_Shader->Bind();
+        m_Shader->SetUniformMat4f("u_Projection", glm::ortho(0.0f, (float)width, 0.0f, (float)height));
+        m_Shader->SetUniformMat4f("u_View", glm::mat4(1.0f));
+        m_Shader->SetUniformMat4f("u_Model", glm::mat4(1.0f));
+        m_Shader->SetUniform1i("u_UseUniformColor", 1);
+        m_Shader->SetUniform4f("u_Color", 1.0f, 1.0f, 1.0f, 1.0f);
+        vertexArray.Bind();
+
+        // Odd stencil marks the inside: each fan flips every pixel it covers
+        glEnable(GL_STENCIL_TEST);
+        glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+        glStencilFunc(GL_ALWAYS, 0, 1);
+        glStencilOp(GL_KEEP, GL_KEEP, GL_INVERT);
+        glDrawArrays(GL_TRIANGLES, 0, fanVertexCount);
+
+        glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+        glStencilFunc(GL_EQUAL, 1, 1);
+        glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+        glDrawArrays(GL_TRIANGLES, fanVertexCount, 6 * jobs.size());
+        glDisable(GL_STENCIL_TEST);
+        m_Shader->SetUniform1i("u_UseUniformColor", 0);
+
+        std::vector<uint8_t> pixels(m_CellWidth * m_CellHeight);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        for (const BakeJob& job : jobs) {
+            glm::ivec2 origin = GetSlotOrigin(job.slot);
+            glReadPixels(origin.x, origin.y, m_CellWidth, m_CellHeight, GL_RED, GL_UNSIGNED_BYTE, pixels.data());
+            AppendCell(job.hash, pixels);
+        }
+        glPixelStorei(GL_PACK_ALIGNMENT, 4);
+        m_BakedCount += jobs.size();
+
+        glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+        glClearColor(clearColor[0], clearColor[1], clearColor[2], clearColor[3]);
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void ThumbnailAtlas::ReleaseFramebuffer() {
+    if (m_Framebuffer != 0) {
+        glDeleteRenderbuffers(1, &m_StencilBuffer);
+        glDeleteFramebuffers(1, &m_Framebuffer);
+    }
+    m_Framebuffer = 0;
+    m_StencilBuffer = 0;
+}
+
+void ThumbnailAtlas::OpenCache(const std::string& path) {
+    m_CacheFile = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (m_CacheFile < 0) {
+        std::cerr << "Thumbnails: cannot open cache " << path << std::endl;
+        return;
+    }
+
+    ThumbnailCacheHeader header = {};
+    bool isCompatible = pread(m_CacheFile, &header, sizeof(header), 0) == (ssize_t)sizeof(header)
+                     && std::memcmp(header.magic, THUMBNAIL_CACHE_MAGIC, sizeof(THUMBNAIL_CACHE_MAGIC)) == 0
+                     && header.version == THUMBNAIL_CACHE_VERSION
+                     && header.cellWidth == (uint32_t)m_CellWidth
+                     && header.cellHeight == (uint32_t)m_CellHeight;
+    if (!isCompatible) {
+        // New, or written for another cell size or version: start over
+        std::memcpy(header.magic, THUMBNAIL_CACHE_MAGIC, sizeof(THUMBNAIL_CACHE_MAGIC));
+        header.version = THUMBNAIL_CACHE_VERSION;
+        header.cellWidth = m_CellWidth;
+        header.cellHeight = m_CellHeight;
+        if (ftruncate(m_CacheFile, 0) != 0 || pwrite(m_CacheFile, &header, sizeof(header), 0) != (ssize_t)sizeof(header)) {
+            std::cerr << "Thumbnails: cannot write cache " << path << std::endl;
+            CloseCache();
+            return;
+        }
+    }
+
+    // Index the records; a record cut short by an interrupted append is dropped
+    uint64_t fileSize = lseek(m_CacheFile, 0, SEEK_END);
+    uint64_t recordSize = sizeof(uint64_t) + (uint64_t)m_CellWidth * m_CellHeight;
+    uint64_t offset = sizeof(header);
+    uint64_t hash = 0;
+    while (offset + recordSize <= fileSize && pread(m_CacheFile, &hash, sizeof(hash), offset) == (ssize_t)sizeof(hash)) {
+        m_CacheIndex[hash] = offset + sizeof(hash);
+        offset += recordSize;
+    }
+    if (offset != fileSize && ftruncate(m_CacheFile, offset) != 0) {
+        std::cerr << "Thumbnails: cannot repair cache " << path << std::endl;
+    }
+    m_CacheSize = offset;
+}
+
+void ThumbnailAtlas::CloseCache() {
+    if (m_CacheFile >= 0) {
+        close(m_CacheFile);
+    }
+    m_CacheFile = -1;
+    m_CacheSize = 0;
+    m_CacheIndex.clear();
+}
+
+bool ThumbnailAtlas::ReadCell(uint64_t hash, std::vector<uint8_t>& outPixels) const {
+    auto found = m_CacheIndex.find(hash);
+    if (found == m_CacheIndex.end()) {
+        return false;
+    }
+    size_t cellSize = m_CellWidth * m_CellHeight;
+    outPixels.resize(cellSize);
+    return pread(m_CacheFile, outPixels.data(), cellSize, found->second) == (ssize_t)cellSize;
+}
+
+void ThumbnailAtlas::AppendCell(uint64_t hash, const std::vector<uint8_t>& pixels) {
+    if (m_CacheFile < 0 || m_CacheIndex.count(hash) > 0) {
+        return;
+    }
+    bool isWritten = pwrite(m_CacheFile, &hash, sizeof(hash), m_CacheSize) == (ssize_t)sizeof(hash)
+                  && pwrite(m_CacheFile, pixels.data(), pixels.size(), m_CacheSize + sizeof(hash)) == (ssize_t)pixels.size();
+    if (!isWritten) {
+        std::cerr << "Thumbnails: failed appending to the cache" << std::endl;
+        return;
+    }
+    m_CacheIndex[hash] = m_CacheSize + sizeof(hash);
+    m_CacheSize += sizeof(hash) + pixels.size();
+}
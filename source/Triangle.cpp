@@ -78,6 +78,14 @@ void Triangle::SetColor(float r, float g, float b){
 	m_VertexArray->SetData(m_Vertices.data(), m_Vertices.size()*sizeof(float) , &m_BufferLayout);
 }
 
+glm::vec3 Triangle::GetColor() const{
+	//Every vertex carries the same color
+	if (m_Vertices.size() < 6){
+		return glm::vec3(1.0f, 1.0f, 1.0f);
+	}
+	return glm::vec3(m_Vertices[2], m_Vertices[3], m_Vertices[4]);
+}
+
 float sign(float x1, float y1, float x2, float y2, float x3, float y3) {
     return (x1 - x3) * (y2 - y3) - (x2 - x3) * (y1 - y3);
 }
@@ -176,3 +184,10 @@ Triangle::~Triangle(){
 
 void Triangle::AddPoint(double x, double y){}
 void Triangle::FinalizeShape(){}
+
+void Triangle::GetOutline(std::vector<glm::vec2>& outVertices) const {
+    outVertices.clear();
+    for (size_t i = 0; i < m_Vertices.size(); i += 6) {
+        outVertices.push_back(glm::vec2(m_Vertices[i], m_Vertices[i + 1]));
+    }
+}
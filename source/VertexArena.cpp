@@ -0,0 +1,81 @@
+#include "VertexArena.h"
+#include <new>
+
+VertexArena& VertexArena::Get() {
+    static VertexArena arena;
+    return arena;
+}
+
+VertexArena::VertexArena()
+    : m_Cursor(nullptr)
+    , m_Remaining(0) {
+    for (int i = 0; i < CLASS_COUNT; ++i) {
+        m_FreeLists[i] = nullptr;
+    }
+}
+
+int VertexArena::GetSizeClass(size_t bytes) {
+    int sizeClass = 0;
+    while (sizeClass < CLASS_COUNT && GetClassSize(sizeClass) < bytes) {
+        ++sizeClass;
+    }
+    return sizeClass;
+}
+
+void VertexArena::AddChunk() {
+    // Hand the unused tail of the current chunk to the free lists, largest blocks first.
+    // Every class size is a multiple of 16, so the tail splits without leftovers
+    for (int sizeClass = CLASS_COUNT - 1; sizeClass >= 0 && m_Remaining > 0; --sizeClass) {
+        size_t classSize = GetClassSize(sizeClass);
+        while (m_Remaining >= classSize) {
+            FreeBlock* block = reinterpret_cast<FreeBlock*>(m_Cursor);
+            block->next = m_FreeLists[sizeClass];
+            m_FreeLists[sizeClass] = block;
+            m_Cursor += classSize;
+            m_Remaining -= classSize;
+        }
+    }
+
+    m_Chunks.emplace_back(new unsigned char[CHUNK_SIZE]);
+    m_Cursor = m_Chunks.back().get();
+    m_Remaining = CHUNK_SIZE;
+}
+
+void* VertexArena::Allocate(size_t bytes) {
+    int sizeClass = GetSizeClass(bytes);
+    if (sizeClass >= CLASS_COUNT) {
+        return ::operator new(bytes);
+    }
+
+    if (m_FreeLists[sizeClass] != nullptr) {
+        FreeBlock* block = m_FreeLists[sizeClass];
+        m_FreeLists[sizeClass] = block->next;
+        return block;
+    }
+
+    size_t classSize = GetClassSize(sizeClass);
+    if (m_Remaining < classSize) {
+        AddChunk();
+    }
+
+    void* block = m_Cursor;
+    m_Cursor += classSize;
+    m_Remaining -= classSize;
+    return block;
+}
+
+void VertexArena::Deallocate(void* block, size_t bytes) {
+    if (block == nullptr) {
+        return;
+    }
+
+    int sizeClass = GetSizeClass(bytes);
+    if (sizeClass >= CLASS_COUNT) {
+        ::operator delete(block);
+        return;
+    }
+
+    FreeBlock* freed = static_cast<FreeBlock*>(block);
+    freed->next = m_FreeLists[sizeClass];
+    m_FreeLists[sizeClass] = freed;
+}
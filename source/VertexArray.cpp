@@ -2,7 +2,7 @@
 #include "BufferLayout.h"
 #include "LayoutElement.h"
 
-VertexArray::VertexArray(){
+VertexArray::VertexArray() : m_InstanceVBOID(0), m_AttributeCount(0){
 	glGenVertexArrays(1, &m_VAOID);
 	glGenBuffers(1, &m_VBOID);
 	
@@ -11,6 +11,9 @@ VertexArray::VertexArray(){
 VertexArray::~VertexArray() {
 	glDeleteVertexArrays(1, &m_VAOID);
 	glDeleteBuffers(1, &m_VBOID);
+	if (m_InstanceVBOID != 0) {
+		glDeleteBuffers(1, &m_InstanceVBOID);
+	}
 }
 
 void VertexArray::Bind() const{
@@ -40,7 +43,39 @@ void VertexArray::SetData(const void* data, unsigned int size, const BufferLayou
 		offset += element.count * sizeof(float);
 		index++;
 
+	}
+	m_AttributeCount = index;
+	glBindVertexArray(0);
+}
+
+void VertexArray::SetInstanceData(const void* data, unsigned int size, const BufferLayout* layout){
+	if (m_InstanceVBOID == 0) {
+		glGenBuffers(1, &m_InstanceVBOID);
+	}
+	glBindVertexArray(m_VAOID);
+	glBindBuffer(GL_ARRAY_BUFFER, m_InstanceVBOID);
+	//Dynamic: instances are patched in place with UpdateInstanceData
+	glBufferData(GL_ARRAY_BUFFER, size, data, GL_DYNAMIC_DRAW);
+
+	unsigned int offset = 0;
+	unsigned int index = m_AttributeCount;
+
+	for(LayoutElement element : layout->GetElements()){
+
+		glEnableVertexAttribArray(index);
+		glVertexAttribPointer(index, element.count, element.type, element.normalized, layout->GetStride(), (const void*)(intptr_t)offset);
+		glVertexAttribDivisor(index, 1);
+
+		offset += element.count * sizeof(float);
+		index++;
+
 	}
 	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, m_VBOID);
+}
+
+void VertexArray::UpdateInstanceData(unsigned int offset, const void* data, unsigned int size){
+	glBindBuffer(GL_ARRAY_BUFFER, m_InstanceVBOID);
+	glBufferSubData(GL_ARRAY_BUFFER, offset, size, data);
 }
 
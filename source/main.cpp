@@ -2,9 +2,28 @@
 #include "MenuLayer.h"
 #include "GameLayer.h"
 #include "LevelManager.h"
+#include "FrameStats.h"
+#include "InputQueue.h"
+#include "InputRecording.h"
+#include "Log.h"
+#include "RenderThread.h"
 #include <glad.h>
 #include <GLFW/glfw3.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <thread>
+#include <vector>
+
+// Simulation rate; rendering interpolates between the last two steps
+static const double FIXED_TIMESTEP = 1.0 / 120.0;
+// A frame this far behind cannot catch up; the remaining steps are dropped instead
+static const int MAX_STEPS_PER_FRAME = 8;
+// Frames kept for the frame-time percentiles
+static const size_t FRAME_STATS_WINDOW = 4096;
 
 enum class AppState {
     MENU,
@@ -17,8 +36,29 @@ struct AppContext {
     GameLayer* gameLayer;
     AppState currentState;
     Application* app;
+    FrameStats* frameStats;
+    InputQueue* inputQueue;
+    RenderThread* renderThread;
+    double frameCap;          // Frames per second, 0 for no cap
 };
 
+// Late frames are measured against the cap, or the display refresh when the cap is off or faster
+void UpdateTargetInterval(AppContext* context) {
+    double interval = context->app->GetRefreshInterval();
+    if (context->frameCap > 0.0) {
+        interval = std::max(interval, 1.0 / context->frameCap);
+    }
+    context->frameStats->SetTargetInterval(interval);
+}
+
+// Seconds on the GLFW clock; headless, GLFW is never initialized, so the steady clock stands in
+double GetTime(bool isHeadless) {
+    if (isHeadless) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+    return glfwGetTime();
+}
+
 void FramebufferSizeCallback(GLFWwindow* window, int width, int height) {
     AppContext* context = (AppContext*)glfwGetWindowUserPointer(window);
     if (context != nullptr && context->app != nullptr) {
@@ -26,152 +66,418 @@ void FramebufferSizeCallback(GLFWwindow* window, int width, int height) {
     }
 }
 
+void WindowSizeCallback(GLFWwindow* window, int width, int height) {
+    AppContext* context = (AppContext*)glfwGetWindowUserPointer(window);
+    if (context != nullptr && context->app != nullptr) {
+        context->app->OnWindowResize(width, height);
+    }
+}
+
+// Input callbacks only queue the event; the frame hands them to the active layer in one batch
 void MouseButtonCallBack(GLFWwindow* window, int button, int action, int mods) {
     AppContext* context = (AppContext*)glfwGetWindowUserPointer(window);
-    
-    double mouseX, mouseY;
-    glfwGetCursorPos(window, &mouseX, &mouseY);
-    
     if (context != nullptr) {
-        if (context->currentState == AppState::MENU && context->menuLayer != nullptr) {
-            context->menuLayer->OnMouseButtonEvent(button, action, mods, mouseX, mouseY);
-        } else if (context->currentState == AppState::GAME && context->gameLayer != nullptr) {
-            context->gameLayer->OnMouseButtonEvent(button, action, mods, mouseX, mouseY);
-        }
+        context->inputQueue->PushMouseButton(button, action, mods, glfwGetTime());
+    }
+}
+
+void CursorPosCallBack(GLFWwindow* window, double mouseX, double mouseY) {
+    AppContext* context = (AppContext*)glfwGetWindowUserPointer(window);
+    if (context != nullptr) {
+        context->inputQueue->PushCursorMove(mouseX, mouseY, glfwGetTime());
     }
 }
 
 void KeyCallBack(GLFWwindow* window, int key, int scancode, int action, int mods) {
     AppContext* context = (AppContext*)glfwGetWindowUserPointer(window);
-    
     if (context != nullptr) {
-        if (context->currentState == AppState::MENU && context->menuLayer != nullptr) {
-            context->menuLayer->OnKeyEvent(key, scancode, action, mods);
-        } else if (context->currentState == AppState::GAME && context->gameLayer != nullptr) {
-            context->gameLayer->OnKeyEvent(key, scancode, action, mods);
+        context->inputQueue->PushKey(key, scancode, action, mods, glfwGetTime());
+    }
+}
+
+void ScrollCallBack(GLFWwindow* window, double offsetX, double offsetY) {
+    AppContext* context = (AppContext*)glfwGetWindowUserPointer(window);
+    if (context != nullptr) {
+        context->inputQueue->PushScroll(offsetX, offsetY, glfwGetTime());
+    }
+}
+
+void DispatchInput(AppContext* context, const std::vector<InputEvent>& events) {
+    // Frame pacing keys work in every state; the layers ignore them
+    for (const InputEvent& event : events) {
+        if (event.type != InputEventType::KEY || event.action != GLFW_PRESS) {
+            continue;
+        }
+        if (event.code == GLFW_KEY_F2) {
+            LogMessage message(LogLevel::INFO, LogCategory::APP);
+            context->frameStats->Print(message.GetStream());
+        } else if (event.code == GLFW_KEY_F3) {
+            // The swap interval belongs to whichever thread has the context
+            context->renderThread->Invoke([context]() { context->app->SetVSync(!context->app->IsVSync()); });
+            UpdateTargetInterval(context);
+            LOG_INFO(APP, "VSync " << (context->app->IsVSync() ? "on" : "off"));
         }
     }
+    
+    if (events.empty()) {
+        return;
+    }
+    if (context->currentState == AppState::MENU && context->menuLayer != nullptr) {
+        context->menuLayer->OnInputEvents(events.data(), events.size());
+    } else if (context->currentState == AppState::GAME && context->gameLayer != nullptr) {
+        context->gameLayer->OnInputEvents(events.data(), events.size());
+    }
 }
 
 void PrintMenuHelp() {
-    std::cout << "\n========================================\n";
-    std::cout << "   Tangram Puzzle Game - Menu\n";
-    std::cout << "========================================\n\n";
-    std::cout << "Click on a level button to start playing!\n";
-    std::cout << "Ctrl+Q - Quit application\n\n";
-    std::cout << "========================================\n\n";
+    LOG_INFO(APP, "\n========================================");
+    LOG_INFO(APP, "   Tangram Puzzle Game - Menu");
+    LOG_INFO(APP, "========================================\n");
+    LOG_INFO(APP, "Click on a level button to start playing!");
+    LOG_INFO(APP, "Mouse Wheel / Drag - Scroll the levels");
+    LOG_INFO(APP, "Page Up / Page Down / Home / End - Scroll by pages");
+    LOG_INFO(APP, "F2 - Print frame statistics, F3 - Toggle VSync");
+    LOG_INFO(APP, "Ctrl+Q - Quit application\n");
+    LOG_INFO(APP, "========================================\n");
 }
 
 void PrintGameHelp() {
-    std::cout << "\n========================================\n";
-    std::cout << "   Tangram Puzzle Game - Controls\n";
-    std::cout << "========================================\n\n";
-    
-    std::cout << "PIECE MANIPULATION:\n";
-    std::cout << "  Left Click - Select and drag piece\n";
-    std::cout << "  Q - Rotate piece counter-clockwise\n";
-    std::cout << "  E - Rotate piece clockwise\n";
-    std::cout << "  F - Flip piece horizontally\n\n";
-    
-    std::cout << "VIEW CONTROLS:\n";
-    std::cout << "  Z - Zoom in\n";
-    std::cout << "  X - Zoom out\n";
-    std::cout << "  Middle Mouse Button - Pan (drag to move view)\n";
-    std::cout << "  Space + Drag Mouse - Pan (hold space and drag)\n\n";
-    
-    std::cout << "GAME CONTROLS:\n";
-    std::cout << "  R - Reset level\n";
-    std::cout << "  C - Check solution\n";
-    std::cout << "  Ctrl+Q - Quit to menu\n\n";
-    
-    std::cout << "GOAL:\n";
-    std::cout << "  Arrange all 7 Tangram pieces to match the gray outline!\n\n";
-    
-    std::cout << "========================================\n\n";
+    LOG_INFO(APP, "\n========================================");
+    LOG_INFO(APP, "   Tangram Puzzle Game - Controls");
+    LOG_INFO(APP, "========================================\n");
+    
+    LOG_INFO(APP, "PIECE MANIPULATION:");
+    LOG_INFO(APP, "  Left Click - Select and drag piece");
+    LOG_INFO(APP, "  Q - Rotate piece counter-clockwise");
+    LOG_INFO(APP, "  E - Rotate piece clockwise");
+    LOG_INFO(APP, "  F - Flip piece horizontally\n");
+    
+    LOG_INFO(APP, "VIEW CONTROLS:");
+    LOG_INFO(APP, "  Z - Zoom in");
+    LOG_INFO(APP, "  X - Zoom out");
+    LOG_INFO(APP, "  Middle Mouse Button - Pan (drag to move view)");
+    LOG_INFO(APP, "  Space + Drag Mouse - Pan (hold space and drag)\n");
+    
+    LOG_INFO(APP, "GAME CONTROLS:");
+    LOG_INFO(APP, "  R - Reset level");
+    LOG_INFO(APP, "  C - Check solution");
+    LOG_INFO(APP, "  H - Show a hint for the next piece");
+    LOG_INFO(APP, "  Ctrl+Z / Ctrl+Y - Undo / redo a move");
+    LOG_INFO(APP, "  Ctrl+Q - Quit to menu\n");
+    
+    LOG_INFO(APP, "GOAL:");
+    LOG_INFO(APP, "  Arrange all 7 Tangram pieces to match the gray outline!\n");
+    
+    LOG_INFO(APP, "========================================\n");
 }
 
-int main() {
+void PrintUsage(const char* program) {
+    std::cout << "Usage: " << program << " [--fps-cap N] [--no-vsync] [--render-thread]\n"
+              << "       [--record FILE | --replay FILE [--fast] [--headless]] [levels.pack]\n";
+}
+
+int main(int argc, char** argv) {
+    // Frame pacing options, then an optional level pack
+    double frameCap = 0.0;
+    bool isVSync = true;
+    bool isRenderThreaded = false;
+    // Input recording, or a recording replayed instead of the live input
+    const char* recordPath = nullptr;
+    const char* replayPath = nullptr;
+    bool isFastReplay = false;
+    bool isHeadless = false;
+    const char* packPath = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--fps-cap") == 0 && i + 1 < argc) {
+            frameCap = std::max(0.0, std::atof(argv[++i]));
+        } else if (std::strcmp(argv[i], "--no-vsync") == 0) {
+            isVSync = false;
+        } else if (std::strcmp(argv[i], "--render-thread") == 0) {
+            isRenderThreaded = true;
+        } else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            recordPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replayPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--fast") == 0) {
+            isFastReplay = true;
+        } else if (std::strcmp(argv[i], "--headless") == 0) {
+            isHeadless = true;
+            isFastReplay = true;
+        } else if (argv[i][0] == '-') {
+            PrintUsage(argv[0]);
+            return 1;
+        } else {
+            packPath = argv[i];
+        }
+    }
+    if ((isFastReplay && replayPath == nullptr) || (recordPath != nullptr && replayPath != nullptr)) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+    
+    // Console output from here on goes through the background writer
+    Log::Start();
+    
+    // The replay decides the frame sizes; the file is read before the window opens
+    InputReplay replay;
+    if (replayPath != nullptr && !replay.Open(replayPath)) {
+        Log::Stop();
+        return 1;
+    }
+    
     Application window(1280, 720, "Tangram Puzzle Game");
-    window.Run();
+    // Headless replays only simulate: no window, and the layers' GL calls go to the null backend
+    if (isHeadless) {
+        window.RunNull();
+    } else {
+        window.Run();
+        window.SetVSync(isVSync && !isFastReplay);
+    }
     
     // Initialize level manager
+    // Optional level pack on the command line, the built-in levels otherwise
     LevelManager levelManager;
-    levelManager.LoadLevels();
+    if (packPath == nullptr || !levelManager.LoadLevelPack(packPath)) {
+        levelManager.LoadLevels();
+    }
     
-    std::cout << "Loaded " << levelManager.GetLevelCount() << " levels!\n";
+    LOG_INFO(APP, "Loaded " << levelManager.GetLevelCount() << " levels!");
     
     // Create menu layer
     MenuLayer menuLayer("shaders/vertex_shader.glsl", "shaders/fragment_shader.glsl", &window, &levelManager);
     
+    // From here on GL only runs inside command lists and Invoke
+    RenderThread renderThread(&window, isRenderThreaded);
+    renderThread.Start();
+    
+    FrameStats frameStats(FRAME_STATS_WINDOW);
+    InputQueue inputQueue;
+    double cursorX = 0.0;
+    double cursorY = 0.0;
+    if (!isHeadless) {
+        glfwGetCursorPos(window.GetWindow(), &cursorX, &cursorY);
+    }
+    inputQueue.SetCursorPosition(cursorX, cursorY);
+    
+    InputRecorder recorder;
+    if (recordPath != nullptr && !recorder.Open(recordPath, cursorX, cursorY)) {
+        return 1;
+    }
+    
     // App context for managing state
     AppContext context;
     context.menuLayer = &menuLayer;
     context.gameLayer = nullptr;
     context.currentState = AppState::MENU;
     context.app = &window;
+    context.frameStats = &frameStats;
+    context.inputQueue = &inputQueue;
+    context.renderThread = &renderThread;
+    context.frameCap = frameCap;
+    UpdateTargetInterval(&context);
     
-    glfwSetWindowUserPointer(window.GetWindow(), &context);
-    glfwSetMouseButtonCallback(window.GetWindow(), MouseButtonCallBack);
-    glfwSetKeyCallback(window.GetWindow(), KeyCallBack);
-    glfwSetFramebufferSizeCallback(window.GetWindow(), FramebufferSizeCallback);
+    // A replay takes its input and sizes from the recording only
+    if (!isHeadless) {
+        glfwSetWindowUserPointer(window.GetWindow(), &context);
+    }
+    if (!replay.IsOpen()) {
+        glfwSetMouseButtonCallback(window.GetWindow(), MouseButtonCallBack);
+        glfwSetCursorPosCallback(window.GetWindow(), CursorPosCallBack);
+        glfwSetKeyCallback(window.GetWindow(), KeyCallBack);
+        glfwSetScrollCallback(window.GetWindow(), ScrollCallBack);
+        glfwSetFramebufferSizeCallback(window.GetWindow(), FramebufferSizeCallback);
+        glfwSetWindowSizeCallback(window.GetWindow(), WindowSizeCallback);
+    }
     
     PrintMenuHelp();
     
     GameLayer* currentGameLayer = nullptr;
+    // Keeps the level alive while it is played, even once the level cache has dropped it
+    std::shared_ptr<Level> currentLevel;
+    
+    // Simulation time not yet stepped through; carried over between frames
+    double accumulator = 0.0;
+    double previousFrameStart = GetTime(isHeadless);
+    std::chrono::steady_clock::time_point nextFrame = std::chrono::steady_clock::now();
+    // This frame's input; reused so draining never allocates once it has grown
+    std::vector<InputEvent> inputEvents;
+    inputEvents.reserve(InputQueue::CAPACITY);
+    int completedLevels = 0;
     
-    while (!glfwWindowShouldClose(window.GetWindow())) {
-        glClear(GL_COLOR_BUFFER_BIT);
+    // Headless, the replay running out is the only way out
+    while (isHeadless || !glfwWindowShouldClose(window.GetWindow())) {
+        double frameStart = GetTime(isHeadless);
+        double frameTime = frameStart - previousFrameStart;
+        previousFrameStart = frameStart;
+        frameStats.AddFrame(frameTime);
+        
+        // Input goes in right before the steps that use it
+        if (!isHeadless) {
+            glfwPollEvents();
+        }
+        // Simulated time; a replay steps through the recorded frame times, so it runs the same
+        // steps on the same input however long its own frames take
+        double stepTime = frameTime;
+        if (replay.IsOpen()) {
+            RecordedFrame frame;
+            if (!replay.ReadFrame(frame, inputEvents)) {
+                break;
+            }
+            stepTime = frame.frameTime;
+            if (frame.framebufferWidth != window.GetWidth() || frame.framebufferHeight != window.GetHeight()) {
+                window.OnResize(frame.framebufferWidth, frame.framebufferHeight);
+            }
+            window.OnWindowResize(frame.windowWidth, frame.windowHeight);
+            
+            // Real speed: each frame starts when it did in the recording
+            if (!isFastReplay) {
+                nextFrame += std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                    std::chrono::duration<double>(frame.frameTime));
+                std::this_thread::sleep_until(nextFrame);
+            }
+        } else {
+            inputQueue.Drain(inputEvents);
+            if (recorder.IsOpen()) {
+                RecordedFrame frame = {frameTime, window.GetWindowWidth(), window.GetWindowHeight(),
+                                       window.GetWidth(), window.GetHeight()};
+                recorder.WriteFrame(frame, inputEvents);
+            }
+        }
+        DispatchInput(&context, inputEvents);
+        
+        // Fixed simulation steps for the time that passed
+        accumulator += stepTime;
+        int steps = 0;
+        while (accumulator >= FIXED_TIMESTEP && steps < MAX_STEPS_PER_FRAME) {
+            if (context.currentState == AppState::MENU) {
+                menuLayer.OnUpdate(window.GetWindow(), (float)FIXED_TIMESTEP);
+            } else if (currentGameLayer != nullptr) {
+                currentGameLayer->OnUpdate(window.GetWindow(), (float)FIXED_TIMESTEP);
+            }
+            accumulator -= FIXED_TIMESTEP;
+            ++steps;
+        }
+        if (accumulator >= FIXED_TIMESTEP) {
+            frameStats.AddSkippedSteps((uint64_t)(accumulator / FIXED_TIMESTEP));
+            accumulator = std::fmod(accumulator, FIXED_TIMESTEP);
+        }
+        float alpha = (float)(accumulator / FIXED_TIMESTEP);
+        
+        // Headless, nothing is drawn at all
+        CommandList* commands = nullptr;
+        if (!isHeadless) {
+            // The list coming back last carried a frame that has been presented since
+            commands = &renderThread.BeginFrame();
+            if (commands->GetPresentTime() > 0.0) {
+                for (double inputTime : commands->GetInputTimes()) {
+                    frameStats.AddInputLatency(commands->GetPresentTime() - inputTime);
+                }
+            }
+            commands->Reset(window.GetWidth(), window.GetHeight());
+            // Replayed events carry the times of the recording session
+            if (!replay.IsOpen()) {
+                for (const InputEvent& event : inputEvents) {
+                    commands->GetInputTimes().push_back(event.time);
+                }
+            }
+        }
         
         if (context.currentState == AppState::MENU) {
-            menuLayer.OnUpdate(window.GetWindow());
-            menuLayer.OnRender();
+            if (commands != nullptr) {
+                menuLayer.OnRender(*commands, alpha);
+            }
             
             // Check if a level was selected
             int selectedLevel = menuLayer.GetSelectedLevel();
             if (selectedLevel >= 0) {
-                Level* level = levelManager.GetLevel(selectedLevel);
+                std::shared_ptr<Level> level = levelManager.GetLevel(selectedLevel);
                 if (level != nullptr) {
-                    // Switch to game state
-                    if (currentGameLayer != nullptr) {
-                        delete currentGameLayer;
+                    // Switch to game state; the layer owns GL objects, so it comes and goes
+                    // with the context current
+                    renderThread.Invoke([&]() {
+                        if (currentGameLayer != nullptr) {
+                            delete currentGameLayer;
+                        }
+                        currentGameLayer = new GameLayer(
+                            "shaders/vertex_shader.glsl",
+                            "shaders/fragment_shader.glsl",
+                            &window,
+                            level.get()
+                        );
+                    });
+                    if (replay.IsOpen()) {
+                        currentGameLayer->SetCursorPosition(replay.GetCursorX(), replay.GetCursorY());
+                    } else {
+                        currentGameLayer->SetCursorPosition(inputQueue.GetCursorX(), inputQueue.GetCursorY());
                     }
-                    currentGameLayer = new GameLayer(
-                        "shaders/vertex_shader.glsl",
-                        "shaders/fragment_shader.glsl",
-                        &window,
-                        level
-                    );
+                    currentLevel = level;
                     context.gameLayer = currentGameLayer;
                     context.currentState = AppState::GAME;
                     menuLayer.ResetSelection();
                     
-                    std::cout << "\n=== Starting Level " << (selectedLevel + 1) << ": " 
-                              << level->GetName() << " ===\n";
+                    LOG_INFO(APP, "\n=== Starting Level " << (selectedLevel + 1) << ": " 
+                              << level->GetName() << " ===");
                     PrintGameHelp();
                 }
             }
         } else if (context.currentState == AppState::GAME) {
             if (currentGameLayer != nullptr) {
-                currentGameLayer->OnUpdate(window.GetWindow());
-                currentGameLayer->OnRender();
+                if (commands != nullptr) {
+                    currentGameLayer->OnRender(*commands, alpha);
+                }
                 
                 // Check if level is completed
                 if (currentGameLayer->GetGameState() == GameState::COMPLETED) {
-                    std::cout << "\n=== Level Completed! Returning to menu... ===\n\n";
+                    LOG_INFO(APP, "\n=== Level Completed! Returning to menu... ===\n");
+                    ++completedLevels;
                     context.currentState = AppState::MENU;
                     PrintMenuHelp();
                 }
             }
         }
         
-        glfwSwapBuffers(window.GetWindow());
-        glfwPollEvents();
+        if (commands != nullptr) {
+            renderThread.Submit();
+        }
+        
+        // Frame cap: sleep out the rest of this frame's slot; a late frame starts the next slot now
+        if (context.frameCap > 0.0 && !replay.IsOpen()) {
+            std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+            nextFrame += std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(1.0 / context.frameCap));
+            if (nextFrame < now) {
+                nextFrame = now;
+            }
+            std::this_thread::sleep_until(nextFrame);
+        }
     }
     
-    // Cleanup
+    // Cleanup; the context comes back to this thread first
+    renderThread.Stop();
+    uint64_t finalStateHash = currentGameLayer != nullptr ? currentGameLayer->GetStateHash() : 0;
     if (currentGameLayer != nullptr) {
         delete currentGameLayer;
     }
+    bool isRecording = recorder.IsOpen();
+    recorder.Close();
+    Log::Stop();
+    
+    std::cout << "\n=== Frame statistics ===\n";
+    frameStats.Print(std::cout);
+    std::cout << "Input events merged: " << inputQueue.GetCoalescedCount()
+              << ", dropped: " << inputQueue.GetDroppedCount() << std::endl;
+    if (isRecording) {
+        std::cout << "Recorded " << recorder.GetFrameCount() << " frames to " << recordPath << std::endl;
+    }
+    if (replayPath != nullptr) {
+        // The state hash matches between replays of one recording; a change means the
+        // simulation no longer behaves the same
+        std::cout << "Replayed " << replay.GetFrameCount() << " frames, " << replay.GetEventCount()
+                  << " events, " << completedLevels << " levels completed" << std::endl;
+        if (finalStateHash != 0) {
+            std::cout << "Final game state hash: " << std::hex << finalStateHash << std::dec << std::endl;
+        }
+    }
     
     return 0;
 }
@@ -0,0 +1,433 @@
+// Microbenchmarks of the geometry and interaction hot paths. Each benchmark runs for at least
+// the minimum time and reports the time and the operator new calls per operation; --json
+// writes the same results for tracking between builds.
+//
+//   Benchmark [--filter TEXT] [--min-time SECONDS] [--json FILE] [--null-gl]
+//
+// Shapes own GL buffers, so a hidden window provides the context; --null-gl runs without one,
+// on the GLRecorder null backend. Run it from the root directory so the game layer finds the
+// shaders/ folder.
+#include "Application.h"
+#include "Circle.h"
+#include "GameLayer.h"
+#include "LevelManager.h"
+#include "Log.h"
+#include "Polygon.h"
+#include "Rectangle.h"
+#include "SnapIndex.h"
+#include "TangramParallelogram.h"
+#include "TangramSquare.h"
+#include "TangramTriangle.h"
+#include "Triangle.h"
+#include <GLFW/glfw3.h>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+// Allocations of the benchmarking thread only; the log writer and the level prefetch thread
+// allocate on their own schedule
+static thread_local uint64_t t_AllocationCount = 0;
+
+// Kept out of line: once inlined into a caller, GCC pairs the malloc() and free() inside them
+// with the new and delete expressions and reports a mismatch
+__attribute__((noinline)) void* operator new(size_t size) {
+    ++t_AllocationCount;
+    void* memory = std::malloc(size == 0 ? 1 : size);
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+__attribute__((noinline)) void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+__attribute__((noinline)) void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+__attribute__((noinline)) void operator delete[](void* memory) noexcept {
+    std::free(memory);
+}
+
+__attribute__((noinline)) void operator delete(void* memory, size_t) noexcept {
+    std::free(memory);
+}
+
+__attribute__((noinline)) void operator delete[](void* memory, size_t) noexcept {
+    std::free(memory);
+}
+
+// Results are written here so the compiler cannot drop the measured calls
+static volatile float g_Sink = 0.0f;
+
+static void Consume(float value) { g_Sink = value; }
+static void Consume(bool value) { g_Sink = value ? 1.0f : 0.0f; }
+static void Consume(int value) { g_Sink = (float)value; }
+static void Consume(const glm::vec2& value) { g_Sink = value.x + value.y; }
+
+// Iteration count of one run, and the clock the setup of an iteration can be kept out of
+class BenchmarkState {
+public:
+    explicit BenchmarkState(uint64_t iterations)
+        : m_Iterations(iterations)
+        , m_PausedTime(0.0)
+        , m_PausedAllocations(0)
+        , m_PauseStart()
+        , m_PauseAllocationStart(0) {
+    }
+
+    uint64_t GetIterations() const { return m_Iterations; }
+
+    void PauseTiming() {
+        m_PauseAllocationStart = t_AllocationCount;
+        m_PauseStart = std::chrono::steady_clock::now();
+    }
+
+    void ResumeTiming() {
+        m_PausedTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - m_PauseStart).count();
+        m_PausedAllocations += t_AllocationCount - m_PauseAllocationStart;
+    }
+
+    double GetPausedTime() const { return m_PausedTime; }
+    uint64_t GetPausedAllocations() const { return m_PausedAllocations; }
+
+private:
+    uint64_t m_Iterations;
+    double m_PausedTime;
+    uint64_t m_PausedAllocations;
+    std::chrono::steady_clock::time_point m_PauseStart;
+    uint64_t m_PauseAllocationStart;
+};
+
+struct BenchmarkResult {
+    std::string name;
+    uint64_t iterations;
+    double nanosecondsPerOp;
+    double allocationsPerOp;
+};
+
+class BenchmarkRunner {
+public:
+    BenchmarkRunner(const std::string& filter, double minTime)
+        : m_Filter(filter)
+        , m_MinTime(minTime) {
+    }
+
+    // Doubles the iterations, or jumps to the estimate, until one run lasts the minimum time
+    void Run(const std::string& name, const std::function<void(BenchmarkState&)>& benchmark) {
+        if (!m_Filter.empty() && name.find(m_Filter) == std::string::npos) {
+            return;
+        }
+
+        const uint64_t maxIterations = 1ull << 32;
+        uint64_t iterations = 1;
+        while (true) {
+            BenchmarkState state(iterations);
+            uint64_t allocationStart = t_AllocationCount;
+            auto start = std::chrono::steady_clock::now();
+            benchmark(state);
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            uint64_t allocations = t_AllocationCount - allocationStart;
+
+            seconds -= state.GetPausedTime();
+            allocations -= state.GetPausedAllocations();
+            if (seconds >= m_MinTime || iterations >= maxIterations) {
+                BenchmarkResult result = {name, iterations, seconds * 1e9 / iterations,
+                                          (double)allocations / iterations};
+                PrintResult(result);
+                m_Results.push_back(result);
+                return;
+            }
+
+            uint64_t next = iterations * 2;
+            if (seconds > 0.0) {
+                uint64_t estimate = (uint64_t)(iterations * 1.2 * m_MinTime / seconds);
+                next = std::max(next, std::min(estimate, iterations * 100));
+            }
+            iterations = std::min(next, maxIterations);
+        }
+    }
+
+    bool WriteJson(const char* path) const {
+        std::ofstream file(path);
+        if (!file) {
+            std::cerr << "Cannot write " << path << std::endl;
+            return false;
+        }
+        file << "[\n";
+        for (size_t i = 0; i < m_Results.size(); ++i) {
+            const BenchmarkResult& result = m_Results[i];
+            file << "  {\"name\": \"" << result.name << "\", \"iterations\": " << result.iterations
+                 << ", \"ns_per_op\": " << result.nanosecondsPerOp
+                 << ", \"allocs_per_op\": " << result.allocationsPerOp << "}"
+                 << (i + 1 < m_Results.size() ? ",\n" : "\n");
+        }
+        file << "]\n";
+        return (bool)file;
+    }
+
+private:
+    void PrintResult(const BenchmarkResult& result) const {
+        std::cout << std::left << std::setw(44) << result.name << std::right
+                  << std::setw(12) << result.iterations
+                  << std::setw(14) << std::fixed << std::setprecision(1) << result.nanosecondsPerOp << " ns/op"
+                  << std::setw(10) << std::setprecision(2) << result.allocationsPerOp << " allocs/op"
+                  << std::defaultfloat << std::endl;
+    }
+
+    std::string m_Filter;
+    double m_MinTime;
+    std::vector<BenchmarkResult> m_Results;
+};
+
+// Fixed pseudo-random points, the same on every run
+static std::vector<glm::vec2> MakePoints(size_t count, float extent) {
+    std::vector<glm::vec2> points(count);
+    uint32_t state = 12345;
+    for (glm::vec2& point : points) {
+        state = state * 1664525u + 1013904223u;
+        point.x = ((state >> 8) / 16777216.0f * 2.0f - 1.0f) * extent;
+        state = state * 1664525u + 1013904223u;
+        point.y = ((state >> 8) / 16777216.0f * 2.0f - 1.0f) * extent;
+    }
+    return points;
+}
+
+// Concave star outline with the given number of vertices, anchor included
+static Polygon* MakeStar(int vertexCount) {
+    Polygon* polygon = new Polygon(1.0f, 0.0f, true);
+    for (int i = 1; i < vertexCount; ++i) {
+        float angle = 2.0f * (float)M_PI * i / vertexCount;
+        float radius = (i % 2 == 0) ? 1.0f : 0.5f;
+        polygon->AddPoint(radius * std::cos(angle), radius * std::sin(angle));
+    }
+    return polygon;
+}
+
+static std::vector<TangramPiece*> MakePieces() {
+    return {
+        new TangramTriangle(0.0f, 0.0f, TriangleSize::LARGE, 1.0f, 0.0f, 0.0f),
+        new TangramTriangle(0.0f, 0.0f, TriangleSize::LARGE, 0.0f, 1.0f, 0.0f),
+        new TangramTriangle(0.0f, 0.0f, TriangleSize::MEDIUM, 0.0f, 0.0f, 1.0f),
+        new TangramTriangle(0.0f, 0.0f, TriangleSize::SMALL, 1.0f, 1.0f, 0.0f),
+        new TangramTriangle(0.0f, 0.0f, TriangleSize::SMALL, 1.0f, 0.0f, 1.0f),
+        new TangramSquare(0.0f, 0.0f, 0.707f, 0.0f, 1.0f, 1.0f),
+        new TangramParallelogram(0.0f, 0.0f, 0.707f, 1.0f, 0.5f, 0.0f)
+    };
+}
+
+static void BenchmarkIsInside(BenchmarkRunner& runner, const std::vector<glm::vec2>& points) {
+    Polygon* star = MakeStar(8);
+    star->FinalizeShape();
+    std::vector<std::pair<std::string, Shape*>> shapes = {
+        {"Rectangle", new Rectangle(-0.5f, -0.5f, 0.5f, 0.5f, true)},
+        {"Triangle", new Triangle(-0.5f, -0.5f, 0.5f, 0.5f, true)},
+        {"Circle", new Circle(0.0f, 0.0f, 0.5f, 0.0f, true)},
+        {"Polygon", star},
+        {"TangramTriangle", new TangramTriangle(0.0f, 0.0f, TriangleSize::LARGE, 1.0f, 0.0f, 0.0f)},
+        {"TangramSquare", new TangramSquare(0.0f, 0.0f, 0.707f, 0.0f, 1.0f, 1.0f)},
+        {"TangramParallelogram", new TangramParallelogram(0.0f, 0.0f, 0.707f, 1.0f, 0.5f, 0.0f)}
+    };
+
+    size_t mask = points.size() - 1;
+    for (const auto& entry : shapes) {
+        const Shape* shape = entry.second;
+        runner.Run("IsInside/" + entry.first, [&](BenchmarkState& state) {
+            for (uint64_t i = 0; i < state.GetIterations(); ++i) {
+                const glm::vec2& point = points[i & mask];
+                Consume(shape->IsInside(point.x, point.y));
+            }
+        });
+    }
+
+    for (const auto& entry : shapes) {
+        delete entry.second;
+    }
+}
+
+static void BenchmarkPieces(BenchmarkRunner& runner) {
+    std::vector<TangramPiece*> pieces = MakePieces();
+    size_t count = pieces.size();
+
+    runner.Run("Piece/GetCenter", [&](BenchmarkState& state) {
+        for (uint64_t i = 0; i < state.GetIterations(); ++i) {
+            Consume(pieces[i % count]->GetCenter());
+        }
+    });
+    runner.Run("Piece/Rotate", [&](BenchmarkState& state) {
+        for (uint64_t i = 0; i < state.GetIterations(); ++i) {
+            pieces[i % count]->Rotate((float)M_PI / 4.0f);
+        }
+    });
+    runner.Run("Piece/Flip", [&](BenchmarkState& state) {
+        for (uint64_t i = 0; i < state.GetIterations(); ++i) {
+            pieces[i % count]->Flip();
+        }
+    });
+
+    for (TangramPiece* piece : pieces) {
+        delete piece;
+    }
+}
+
+// The slot search and rotation matching a release does before it snaps a piece
+static void BenchmarkSnap(BenchmarkRunner& runner, const Level& level, const std::vector<glm::vec2>& jitter) {
+    const PieceType types[] = {PieceType::LARGE_TRIANGLE, PieceType::LARGE_TRIANGLE, PieceType::MEDIUM_TRIANGLE,
+                               PieceType::SMALL_TRIANGLE, PieceType::SMALL_TRIANGLE, PieceType::SQUARE,
+                               PieceType::PARALLELOGRAM};
+    BoardState board;
+    for (PieceType type : types) {
+        board.AddPiece(type, glm::vec2(0.0f, 0.0f), glm::vec3(1.0f, 1.0f, 1.0f));
+    }
+    SnapIndex snapIndex;
+    snapIndex.Build(level.GetSolution(), board);
+
+    const std::vector<PiecePosition>& solution = level.GetSolution();
+    size_t mask = jitter.size() - 1;
+    runner.Run("Snap/NearSlot", [&](BenchmarkState& state) {
+        for (uint64_t i = 0; i < state.GetIterations(); ++i) {
+            const PiecePosition& target = solution[i % solution.size()];
+            glm::vec2 position = target.position + jitter[i & mask];
+            int slot = snapIndex.FindNearestFreeSlot(board.type[target.pieceIndex], position, 0.25f);
+            float rotation = 0.0f;
+            if (slot != -1) {
+                snapIndex.GetEquivalentRotation(slot, target.isFlipped, target.rotation + 0.1f, rotation);
+            }
+            Consume(rotation + slot);
+        }
+    });
+    runner.Run("Snap/NoSlot", [&](BenchmarkState& state) {
+        for (uint64_t i = 0; i < state.GetIterations(); ++i) {
+            glm::vec2 position = glm::vec2(20.0f, 20.0f) + jitter[i & mask];
+            Consume(snapIndex.FindNearestFreeSlot(types[i % 7], position, 0.25f));
+        }
+    });
+}
+
+static void BenchmarkGameLayer(BenchmarkRunner& runner, Application& window, Level* level,
+                               const std::vector<glm::vec2>& points) {
+    GameLayer gameLayer("shaders/vertex_shader.glsl", "shaders/fragment_shader.glsl", &window, level);
+
+    size_t mask = points.size() - 1;
+    float halfWidth = window.GetWindowWidth() * 0.5f;
+    float halfHeight = window.GetWindowHeight() * 0.5f;
+    runner.Run("GameLayer/ConvertScreenToWorld", [&](BenchmarkState& state) {
+        for (uint64_t i = 0; i < state.GetIterations(); ++i) {
+            const glm::vec2& point = points[i & mask];
+            float worldX, worldY;
+            gameLayer.ConvertScreenToWorld(halfWidth * (1.0f + point.x), halfHeight * (1.0f + point.y),
+                                           worldX, worldY);
+            Consume(worldX + worldY);
+        }
+    });
+
+    // Press and release on the topmost piece without moving it: the hit test, then the release
+    // handler's slot search that finds nothing in reach
+    glm::vec4 clip = window.GetProjectionMatrix() * glm::vec4(gameLayer.GetPiecePosition(6), 0.0f, 1.0f);
+    double screenX = (clip.x / clip.w + 1.0) * halfWidth;
+    double screenY = (1.0 - clip.y / clip.w) * halfHeight;
+    InputEvent click[2] = {
+        {InputEventType::MOUSE_BUTTON, GLFW_MOUSE_BUTTON_LEFT, 0, GLFW_PRESS, 0, screenX, screenY, 0.0},
+        {InputEventType::MOUSE_BUTTON, GLFW_MOUSE_BUTTON_LEFT, 0, GLFW_RELEASE, 0, screenX, screenY, 0.0}
+    };
+    runner.Run("GameLayer/PressRelease", [&](BenchmarkState& state) {
+        for (uint64_t i = 0; i < state.GetIterations(); ++i) {
+            gameLayer.OnInputEvents(click, 2);
+        }
+    });
+}
+
+static void BenchmarkFinalizeShape(BenchmarkRunner& runner) {
+    for (int vertexCount : {8, 64, 512}) {
+        runner.Run("Polygon/FinalizeShape/" + std::to_string(vertexCount), [&](BenchmarkState& state) {
+            for (uint64_t i = 0; i < state.GetIterations(); ++i) {
+                state.PauseTiming();
+                Polygon* polygon = MakeStar(vertexCount);
+                state.ResumeTiming();
+                polygon->FinalizeShape();
+                state.PauseTiming();
+                delete polygon;
+                state.ResumeTiming();
+            }
+        });
+    }
+}
+
+// Selecting the built-in levels and decoding every one of them from an empty cache
+static void BenchmarkLoadLevels(BenchmarkRunner& runner) {
+    LevelManager levelManager;
+    runner.Run("LevelManager/LoadLevels", [&](BenchmarkState& state) {
+        for (uint64_t i = 0; i < state.GetIterations(); ++i) {
+            levelManager.LoadLevels();
+            for (int index = 0; index < levelManager.GetLevelCount(); ++index) {
+                Consume(levelManager.GetLevel(index) != nullptr);
+            }
+        }
+    });
+}
+
+int main(int argc, char** argv) {
+    std::string filter;
+    double minTime = 0.5;
+    const char* jsonPath = nullptr;
+    bool isNullGL = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (std::strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+            minTime = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            jsonPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--null-gl") == 0) {
+            isNullGL = true;
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--filter TEXT] [--min-time SECONDS] [--json FILE] [--null-gl]" << std::endl;
+            return 2;
+        }
+    }
+
+    // Selecting and locking pieces logs at info level
+    Log::SetLevel(LogLevel::WARNING);
+
+    Application window(1280, 720, "Tangram Benchmark");
+    if (isNullGL) {
+        window.RunNull();
+    } else {
+        window.SetVisible(false);
+        window.Run();
+    }
+
+    LevelManager levelManager;
+    std::shared_ptr<Level> level = levelManager.GetLevel(0);
+    if (level == nullptr) {
+        std::cerr << "No level to benchmark with" << std::endl;
+        return 1;
+    }
+
+    // Power-of-two counts, so the loops pick a point with a mask
+    std::vector<glm::vec2> points = MakePoints(1024, 1.5f);
+    std::vector<glm::vec2> jitter = MakePoints(256, 0.1f);
+
+    BenchmarkRunner runner(filter, minTime);
+    BenchmarkIsInside(runner, points);
+    BenchmarkPieces(runner);
+    BenchmarkSnap(runner, *level, jitter);
+    BenchmarkGameLayer(runner, window, level.get(), points);
+    BenchmarkFinalizeShape(runner);
+    BenchmarkLoadLevels(runner);
+
+    if (jsonPath != nullptr && !runner.WriteJson(jsonPath)) {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,244 @@
+// Stress benchmark for the shape editor: fills the canvas with N random shapes and plays scripted
+// pan, zoom, select and drag sequences through the Layer, frame by frame.
+//
+//   LayerStress [--frames N] [counts...]      (default counts: 1000 10000 100000 1000000)
+//
+// Every frame is timed from the input to glFinish, so the GPU share of the work is included, and
+// its GL calls are counted by the GLRecorder.
+// Each shape owns a vertex array, buffers and a draw call, so the scene build, the frame time
+// and the pick latency all grow with N. `make stress` runs it under Mesa's software rasterizer
+// in a hidden window; with no display at all, wrap it in xvfb-run.
+#include "Application.h"
+#include "FrameStats.h"
+#include "GLRecorder.h"
+#include "Layer.h"
+#include "Log.h"
+#include <glad.h>
+#include <GLFW/glfw3.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+static const uint32_t SCENE_SEED = 1;
+
+// Pixels the cursor moves per frame while panning and dragging
+static const double CURSOR_STEP = 6.0;
+
+// Random clicks tried to find a shape to drag
+static const int DRAG_PICK_ATTEMPTS = 64;
+
+static double Now() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static InputEvent MakeButton(int button, int action, double x, double y) {
+    return {InputEventType::MOUSE_BUTTON, button, 0, action, 0, x, y, 0.0};
+}
+
+static InputEvent MakeCursor(double x, double y) {
+    return {InputEventType::CURSOR_MOVE, 0, 0, 0, 0, x, y, 0.0};
+}
+
+static InputEvent MakeKey(int key) {
+    return {InputEventType::KEY, key, 0, GLFW_PRESS, 0, 0.0, 0.0, 0.0};
+}
+
+// Frame times and GL traffic of one scripted sequence
+class PhaseStats {
+public:
+    explicit PhaseStats(size_t frameCount)
+        : m_FrameTimes(frameCount) {
+    }
+
+    // Input handed over in one batch, one update, the render and a glFinish
+    void RunFrame(Application& window, Layer& layer, const std::vector<InputEvent>& events) {
+        GLRecorder::BeginFrame();
+        double start = Now();
+
+        layer.OnInputEvents(events.data(), events.size());
+        layer.OnUpdate(window.GetWindow());
+        glClear(GL_COLOR_BUFFER_BIT);
+        layer.OnRender();
+        glFinish();
+
+        m_FrameTimes.Add(Now() - start);
+        const GLCallCounts& counts = GLRecorder::GetFrameCounts();
+        m_Calls.draws += counts.draws;
+        m_Calls.binds += counts.binds;
+        m_Calls.uploadedBytes += counts.uploadedBytes;
+        m_Calls.uniforms += counts.uniforms;
+        m_Calls.programSwitches += counts.programSwitches;
+    }
+
+    void Print(const char* name) const {
+        uint64_t frames = std::max<uint64_t>(m_FrameTimes.GetCount(), 1);
+        std::cout << "  " << std::left << std::setw(8) << name << std::right << std::fixed
+                  << std::setprecision(2)
+                  << std::setw(10) << m_FrameTimes.GetAverage() * 1000.0 << " ms avg"
+                  << std::setw(10) << m_FrameTimes.GetPercentile(95.0) * 1000.0 << " ms p95"
+                  << std::setw(12) << m_Calls.uploadedBytes / 1024.0 / frames << " KiB/frame"
+                  << std::setw(10) << m_Calls.draws / frames << " draws"
+                  << std::setw(10) << m_Calls.binds / frames << " binds"
+                  << std::setw(10) << m_Calls.uniforms / frames << " uniforms"
+                  << std::setw(6) << m_Calls.programSwitches / frames << " programs/frame"
+                  << std::defaultfloat << std::endl;
+    }
+
+private:
+    SampleWindow m_FrameTimes;
+    // Summed over the phase's frames
+    GLCallCounts m_Calls;
+};
+
+static void RunScene(Application& window, size_t shapeCount, int frameCount) {
+    Layer layer("shaders/vertex_shader.glsl", "shaders/fragment_shader.glsl", &window);
+    double centerX = window.GetWidth() * 0.5;
+    double centerY = window.GetHeight() * 0.5;
+    layer.SetCursorPosition(centerX, centerY);
+
+    uint64_t uploadStart = GLRecorder::GetTotalCounts().uploadedBytes;
+    double buildStart = Now();
+    layer.GenerateStressScene(shapeCount, SCENE_SEED);
+    glFinish();
+    double buildTime = Now() - buildStart;
+    uint64_t buildBytes = GLRecorder::GetTotalCounts().uploadedBytes - uploadStart;
+
+    std::cout << "N = " << shapeCount << ": scene built in " << std::fixed << std::setprecision(3)
+              << buildTime << " s, " << std::setprecision(1) << buildBytes / (1024.0 * 1024.0)
+              << " MiB uploaded" << std::defaultfloat << std::endl;
+
+    // The Layer logs every selection and zoom step
+    Log::SetLevel(LogLevel::WARNING);
+
+    std::vector<InputEvent> events;
+    PhaseStats idle(frameCount);
+    for (int frame = 0; frame < frameCount; ++frame) {
+        idle.RunFrame(window, layer, events);
+    }
+
+    // Middle-button pan across the canvas
+    PhaseStats pan(frameCount);
+    double cursorX = centerX;
+    for (int frame = 0; frame < frameCount; ++frame) {
+        events.clear();
+        if (frame == 0) {
+            events.push_back(MakeButton(GLFW_MOUSE_BUTTON_MIDDLE, GLFW_PRESS, cursorX, centerY));
+        }
+        cursorX += CURSOR_STEP;
+        events.push_back(MakeCursor(cursorX, centerY));
+        if (frame == frameCount - 1) {
+            events.push_back(MakeButton(GLFW_MOUSE_BUTTON_MIDDLE, GLFW_RELEASE, cursorX, centerY));
+        }
+        pan.RunFrame(window, layer, events);
+    }
+
+    // Zoom in for half the frames and back out for the rest
+    PhaseStats zoom(frameCount);
+    for (int frame = 0; frame < frameCount; ++frame) {
+        events.assign(1, MakeKey(frame < frameCount / 2 ? GLFW_KEY_Z : GLFW_KEY_X));
+        zoom.RunFrame(window, layer, events);
+    }
+
+    // A click per frame at random points; the pick is the press alone, timed on its own
+    std::mt19937 random(SCENE_SEED);
+    std::uniform_real_distribution<double> screenX(0.0, window.GetWidth());
+    std::uniform_real_distribution<double> screenY(0.0, window.GetHeight());
+    PhaseStats select(frameCount);
+    SampleWindow pickLatencies(frameCount + 1);
+    int hits = 0;
+    for (int frame = 0; frame < frameCount; ++frame) {
+        double x = screenX(random);
+        double y = screenY(random);
+        InputEvent press = MakeButton(GLFW_MOUSE_BUTTON_LEFT, GLFW_PRESS, x, y);
+        double pickStart = Now();
+        layer.OnInputEvents(&press, 1);
+        pickLatencies.Add(Now() - pickStart);
+        hits += layer.GetSelectionCount() > 0 ? 1 : 0;
+
+        events.assign(1, MakeButton(GLFW_MOUSE_BUTTON_LEFT, GLFW_RELEASE, x, y));
+        select.RunFrame(window, layer, events);
+    }
+
+    // Drag the first shape a random click lands on
+    PhaseStats drag(frameCount);
+    double dragX = centerX;
+    double dragY = centerY;
+    bool isGrabbed = false;
+    for (int attempt = 0; attempt < DRAG_PICK_ATTEMPTS && !isGrabbed; ++attempt) {
+        dragX = screenX(random);
+        dragY = screenY(random);
+        InputEvent press = MakeButton(GLFW_MOUSE_BUTTON_LEFT, GLFW_PRESS, dragX, dragY);
+        layer.OnInputEvents(&press, 1);
+        isGrabbed = layer.GetSelectionCount() > 0;
+        if (!isGrabbed) {
+            InputEvent release = MakeButton(GLFW_MOUSE_BUTTON_LEFT, GLFW_RELEASE, dragX, dragY);
+            layer.OnInputEvents(&release, 1);
+        }
+    }
+    if (isGrabbed) {
+        for (int frame = 0; frame < frameCount; ++frame) {
+            dragX += CURSOR_STEP;
+            events.assign(1, MakeCursor(dragX, dragY));
+            if (frame == frameCount - 1) {
+                events.push_back(MakeButton(GLFW_MOUSE_BUTTON_LEFT, GLFW_RELEASE, dragX, dragY));
+            }
+            drag.RunFrame(window, layer, events);
+        }
+    }
+
+    Log::SetLevel(LogLevel::INFO);
+
+    idle.Print("idle");
+    pan.Print("pan");
+    zoom.Print("zoom");
+    select.Print("select");
+    if (isGrabbed) {
+        drag.Print("drag");
+    } else {
+        std::cout << "  drag    no shape under " << DRAG_PICK_ATTEMPTS << " random clicks" << std::endl;
+    }
+    std::cout << "  pick    " << std::fixed << std::setprecision(1)
+              << pickLatencies.GetAverage() * 1e6 << " us avg, "
+              << pickLatencies.GetPercentile(95.0) * 1e6 << " us p95, "
+              << hits << "/" << frameCount << " clicks hit a shape" << std::defaultfloat << std::endl;
+}
+
+int main(int argc, char** argv) {
+    int frameCount = 20;
+    std::vector<size_t> shapeCounts;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            frameCount = std::atoi(argv[++i]);
+        } else if (std::atoll(argv[i]) > 0) {
+            shapeCounts.push_back((size_t)std::atoll(argv[i]));
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--frames N] [counts...]" << std::endl;
+            return 2;
+        }
+    }
+    if (frameCount < 2) {
+        std::cerr << "--frames needs at least 2 frames" << std::endl;
+        return 2;
+    }
+    if (shapeCounts.empty()) {
+        shapeCounts = {1000, 10000, 100000, 1000000};
+    }
+
+    Application window(1280, 720, "Tangram Layer Stress");
+    window.SetVisible(false);
+    window.Run();
+    window.SetVSync(false);
+    GLRecorder::Install();
+    std::cout << "GL renderer: " << (const char*)glGetString(GL_RENDERER) << ", "
+              << frameCount << " frames per sequence" << std::endl;
+
+    for (size_t shapeCount : shapeCounts) {
+        RunScene(window, shapeCount, frameCount);
+    }
+    return 0;
+}
@@ -0,0 +1,140 @@
+// Level-pack compiler: turns the text level format into a binary pack (see LevelPack.h).
+//
+//   PackLevels <levels.txt> <levels.pack>   compile a text file
+//   PackLevels --export <levels.txt>        write the built-in levels as text to start from
+//
+// Text format, one record per line, '#' starts a comment:
+//   level <number> <name>
+//   vertex <x> <y>                                  silhouette, in order
+//   piece <index> <x> <y> <degrees> <flipped 0|1>   solution, same convention as the 'P' key
+//   end
+//
+// The packed silhouette, holes included, is derived from the solution; the vertex lines are
+// only kept for levels whose pieces are off the lattice or overlap.
+#include "LevelManager.h"
+#include "LevelPack.h"
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+static bool CompileText(const std::string& inputPath, LevelPackWriter& writer) {
+    std::ifstream input(inputPath);
+    if (!input) {
+        std::cerr << "Cannot open " << inputPath << std::endl;
+        return false;
+    }
+
+    bool isInLevel = false;
+    int levelNumber = 0;
+    std::string name;
+    std::vector<glm::vec2> silhouette;
+    std::vector<PiecePosition> solution;
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(input, line)) {
+        ++lineNumber;
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+        std::istringstream stream(line);
+        std::string keyword;
+        if (!(stream >> keyword)) {
+            continue;
+        }
+
+        bool isValid = true;
+        if (keyword == "level") {
+            isValid = !isInLevel && (stream >> levelNumber);
+            std::getline(stream >> std::ws, name);
+            silhouette.clear();
+            solution.clear();
+            isInLevel = true;
+        } else if (keyword == "vertex") {
+            glm::vec2 vertex;
+            isValid = isInLevel && (stream >> vertex.x >> vertex.y);
+            silhouette.push_back(vertex);
+        } else if (keyword == "piece") {
+            PiecePosition target;
+            float degrees = 0.0f;
+            int flipped = 0;
+            isValid = isInLevel && (stream >> target.pieceIndex >> target.position.x >> target.position.y >> degrees >> flipped);
+            target.rotation = glm::radians(degrees);
+            target.isFlipped = flipped != 0;
+            solution.push_back(target);
+        } else if (keyword == "end") {
+            isValid = isInLevel;
+            if (isValid) {
+                Level level(levelNumber, name, silhouette, solution);
+                level.DeriveSilhouette();
+                writer.AddLevel(level);
+            }
+            isInLevel = false;
+        } else {
+            isValid = false;
+        }
+
+        if (!isValid) {
+            std::cerr << inputPath << ":" << lineNumber << ": cannot parse '" << line << "'" << std::endl;
+            return false;
+        }
+    }
+
+    if (isInLevel) {
+        std::cerr << inputPath << ": level " << levelNumber << " is missing 'end'" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+static bool ExportBuiltinLevels(const std::string& outputPath) {
+    std::ofstream output(outputPath);
+    if (!output) {
+        std::cerr << "Cannot write " << outputPath << std::endl;
+        return false;
+    }
+
+    LevelManager levelManager;
+    levelManager.LoadLevels();
+    output.precision(9);
+    for (int i = 0; i < levelManager.GetLevelCount(); ++i) {
+        std::shared_ptr<Level> level = levelManager.GetLevel(i);
+        output << "level " << level->GetLevelNumber() << " " << level->GetName() << "\n";
+        for (const glm::vec2& vertex : level->GetSilhouetteVertices()) {
+            output << "vertex " << vertex.x << " " << vertex.y << "\n";
+        }
+        for (const PiecePosition& target : level->GetSolution()) {
+            output << "piece " << target.pieceIndex << " " << target.position.x << " " << target.position.y << " "
+                   << glm::degrees(target.rotation) << " " << (target.isFlipped ? 1 : 0) << "\n";
+        }
+        output << "end\n\n";
+    }
+    std::cout << "Exported " << levelManager.GetLevelCount() << " levels to " << outputPath << std::endl;
+    return true;
+}
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::cerr << "Usage: " << argv[0] << " <levels.txt> <levels.pack>\n"
+                  << "       " << argv[0] << " --export <levels.txt>" << std::endl;
+        return 2;
+    }
+
+    if (std::string(argv[1]) == "--export") {
+        return ExportBuiltinLevels(argv[2]) ? 0 : 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    LevelPackWriter writer;
+    if (!CompileText(argv[1], writer) || !writer.Write(argv[2])) {
+        return 1;
+    }
+    double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Packed " << writer.GetLevelCount() << " levels into " << argv[2]
+              << " (" << milliseconds << " ms)" << std::endl;
+    return 0;
+}
@@ -0,0 +1,102 @@
+// Pack solver: searches a fresh solution for every silhouette of a level pack with the exact
+// solver and writes the pack again with those solutions, e.g. to check that drawn or generated
+// silhouettes can be tiled.
+//
+//   SolveLevels <input.pack> <output.pack>
+//
+// A pack with at least as many levels as threads is solved one level per pool task
+// (TangramSolver::SolveBatch); a smaller one splits each search tree across the pool instead
+// (TangramSolver::Solve). Levels off the lattice, with holes or without a tiling keep their
+// stored solution and are listed, and corrupt entries are dropped; either makes it exit 1.
+#include "LevelPack.h"
+#include "TangramSolver.h"
+#include "ThreadPool.h"
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::cerr << "Usage: " << argv[0] << " <input.pack> <output.pack>" << std::endl;
+        return 2;
+    }
+
+    LevelPack pack;
+    if (!pack.Open(argv[1])) {
+        return 1;
+    }
+
+    // The solver takes simple silhouettes on the lattice only
+    std::vector<std::unique_ptr<Level>> levels;
+    std::vector<std::vector<LatticePoint>> silhouettes;
+    std::vector<int> silhouetteLevels;
+    int failedCount = 0;
+    for (int i = 0; i < pack.GetLevelCount(); ++i) {
+        LevelView view = pack.GetLevel(i);
+        if (!view.IsValid()) {
+            std::cerr << "Entry " << i << " is corrupt, dropped" << std::endl;
+            ++failedCount;
+            continue;
+        }
+        levels.emplace_back(view.CreateLevel());
+        const Level& level = *levels.back();
+        if (level.IsOnLattice() && level.GetLatticeHoles().empty()) {
+            silhouettes.push_back(level.GetLatticeSilhouette());
+            silhouetteLevels.push_back(levels.size() - 1);
+        }
+    }
+
+    ThreadPool pool;
+    TangramSolver solver(pool);
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<SolverResult> results;
+    if (silhouettes.size() >= pool.GetThreadCount()) {
+        results = solver.SolveBatch(silhouettes);
+    } else {
+        for (const std::vector<LatticePoint>& silhouette : silhouettes) {
+            results.push_back(solver.Solve(silhouette));
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<const SolverResult*> levelResults(levels.size(), nullptr);
+    uint64_t nodesVisited = 0;
+    int solvedCount = 0;
+    for (size_t i = 0; i < results.size(); ++i) {
+        nodesVisited += results[i].nodesVisited;
+        if (results[i].isSolved) {
+            levelResults[silhouetteLevels[i]] = &results[i];
+            ++solvedCount;
+        }
+    }
+
+    LevelPackWriter writer;
+    for (size_t i = 0; i < levels.size(); ++i) {
+        const Level& level = *levels[i];
+        const SolverResult* result = levelResults[i];
+        if (result == nullptr) {
+            std::cout << "Level " << level.GetLevelNumber() << " (" << level.GetName() << ") not solved, "
+                      << "keeping its stored solution" << std::endl;
+            writer.AddLevel(level);
+            ++failedCount;
+            continue;
+        }
+
+        std::vector<int> pieceIndices;
+        for (const PiecePosition& target : result->solution) {
+            pieceIndices.push_back(target.pieceIndex);
+        }
+        writer.AddLevel(Level(level.GetLevelNumber(), level.GetName(), level.GetLatticeSilhouette(),
+                              pieceIndices, result->poses));
+    }
+    if (!writer.Write(argv[2])) {
+        return 1;
+    }
+
+    std::cout << "Solved " << solvedCount << "/" << pack.GetLevelCount() << " levels in " << seconds << " s on "
+              << pool.GetThreadCount() << " threads (" << nodesVisited << " nodes)" << std::endl;
+    return failedCount == 0 ? 0 : 1;
+}
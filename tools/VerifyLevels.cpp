@@ -0,0 +1,227 @@
+// Headless level-pack check: loads every level without a window or GL context and verifies
+// that its seven solution pieces tile the stored silhouette exactly; an entry that cannot be
+// decoded counts as a failure. Exits non-zero on any failure, so it can gate level-pack
+// changes (make verify).
+//
+//   VerifyLevels [levels.pack]   the built-in levels when no pack is given
+#include "LevelManager.h"
+#include "LevelPack.h"
+#include "PieceGeometry.h"
+#include "ThreadPool.h"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+static const int PIECE_COUNT = 7;
+
+// Area of one tangram set, doubled, in LatticeProduct units
+static const int64_t SET_DOUBLE_AREA = 8 * LatticeProduct::DENOMINATOR;
+
+struct LevelReport {
+    int entry = 0;
+    bool isDecoded = false;
+    int levelNumber = 0;
+    std::string name;
+    double silhouetteArea = 0.0;
+    double pieceArea = 0.0;
+    std::vector<std::string> failures;
+    double milliseconds = 0.0;
+};
+
+static double GetFloatArea(const std::vector<glm::vec2>& polygon) {
+    double doubleArea = 0.0;
+    size_t count = polygon.size();
+    for (size_t i = 0; i < count; ++i) {
+        const glm::vec2& current = polygon[i];
+        const glm::vec2& next = polygon[(i + 1) % count];
+        doubleArea += (double)current.x * next.y - (double)next.x * current.y;
+    }
+    return std::fabs(doubleArea) * 0.5;
+}
+
+enum class PiecePlacement { Inside, Outside, Crossing };
+
+// Where a convex piece lies relative to a (possibly concave) polygon, touching allowed
+static PiecePlacement ClassifyPiece(const std::vector<LatticePoint>& polygon, const std::vector<LatticePoint>& piece) {
+    bool hasInside = false;
+    bool hasOutside = false;
+    for (const LatticePoint& vertex : piece) {
+        if (IsOnPolygonBoundary(polygon, vertex)) {
+            continue;
+        }
+        if (IsStrictlyInsidePolygon(polygon, vertex)) {
+            hasInside = true;
+        } else {
+            hasOutside = true;
+        }
+    }
+    if (hasInside && hasOutside) {
+        return PiecePlacement::Crossing;
+    }
+
+    std::vector<LatticePoint> edge(2);
+    size_t count = polygon.size();
+    for (size_t i = 0; i < count; ++i) {
+        edge[0] = polygon[i];
+        edge[1] = polygon[(i + 1) % count];
+        if (DoInteriorsOverlap(piece, edge)) {
+            return PiecePlacement::Crossing;
+        }
+    }
+
+    // Wholly inside or wholly outside now; test a point of the piece interior,
+    // scaled by 3 so the centroid of its first three vertices stays on the lattice
+    std::vector<LatticePoint> scaled;
+    for (const LatticePoint& vertex : polygon) {
+        scaled.push_back(vertex + vertex + vertex);
+    }
+    return IsStrictlyInsidePolygon(scaled, piece[0] + piece[1] + piece[2]) ? PiecePlacement::Inside : PiecePlacement::Outside;
+}
+
+// Inside the silhouette and clear of its holes
+static bool IsPieceInside(const Level& level, const std::vector<LatticePoint>& piece) {
+    if (ClassifyPiece(level.GetLatticeSilhouette(), piece) != PiecePlacement::Inside) {
+        return false;
+    }
+    for (const std::vector<LatticePoint>& hole : level.GetLatticeHoles()) {
+        if (ClassifyPiece(hole, piece) != PiecePlacement::Outside) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static LatticeProduct GetAbsoluteDoubleArea(const std::vector<LatticePoint>& polygon) {
+    LatticeProduct area = GetDoubleArea(polygon);
+    return area.Sign() < 0 ? LatticeProduct(-area.a, -area.b) : area;
+}
+
+static void VerifyLevel(const Level& level, LevelReport& report) {
+    report.isDecoded = true;
+    report.levelNumber = level.GetLevelNumber();
+    report.name = level.GetName();
+    report.silhouetteArea = GetFloatArea(level.GetSilhouetteVertices());
+    for (const std::vector<glm::vec2>& hole : level.GetSilhouetteHoles()) {
+        report.silhouetteArea -= GetFloatArea(hole);
+    }
+
+    const std::vector<PiecePosition>& solution = level.GetSolution();
+    if ((int)solution.size() != PIECE_COUNT) {
+        report.failures.push_back("solution has " + std::to_string(solution.size()) + " pieces, expected 7");
+    }
+    int seen[PIECE_COUNT] = {};
+    for (const PiecePosition& target : solution) {
+        if (target.pieceIndex < 0 || target.pieceIndex >= PIECE_COUNT) {
+            report.failures.push_back("invalid piece index " + std::to_string(target.pieceIndex));
+        } else if (seen[target.pieceIndex]++ > 0) {
+            report.failures.push_back("piece " + std::to_string(target.pieceIndex) + " is used twice");
+        }
+    }
+
+    if (!level.IsOnLattice()) {
+        report.failures.push_back("silhouette or solution is not on the tangram lattice");
+        return;
+    }
+
+    LatticeProduct silhouetteArea = GetAbsoluteDoubleArea(level.GetLatticeSilhouette());
+    for (const std::vector<LatticePoint>& hole : level.GetLatticeHoles()) {
+        silhouetteArea = silhouetteArea - GetAbsoluteDoubleArea(hole);
+    }
+    if (silhouetteArea != LatticeProduct(SET_DOUBLE_AREA, 0)) {
+        report.failures.push_back("silhouette area is " + std::to_string(report.silhouetteArea) + ", expected 4");
+    }
+
+    const std::vector<LatticePose>& poses = level.GetLatticeSolution();
+    std::vector<std::vector<LatticePoint>> outlines(poses.size());
+    LatticeProduct pieceArea;
+    for (size_t i = 0; i < poses.size(); ++i) {
+        int pieceIndex = solution[i].pieceIndex;
+        GetPlacedOutline(GetPieceTypeForIndex(pieceIndex), poses[i], outlines[i]);
+        // Flipped pieces wind clockwise
+        pieceArea = pieceArea + GetAbsoluteDoubleArea(outlines[i]);
+
+        if (!IsPieceInside(level, outlines[i])) {
+            report.failures.push_back("piece " + std::to_string(pieceIndex) + " sticks out of the silhouette");
+        }
+        for (size_t j = 0; j < i; ++j) {
+            if (DoInteriorsOverlap(outlines[i], outlines[j])) {
+                report.failures.push_back("pieces " + std::to_string(solution[j].pieceIndex) + " and "
+                                          + std::to_string(pieceIndex) + " overlap");
+            }
+        }
+    }
+    report.pieceArea = pieceArea.ToDouble() * 0.5;
+}
+
+int main(int argc, char** argv) {
+    auto loadStart = std::chrono::steady_clock::now();
+    LevelPack pack;
+    bool isPack = argc > 1;
+    if (isPack && !pack.Open(argv[1])) {
+        return 1;
+    }
+    double loadMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - loadStart).count();
+
+    int levelCount = isPack ? pack.GetLevelCount() : LevelManager::BUILTIN_LEVEL_COUNT;
+    std::vector<LevelReport> reports(levelCount);
+
+    // Levels are decoded on the pool as well, straight from the pack or the built-in data, so
+    // the stored silhouettes are what gets checked, not ones derived from the solutions again
+    auto verifyStart = std::chrono::steady_clock::now();
+    {
+        ThreadPool pool;
+        std::atomic<int> pending(levelCount);
+        for (int i = 0; i < levelCount; ++i) {
+            LevelReport* report = &reports[i];
+            report->entry = i;
+            pool.Submit([&pack, isPack, i, report, &pending]() {
+                auto start = std::chrono::steady_clock::now();
+                std::unique_ptr<Level> level;
+                if (!isPack) {
+                    level.reset(LevelManager::CreateBuiltinLevel(i));
+                } else {
+                    LevelView view = pack.GetLevel(i);
+                    if (view.IsValid()) {
+                        level.reset(view.CreateLevel());
+                    }
+                }
+                if (level != nullptr) {
+                    VerifyLevel(*level, *report);
+                } else {
+                    report->failures.push_back("entry is corrupt and cannot be decoded");
+                }
+                report->milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                pending.fetch_sub(1);
+            });
+        }
+        pool.WaitFor(pending);
+    }
+    double verifyMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - verifyStart).count();
+
+    int failedCount = 0;
+    for (const LevelReport& report : reports) {
+        bool isValid = report.failures.empty();
+        if (!isValid) {
+            ++failedCount;
+        }
+        std::cout << (isValid ? "[ OK ] " : "[FAIL] ");
+        if (report.isDecoded) {
+            std::cout << "Level " << report.levelNumber << " (" << report.name << ")"
+                      << "  silhouette area " << report.silhouetteArea << ", pieces " << report.pieceArea
+                      << ", " << report.milliseconds << " ms" << std::endl;
+        } else {
+            std::cout << "Entry " << report.entry << std::endl;
+        }
+        for (const std::string& failure : report.failures) {
+            std::cout << "         " << failure << std::endl;
+        }
+    }
+
+    std::cout << "\n" << (levelCount - failedCount) << "/" << levelCount << " levels valid"
+              << " (open " << loadMilliseconds << " ms, verify " << verifyMilliseconds << " ms)" << std::endl;
+    return failedCount == 0 ? 0 : 1;
+}